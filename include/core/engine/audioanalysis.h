@@ -0,0 +1,107 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Fooyin {
+class AudioBuffer;
+
+/*!
+ * Per-channel levels of the audio being played, calculated once per rendered buffer on the output thread.
+ * The latest levels are published as a snapshot which can be read from any thread without locking,
+ * so any number of visualisations can poll them at their own repaint rate.
+ *
+ * Each registered user also has its own max-hold of the levels since it last called @fn takeLevels,
+ * so a user polling slower than buffers are rendered doesn't miss the peaks in between.
+ *
+ * Levels are only calculated while at least one user is registered using @fn addUser.
+ */
+class FYCORE_EXPORT AudioAnalysis
+{
+public:
+    static constexpr int MaxChannels = 20;
+    static constexpr int MaxUsers    = 32;
+
+    struct Levels
+    {
+        // Incremented for every analysed buffer; 0 if nothing has been analysed
+        uint64_t sequence{0};
+        int channels{0};
+        // Linear levels in the range [0, 1] (or above if clipping)
+        std::array<float, MaxChannels> peak{};
+        std::array<float, MaxChannels> rms{};
+    };
+
+    AudioAnalysis();
+
+    /*!
+     * Registers a user of the analysis. Every call must be paired with a call to @fn removeUser.
+     * @returns an id to pass to @fn takeLevels, or -1 if @c MaxUsers users are already registered.
+     */
+    int addUser();
+    void removeUser(int user);
+    [[nodiscard]] bool isActive() const;
+
+    /*!
+     * Calculates and publishes the levels of @p buffer.
+     * @note this must only be called from a single (output) thread.
+     */
+    void analyse(const AudioBuffer& buffer);
+
+    /** Returns the most recently published levels. Safe to call from any thread. */
+    [[nodiscard]] Levels levels() const;
+    /*!
+     * Returns the highest peak and RMS of every buffer analysed since the last call for @p user, and resets them.
+     * The sequence and channel count are those of the latest snapshot.
+     * Falls back to @fn levels if @p user is not a registered id. Safe to call from any thread.
+     */
+    [[nodiscard]] Levels takeLevels(int user);
+
+private:
+    struct UserLevels
+    {
+        std::atomic<bool> registered{false};
+        std::array<std::atomic<float>, MaxChannels> peak{};
+        std::array<std::atomic<float>, MaxChannels> rms{};
+    };
+
+    void accumulate(int channels, const std::array<float, MaxChannels>& peak,
+                    const std::array<float, MaxChannels>& rms);
+    void publish(int channels, const std::array<float, MaxChannels>& peak, const std::array<float, MaxChannels>& rms);
+
+    std::atomic<int> m_users;
+    std::array<UserLevels, MaxUsers> m_userLevels;
+
+    // Seqlock guarding the snapshot below: odd while a write is in progress
+    std::atomic<uint64_t> m_version;
+    std::atomic<int> m_channels;
+    std::array<std::atomic<float>, MaxChannels> m_peak;
+    std::array<std::atomic<float>, MaxChannels> m_rms;
+
+    // Only accessed from the analysing thread
+    std::vector<float> m_samples;
+};
+} // namespace Fooyin
@@ -27,6 +27,7 @@
 #include <QObject>
 
 namespace Fooyin {
+class AudioAnalysis;
 struct AudioOutputBuilder;
 
 using OutputNames = std::vector<QString>;
@@ -54,6 +55,13 @@ public:
      */
     virtual void addOutput(const QString& name, OutputCreator output) = 0;
 
+    /*!
+     * Returns the levels of the audio being played, shared by all visualisations.
+     * Prefer this over @fn bufferPlayed, which copies every buffer to each receiver.
+     * @note levels are only calculated while the analysis has at least one user.
+     */
+    [[nodiscard]] virtual AudioAnalysis* analysis() const = 0;
+
 signals:
     void outputChanged(const QString& output, const QString& device);
     void deviceChanged(const QString& device);
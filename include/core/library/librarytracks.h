@@ -0,0 +1,71 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/track.h>
+
+#include <QString>
+
+#include <set>
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * The sorted tracks of the library, indexed by id and by hash.
+ * Changes only re-index the tracks whose position moved, so lookups stay cheap as the library grows.
+ */
+class FYCORE_EXPORT LibraryTracks
+{
+public:
+    /** Replaces all tracks with @p tracks, which must already be sorted. */
+    void reset(const TrackList& tracks);
+    /** Inserts @p tracks, which must be sorted, using their current sort fields. */
+    void insertTracks(const TrackList& tracks);
+    /*!
+     * Replaces the tracks with the same id as those in @p tracks.
+     * Tracks with an unchanged sort field are replaced in place, the rest are moved to their new position.
+     * @param tracks the updated tracks, which must be sorted.
+     */
+    void updateTracks(const TrackList& tracks);
+    /** Removes the tracks with an id in @p ids. */
+    void removeTracks(const std::set<int>& ids);
+
+    [[nodiscard]] const TrackList& tracks() const;
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] size_t size() const;
+
+    /** Returns the track with the given @p id, or nullptr if it isn't in the library. */
+    [[nodiscard]] const Track* track(int id) const;
+    [[nodiscard]] Track* track(int id);
+    /** Returns the ids of all tracks with the given @p hash. */
+    [[nodiscard]] TrackIds idsForHash(const QString& hash) const;
+
+private:
+    void indexFrom(size_t position);
+    void addToHashIndex(const Track& track);
+    void removeFromHashIndex(const Track& track);
+
+    TrackList m_tracks;
+    std::unordered_map<int, size_t> m_trackIndexes;
+    std::unordered_map<QString, TrackIds> m_hashIds;
+};
+} // namespace Fooyin
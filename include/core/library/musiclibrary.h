@@ -27,6 +27,8 @@
 #include <QObject>
 
 namespace Fooyin {
+class TrackSearchIndex;
+
 /*!
  * There are four types of scan request:
  * - Files: Scans a list of files; emits tracksScanned when finished.
@@ -137,6 +139,8 @@ public:
     [[nodiscard]] virtual Track trackForId(int id) const = 0;
     /** Returns a TrackList containing each track (if) found with an id from @p ids  */
     [[nodiscard]] virtual TrackList tracksForIds(const TrackIds& ids) const = 0;
+    /** Returns the search index of all tracks, which is kept up to date as tracks change.  */
+    [[nodiscard]] virtual std::shared_ptr<const TrackSearchIndex> searchIndex() const = 0;
 
     /** Updates the track @p track in the library.  */
     virtual void updateTrack(const Track& track) = 0;
@@ -0,0 +1,105 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/track.h>
+
+#include <QString>
+
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * The result of a TrackSearchIndex search.
+ * Matches are resolved by track id, and only apply to a track whose searched metadata is the same as was indexed.
+ */
+class FYCORE_EXPORT TrackSearchMatches
+{
+public:
+    TrackSearchMatches(std::vector<bool> matched, std::vector<size_t> signatures, bool exact);
+
+    /*!
+     * Returns whether @p track matches the search, or std::nullopt if the index cannot tell.
+     * This is the case for tracks which aren't indexed, tracks whose metadata differs from what was indexed
+     * (an update which hasn't been indexed yet, or a copy edited outside of the library), and for terms
+     * which can only be confirmed by matching the track itself (such as those containing punctuation).
+     */
+    [[nodiscard]] std::optional<bool> matches(const Track& track) const;
+
+private:
+    std::vector<bool> m_matched;
+    // Signature of the searched fields of each indexed track, or 0 if not indexed
+    std::vector<size_t> m_signatures;
+    bool m_exact;
+};
+
+/*!
+ * Case-folded word index over the metadata fields covered by Track::hasMatch.
+ * Each field is split into words (runs of letters and numbers), and each distinct word maps to the ids
+ * of the tracks containing it. A search term matches the union of all tracks with a word containing the term.
+ * @note this class is thread-safe.
+ */
+class FYCORE_EXPORT TrackSearchIndex
+{
+public:
+    /** Replaces the contents of the index with @p tracks. */
+    void reset(const TrackList& tracks);
+    /** Adds @p tracks, replacing any already indexed with the same id. */
+    void addTracks(const TrackList& tracks);
+    /** Re-indexes the metadata of @p tracks. */
+    void updateTracks(const TrackList& tracks);
+    void removeTracks(const TrackList& tracks);
+
+    /** Returns the number of indexed tracks. */
+    [[nodiscard]] size_t size() const;
+
+    /*!
+     * Searches the index for tracks matching @p search in the same way as a simple search query.
+     * @param search the search terms
+     * @param singleString whether to treat @p search as a single term (a quoted search)
+     * @returns the matches, or std::nullopt if the search can't be answered by the index.
+     */
+    [[nodiscard]] std::optional<TrackSearchMatches> search(const QString& search, bool singleString) const;
+
+private:
+    using TokenIds = std::vector<int>;
+
+    struct IndexedTrack
+    {
+        size_t signature;
+        TokenIds tokens;
+    };
+
+    void addTrack(const Track& track);
+    void removeIds(const std::vector<int>& ids);
+    void matchToken(const QString& token, std::vector<bool>& matched) const;
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<QString> m_tokens;
+    std::unordered_map<QString, int> m_tokenIds;
+    std::vector<std::vector<int>> m_postings;
+    std::unordered_map<int, IndexedTrack> m_trackTokens;
+    int m_maxId{-1};
+};
+} // namespace Fooyin
@@ -24,7 +24,6 @@
 #include <core/scripting/scriptparser.h>
 #include <core/track.h>
 
-#include <QCollator>
 #include <QString>
 
 #include <mutex>
@@ -66,6 +65,25 @@ public:
      */
     static TrackList sortTracks(const TrackList& tracks, Qt::SortOrder order = Qt::AscendingOrder);
 
+    /*!
+     * Inserts @p newTracks into @p tracks using their current sort fields.
+     * Both lists must already be sorted in the given @p order.
+     * @param tracks the sorted tracks to insert into
+     * @param newTracks the sorted tracks to insert
+     * @param order the order in which both lists are sorted
+     * @returns the position of the first inserted track, or the size of @p tracks if nothing was inserted.
+     */
+    static size_t insertSortedTracks(TrackList& tracks, const TrackList& newTracks,
+                                     Qt::SortOrder order = Qt::AscendingOrder);
+
+    /*!
+     * Returns @c true if any track at @p indexes has the same sort fields as an adjacent track.
+     * The relative order of such tracks isn't determined by their sort fields, but by the order they were sorted in.
+     * @param tracks the sorted tracks
+     * @param indexes the indexes of the tracks to check
+     */
+    static bool hasSortTies(const TrackList& tracks, const std::vector<size_t>& indexes);
+
     /*!
      * Calculates the sort fields and then sorts @p tracks
      * @param sort the sort script as a string
@@ -111,16 +129,16 @@ public:
     template <typename Container, typename SortScript, typename Extractor>
     Container calcSortFields(const SortScript& sort, const Container& items, Extractor extractor)
     {
-        Container calculatedTracks;
-        calculatedTracks.reserve(items.size());
+        Container calculatedTracks{items};
 
-        const std::scoped_lock lock{m_parserGuard};
+        const std::vector<QString> keys
+            = calcSortKeys(parseScript(sort), calculatedTracks.size(),
+                           [&calculatedTracks, &extractor](size_t index) -> const Track& {
+                               return extractor(calculatedTracks[index]);
+                           });
 
-        for(const auto& item : items) {
-            auto evalItem{item};
-            Track& track = extractor(evalItem);
-            track.setSort(m_parser.evaluate(sort, track));
-            calculatedTracks.push_back(evalItem);
+        for(size_t i{0}; i < calculatedTracks.size(); ++i) {
+            applySortKey(extractor(calculatedTracks[i]), keys[i]);
         }
 
         return calculatedTracks;
@@ -130,9 +148,11 @@ public:
     Container calcSortTracks(const SortScript& sort, const Container& items, SortExtractor sortExtractor,
                              Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
     {
-        Container sortedTracks = calcSortFields(sort, items, sortExtractor);
-        sortTracks(sortedTracks, extractor, order);
-        return sortedTracks;
+        const std::vector<QString> keys = calcSortKeys(
+            parseScript(sort), items.size(),
+            [&items, &extractor](size_t index) -> const Track& { return extractor(items[index]); });
+
+        return sortByKeys(items, keys, sortExtractor, order);
     }
 
     template <typename Container, typename SortScript, typename SortExtractor, typename Extractor>
@@ -150,8 +170,7 @@ public:
             tracksToSort.push_back(items.at(index));
         }
 
-        Container sortedSubTracks = calcSortFields(sortScript, tracksToSort, sortExtractor);
-        sortTracks(sortedSubTracks, extractor, order);
+        const Container sortedSubTracks = calcSortTracks(sortScript, tracksToSort, sortExtractor, extractor, order);
 
         for(auto i{0}; const int index : validIndexes) {
             sortedTracks[index] = sortedSubTracks.at(i++);
@@ -162,30 +181,40 @@ public:
 
 private:
     ParsedScript parseScript(const QString& sort);
+    static const ParsedScript& parseScript(const ParsedScript& sort);
 
-    template <typename Container, typename Extractor>
-    static void sortTracks(Container& tracks, Extractor extractor, Qt::SortOrder order = Qt::AscendingOrder)
-    {
-        QCollator collator;
-        collator.setNumericMode(true);
+    /*!
+     * Evaluates @p sortScript for @p count tracks, splitting the work across the global thread pool
+     * with a separate ScriptParser per chunk.
+     * @returns the sort keys, in the same order as the tracks returned by @p trackAt.
+     */
+    std::vector<QString> calcSortKeys(const ParsedScript& sortScript, size_t count,
+                                      const std::function<const Track&(size_t)>& trackAt);
+
+    /*!
+     * Stable sorts chunks of @p keys in parallel, then merges them on the calling thread.
+     * @returns the indexes of @p keys in sorted order.
+     */
+    static std::vector<int> sortIndexes(const std::vector<QString>& keys, Qt::SortOrder order);
 
-        std::ranges::stable_sort(tracks, [order, collator, extractor](const auto& lhs, const auto& rhs) {
-            const Track& leftTrack  = extractor(lhs);
-            const Track& rightTrack = extractor(rhs);
+    static void applySortKey(Track& track, const QString& key);
 
-            const auto cmp = collator.compare(leftTrack.sort(), rightTrack.sort());
+    template <typename Container, typename SortExtractor>
+    static Container sortByKeys(const Container& items, const std::vector<QString>& keys, SortExtractor sortExtractor,
+                                Qt::SortOrder order)
+    {
+        Container sortedTracks;
+        sortedTracks.reserve(items.size());
 
-            if(cmp == 0) {
-                return false;
-            }
+        for(const int index : sortIndexes(keys, order)) {
+            auto& item = sortedTracks.emplace_back(items.at(index));
+            applySortKey(sortExtractor(item), keys.at(index));
+        }
 
-            if(order == Qt::AscendingOrder) {
-                return cmp < 0;
-            }
-            return cmp > 0;
-        });
+        return sortedTracks;
     }
 
+    LibraryManager* m_libraryManager;
     ScriptParser m_parser;
     std::mutex m_parserGuard;
 };
@@ -26,11 +26,17 @@
 
 #include <QObject>
 
+#include <optional>
+
 namespace Fooyin {
 class PlaylistPrivate;
 struct PlaylistTrack;
 class SettingsManager;
 
+namespace Testing {
+class AutoPlaylistTest;
+} // namespace Testing
+
 using PlaylistTrackList = std::vector<PlaylistTrack>;
 
 struct FYCORE_EXPORT PlaylistTrack
@@ -119,6 +125,17 @@ public:
 
     /** Regenerates this autoplaylist using the tracks @p tracks. */
     bool regenerateTracks(const TrackList& tracks);
+    /** Returns @c true if this autoplaylist can be kept up to date using @fn updateAutoTracks. */
+    [[nodiscard]] bool supportsIncrementalUpdate() const;
+    /*!
+     * Updates this autoplaylist using only the tracks which have changed in the library.
+     * Tracks in @p changedTracks which match the query are inserted or updated, and the rest
+     * are removed along with any tracks in @p removedTracks.
+     * @returns @c true if the tracks of this playlist have changed, or std::nullopt if they couldn't be updated
+     * incrementally and the playlist must be regenerated using @fn regenerateTracks. This is the case if
+     * @fn supportsIncrementalUpdate is @c false, or if a changed track has the same sort fields as its neighbours.
+     */
+    std::optional<bool> updateAutoTracks(const TrackList& changedTracks, const TrackList& removedTracks);
 
     /*!
      * Schedules the track to be played after the current track is finished.
@@ -154,6 +171,7 @@ public:
 private:
     friend class PlaylistHandler;
     friend class PlaylistHandlerPrivate;
+    friend class Testing::AutoPlaylistTest;
 
     static std::unique_ptr<Playlist> create(const QString& name, SettingsManager* settings);
     static std::unique_ptr<Playlist> create(int dbId, const QString& name, int index, SettingsManager* settings);
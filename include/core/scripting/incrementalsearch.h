@@ -0,0 +1,131 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/scripting/scriptparser.h>
+
+#include <QFuture>
+#include <QPromise>
+#include <QtConcurrentRun>
+
+#include <functional>
+#include <optional>
+
+namespace Fooyin {
+class TrackSearchIndex;
+
+/*!
+ * Runs search queries on a worker thread for a search box which updates as the user types.
+ * Starting a search cancels the one in progress, so its results are never delivered.
+ * When a query only narrows the previous one (see ScriptParser::isNarrowerQuery), only the
+ * previous results are filtered instead of the full set of tracks.
+ * @note the owner must call invalidate() whenever the tracks being searched change.
+ */
+template <typename TrackListType>
+class IncrementalSearch
+{
+public:
+    using ResultHandler = std::function<void(const TrackListType&)>;
+
+    /** Results are delivered in the thread of @p context. */
+    explicit IncrementalSearch(QObject* context)
+        : m_context{context}
+    { }
+
+    ~IncrementalSearch()
+    {
+        cancel();
+    }
+
+    IncrementalSearch(const IncrementalSearch&)            = delete;
+    IncrementalSearch& operator=(const IncrementalSearch&) = delete;
+
+    void setSearchIndex(std::shared_ptr<const TrackSearchIndex> index)
+    {
+        m_searchIndex = std::move(index);
+    }
+
+    /*!
+     * Filters the tracks returned by @p tracks using @p search, and passes the results to @p handler.
+     * @p tracks isn't called if the previous results can be refined instead.
+     */
+    void search(const QString& search, const std::function<TrackListType()>& tracks, ResultHandler handler)
+    {
+        cancel();
+
+        const bool refine = m_state->lastResults && m_parser.isNarrowerQuery(m_state->lastSearch, search);
+        const TrackListType source = refine ? m_state->lastResults.value() : tracks();
+
+        m_future = QtConcurrent::run([search, source, index = m_searchIndex](QPromise<TrackListType>& promise) {
+            ScriptParser parser;
+            parser.setSearchIndex(index);
+            parser.setCancelCheck([&promise]() { return promise.isCanceled(); });
+
+            TrackListType results = parser.filter(search, source);
+            if(!promise.isCanceled()) {
+                promise.addResult(std::move(results));
+            }
+        });
+
+        const int generation = m_state->generation;
+
+        m_future.then(m_context, [state = m_state, generation, search, handler](const TrackListType& results) {
+            // A newer search may have started after this one finished
+            if(generation != state->generation) {
+                return;
+            }
+            state->lastSearch  = search;
+            state->lastResults = results;
+            handler(results);
+        });
+    }
+
+    /** Cancels the search in progress, if any. */
+    void cancel()
+    {
+        ++m_state->generation;
+        if(m_future.isRunning()) {
+            m_future.cancel();
+        }
+    }
+
+    /** Discards the previous results so the next search uses the full set of tracks. */
+    void invalidate()
+    {
+        m_state->lastSearch.clear();
+        m_state->lastResults.reset();
+    }
+
+private:
+    // Shared with pending results, which may be delivered after this object is destroyed
+    struct State
+    {
+        int generation{0};
+        QString lastSearch;
+        std::optional<TrackListType> lastResults;
+    };
+
+    QObject* m_context;
+    ScriptParser m_parser;
+    std::shared_ptr<const TrackSearchIndex> m_searchIndex;
+    std::shared_ptr<State> m_state{std::make_shared<State>()};
+    QFuture<TrackListType> m_future;
+};
+} // namespace Fooyin
@@ -30,6 +30,7 @@
 
 namespace Fooyin {
 class ScriptParserPrivate;
+class TrackSearchIndex;
 
 struct ScriptError
 {
@@ -51,6 +52,37 @@ struct ParsedScript
     }
 };
 
+struct CompiledExpression;
+using CompiledExpressionList = std::vector<CompiledExpression>;
+
+/*!
+ * An Expression with its variables and functions resolved against a ScriptRegistry.
+ */
+struct CompiledExpression
+{
+    Expr::Type type{Expr::Null};
+    QString value;
+    int64_t number{0};
+    CompiledExpressionList args;
+    ScriptRegistry::VariableFunc variable;
+    ScriptRegistry::FunctionFunc function;
+};
+
+/*!
+ * A ParsedScript bound to the registry of the ScriptParser which compiled it.
+ * @note only valid for as long as the compiling ScriptParser exists.
+ */
+struct CompiledScript
+{
+    QString input;
+    CompiledExpressionList expressions;
+
+    [[nodiscard]] bool isValid() const
+    {
+        return !expressions.empty();
+    }
+};
+
 /*!
  * Parses and evaluates scripts for a given Track or TrackList.
  * @note this class will take ownership of ScriptRegistry if passed in the constructor.
@@ -64,23 +96,58 @@ public:
 
     [[nodiscard]] ScriptRegistry* registry() const;
 
+    /*!
+     * Sets the @p index used to answer simple search queries passed to filter.
+     * Tracks which aren't in the index are matched directly.
+     */
+    void setSearchIndex(std::shared_ptr<const TrackSearchIndex> index);
+    /*!
+     * Sets a function which is polled while filtering.
+     * If it returns @c true, filtering stops early and returns an empty list.
+     */
+    void setCancelCheck(std::function<bool()> isCancelled);
+
     ParsedScript parse(const QString& input);
     ParsedScript parseQuery(const QString& input);
 
+    /*!
+     * Returns @c true if @p query and @p previous are simple search queries and every track
+     * matching @p query also matches @p previous (such as "beat" followed by "beatl" or "beat l").
+     * The results of @p query can then be found by filtering the results of @p previous.
+     */
+    bool isNarrowerQuery(const QString& previous, const QString& query);
+
+    /*!
+     * Returns @c true if whether a track matches @p query depends only on that track, so the results
+     * of @p query can be kept up to date by filtering just the tracks which have been added or changed.
+     * This isn't the case for queries using LIMIT or a time relative to now (DURING LAST ...).
+     */
+    static bool isIncrementalQuery(const QString& query);
+
+    /*!
+     * Resolves all variables and functions in @p input so it can be evaluated repeatedly
+     * without looking up names in the registry for every track.
+     */
+    CompiledScript compile(const ParsedScript& input);
+    CompiledScript compile(const QString& input);
+
     QString evaluate(const QString& input);
     QString evaluate(const ParsedScript& input);
 
     QString evaluate(const QString& input, const Track& track);
     QString evaluate(const ParsedScript& input, const Track& track);
+    QString evaluate(const CompiledScript& input, const Track& track);
 
     QString evaluate(const QString& input, const TrackList& tracks);
     QString evaluate(const ParsedScript& input, const TrackList& tracks);
 
     TrackList filter(const QString& input, const TrackList& tracks);
     TrackList filter(const ParsedScript& input, const TrackList& tracks);
+    TrackList filter(const CompiledScript& input, const TrackList& tracks);
 
     PlaylistTrackList filter(const QString& input, const PlaylistTrackList& tracks);
     PlaylistTrackList filter(const ParsedScript& input, const PlaylistTrackList& tracks);
+    PlaylistTrackList filter(const CompiledScript& input, const PlaylistTrackList& tracks);
 
     [[nodiscard]] int cacheLimit() const;
     void setCacheLimit(int limit);
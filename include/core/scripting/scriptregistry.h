@@ -26,6 +26,8 @@
 
 #include <QObject>
 
+#include <functional>
+
 namespace Fooyin {
 class LibraryManager;
 class PlayerController;
@@ -34,7 +36,9 @@ class ScriptRegistryPrivate;
 class FYCORE_EXPORT ScriptRegistry
 {
 public:
-    using FuncRet = std::variant<int, uint64_t, float, QString, QStringList>;
+    using FuncRet      = std::variant<int, uint64_t, float, QString, QStringList>;
+    using VariableFunc = std::function<ScriptResult(const Track&)>;
+    using FunctionFunc = std::function<ScriptResult(const ScriptValueList&, const Track&)>;
 
     ScriptRegistry();
     explicit ScriptRegistry(LibraryManager* libraryManager);
@@ -55,6 +59,17 @@ public:
     [[nodiscard]] virtual ScriptResult function(const QString& func, const ScriptValueList& args,
                                                 const TrackList& tracks) const;
 
+    /*!
+     * Resolves @p var once so it can be evaluated for any number of tracks without repeating the lookup.
+     * @note subclasses which override value() for a single track should override this as well.
+     */
+    [[nodiscard]] virtual VariableFunc bindVariable(const QString& var) const;
+    /*!
+     * Resolves @p func once so it can be called without repeating the lookup.
+     * @returns an empty function if @p func is not registered.
+     */
+    [[nodiscard]] virtual FunctionFunc bindFunction(const QString& func) const;
+
     virtual void setValue(const QString& var, const FuncRet& value, Track& track);
 
 protected:
@@ -25,6 +25,8 @@
 
 #include <QCryptographicHash>
 #include <QString>
+#include <QStringList>
+#include <QtEndian>
 
 namespace Fooyin {
 using Md5Hash = QByteArray;
@@ -59,6 +61,50 @@ Md5Hash generateMd5Hash(const Args&... args)
     return hash.result();
 }
 
+// 64-bit FNV-1a
+constexpr uint64_t KeyHashOffset = 14695981039346656037ULL;
+constexpr uint64_t KeyHashPrime  = 1099511628211ULL;
+
+template <typename T>
+void addDataToKeyHash(uint64_t& hash, const T& arg)
+{
+    for(const QChar c : arg) {
+        hash = (hash ^ c.unicode()) * KeyHashPrime;
+    }
+    hash = (hash ^ static_cast<uint64_t>(arg.size())) * KeyHashPrime;
+}
+
+template <>
+inline void addDataToKeyHash(uint64_t& hash, const QByteArray& arg)
+{
+    for(const char c : arg) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * KeyHashPrime;
+    }
+    hash = (hash ^ static_cast<uint64_t>(arg.size())) * KeyHashPrime;
+}
+
+template <>
+inline void addDataToKeyHash(uint64_t& hash, const QStringList& arg)
+{
+    for(const QString& str : arg) {
+        addDataToKeyHash(hash, str);
+    }
+}
+
+/*!
+ * Generates an 8 byte key from a 64-bit hash of @p args.
+ * Much cheaper than generateMd5Hash, for keys which only need to be unique among the items of a model.
+ */
+template <typename... Args>
+Md5Hash generateKeyHash(const Args&... args)
+{
+    uint64_t hash{KeyHashOffset};
+    (addDataToKeyHash(hash, args), ...);
+
+    hash = qToLittleEndian(hash);
+    return Md5Hash(reinterpret_cast<const char*>(&hash), sizeof(hash));
+}
+
 FYUTILS_EXPORT QString generateUniqueHash();
 } // namespace Utils
 } // namespace Fooyin
@@ -47,6 +47,7 @@ public:
     [[nodiscard]] QSqlError lastError() const;
 
     void bindValue(const QString& placeholder, const QVariant& value);
+    void bindValue(int pos, const QVariant& value);
     [[nodiscard]] QString executedQuery() const;
     bool exec();
 
@@ -54,6 +55,7 @@ public:
     [[nodiscard]] QVariant lastInsertId() const;
     [[nodiscard]] bool next();
     [[nodiscard]] QVariant value(int index) const;
+    void finish();
 
 private:
     QSqlQuery m_query;
@@ -0,0 +1,137 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * A Fenwick (binary indexed) tree over a list of non-negative values.
+ * Gives O(log n) prefix sums, single value updates and lookup of the value
+ * containing a given offset, e.g. mapping between row indexes and pixel offsets.
+ */
+class FenwickTree
+{
+public:
+    FenwickTree() = default;
+
+    /** Replaces all values. Builds in O(n). */
+    void assign(std::vector<int> values)
+    {
+        m_values = std::move(values);
+
+        const int count = size();
+        m_tree.assign(m_values.size() + 1, 0);
+
+        for(int i{1}; i <= count; ++i) {
+            m_tree[i] += m_values[i - 1];
+            const int parent = i + (i & -i);
+            if(parent <= count) {
+                m_tree[parent] += m_tree[i];
+            }
+        }
+
+        m_topStep = count > 0 ? static_cast<int>(std::bit_floor(static_cast<unsigned>(count))) : 0;
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        m_tree.clear();
+        m_topStep = 0;
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return static_cast<int>(m_values.size());
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    [[nodiscard]] int value(int index) const
+    {
+        return m_values.at(index);
+    }
+
+    /** Changes the value at @p index in O(log n). */
+    void set(int index, int value)
+    {
+        const int delta = value - m_values.at(index);
+        if(delta == 0) {
+            return;
+        }
+
+        m_values[index] = value;
+
+        const int count = size();
+        for(int i{index + 1}; i <= count; i += i & -i) {
+            m_tree[i] += delta;
+        }
+    }
+
+    /** Returns the sum of the first @p count values. */
+    [[nodiscard]] int prefixSum(int count) const
+    {
+        int sum{0};
+        for(int i{std::min(count, size())}; i > 0; i -= i & -i) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+    [[nodiscard]] int total() const
+    {
+        return prefixSum(size());
+    }
+
+    /*!
+     * Returns the index of the value containing @p offset, i.e. the first index
+     * where prefixSum(index + 1) > @p offset.
+     * @returns size() if @p offset is at or beyond the total.
+     */
+    [[nodiscard]] int indexAt(int offset) const
+    {
+        const int count = size();
+
+        int index{0};
+        for(int step{m_topStep}; step > 0; step >>= 1) {
+            const int next = index + step;
+            if(next <= count && m_tree[next] <= offset) {
+                index = next;
+                offset -= m_tree[next];
+            }
+        }
+
+        return index;
+    }
+
+private:
+    std::vector<int> m_values;
+    // 1-based; m_tree[i] holds the sum of the (i & -i) values ending at i - 1
+    std::vector<int> m_tree;
+    int m_topStep{0};
+};
+} // namespace Fooyin
@@ -107,6 +107,52 @@ std::optional<T> take(std::vector<T>& vec, std::size_t index)
     return element;
 }
 
+/*!
+ * Returns the new position of each of @p size elements once the elements at @p removedIndexes
+ * are removed, or -1 for a removed element. Indexes out of range are ignored.
+ */
+inline std::vector<int> removalIndexMap(size_t size, const std::vector<int>& removedIndexes)
+{
+    std::vector<int> indexMap(size, 0);
+
+    for(const int index : removedIndexes) {
+        if(index >= 0 && std::cmp_less(index, size)) {
+            indexMap[index] = -1;
+        }
+    }
+
+    int newIndex{0};
+    for(int& index : indexMap) {
+        if(index == 0) {
+            index = newIndex++;
+        }
+    }
+
+    return indexMap;
+}
+
+/*!
+ * Removes the elements of @p vec marked as removed in @p indexMap (see @fn removalIndexMap)
+ * in a single pass, keeping the order of the remaining elements.
+ */
+template <typename T>
+void removeByIndexMap(std::vector<T>& vec, const std::vector<int>& indexMap)
+{
+    size_t write{0};
+
+    for(size_t read{0}; read < vec.size(); ++read) {
+        if(read < indexMap.size() && indexMap[read] < 0) {
+            continue;
+        }
+        if(write != read) {
+            vec[write] = std::move(vec[read]);
+        }
+        ++write;
+    }
+
+    vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(write), vec.end());
+}
+
 template <typename T, typename StringExtractor>
 QString findUniqueString(const QString& name, const T& elements, StringExtractor&& extractor)
 {
@@ -0,0 +1,299 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * An ordered sequence of unique values backed by an implicit treap.
+ * Gives O(log n) lookup of the value at a position, the position of a value,
+ * and insertion or removal at any position.
+ */
+template <typename T, typename Hash = std::hash<T>>
+class IndexedSequence
+{
+public:
+    IndexedSequence() = default;
+
+    IndexedSequence(IndexedSequence&& other) noexcept
+        : m_nodes{std::move(other.m_nodes)}
+        , m_root{std::exchange(other.m_root, nullptr)}
+        , m_seed{other.m_seed}
+    {
+        other.m_nodes.clear();
+    }
+
+    IndexedSequence& operator=(IndexedSequence&& other) noexcept
+    {
+        if(this != &other) {
+            m_nodes = std::move(other.m_nodes);
+            m_root  = std::exchange(other.m_root, nullptr);
+            m_seed  = other.m_seed;
+            other.m_nodes.clear();
+        }
+        return *this;
+    }
+
+    IndexedSequence(const IndexedSequence&)            = delete;
+    IndexedSequence& operator=(const IndexedSequence&) = delete;
+
+    ~IndexedSequence() = default;
+
+    /** Returns the approximate number of bytes stored per value, excluding any heap memory owned by T. */
+    static constexpr size_t valueCost()
+    {
+        return sizeof(Node) + sizeof(typename NodeMap::value_type);
+    }
+
+    [[nodiscard]] int size() const
+    {
+        return sizeOf(m_root);
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return !m_root;
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_root = nullptr;
+    }
+
+    [[nodiscard]] bool contains(const T& value) const
+    {
+        return m_nodes.contains(value);
+    }
+
+    /** Returns the value at @p pos, which must be in the range [0, size()). */
+    [[nodiscard]] const T& at(int pos) const
+    {
+        Node* node = m_root;
+        while(node) {
+            const int leftSize = sizeOf(node->left);
+            if(pos < leftSize) {
+                node = node->left;
+            }
+            else if(pos == leftSize) {
+                break;
+            }
+            else {
+                pos -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        return node->value;
+    }
+
+    /** Returns the position of @p value, or -1 if it isn't in the sequence. */
+    [[nodiscard]] int indexOf(const T& value) const
+    {
+        const auto it = m_nodes.find(value);
+        if(it == m_nodes.cend()) {
+            return -1;
+        }
+
+        const Node* node = it->second.get();
+        int pos          = sizeOf(node->left);
+
+        while(node->parent) {
+            if(node == node->parent->right) {
+                pos += sizeOf(node->parent->left) + 1;
+            }
+            node = node->parent;
+        }
+
+        return pos;
+    }
+
+    /** Inserts @p value before position @p pos. Values already present are ignored. */
+    void insert(int pos, const T& value)
+    {
+        insert(pos, std::vector<T>{value});
+    }
+
+    /** Inserts @p values, in order, before position @p pos. Values already present are ignored. */
+    void insert(int pos, const std::vector<T>& values)
+    {
+        Node* inserted{nullptr};
+        for(const T& value : values) {
+            if(m_nodes.contains(value)) {
+                continue;
+            }
+            auto node      = std::make_unique<Node>(value, nextPriority());
+            Node* rawNode  = node.get();
+            m_nodes[value] = std::move(node);
+            inserted       = merge(inserted, rawNode);
+        }
+
+        if(!inserted) {
+            return;
+        }
+
+        auto [left, right] = split(m_root, std::clamp(pos, 0, size()));
+        m_root             = merge(merge(left, inserted), right);
+        m_root->parent     = nullptr;
+    }
+
+    void append(const T& value)
+    {
+        insert(size(), value);
+    }
+
+    void append(const std::vector<T>& values)
+    {
+        insert(size(), values);
+    }
+
+    /** Removes @p value, returning false if it wasn't in the sequence. */
+    bool erase(const T& value)
+    {
+        const auto it = m_nodes.find(value);
+        if(it == m_nodes.end()) {
+            return false;
+        }
+
+        Node* node   = it->second.get();
+        Node* parent = node->parent;
+        Node* joined = merge(node->left, node->right);
+
+        if(joined) {
+            joined->parent = parent;
+        }
+
+        if(!parent) {
+            m_root = joined;
+        }
+        else {
+            if(parent->left == node) {
+                parent->left = joined;
+            }
+            else {
+                parent->right = joined;
+            }
+            for(Node* ancestor = parent; ancestor; ancestor = ancestor->parent) {
+                update(ancestor);
+            }
+        }
+
+        m_nodes.erase(it);
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        Node(T value_, uint32_t priority_)
+            : value{std::move(value_)}
+            , priority{priority_}
+        { }
+
+        T value;
+        Node* left{nullptr};
+        Node* right{nullptr};
+        Node* parent{nullptr};
+        uint32_t priority;
+        int size{1};
+    };
+
+    using NodeMap = std::unordered_map<T, std::unique_ptr<Node>, Hash>;
+
+    static int sizeOf(const Node* node)
+    {
+        return node ? node->size : 0;
+    }
+
+    static void update(Node* node)
+    {
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        if(node->left) {
+            node->left->parent = node;
+        }
+        if(node->right) {
+            node->right->parent = node;
+        }
+    }
+
+    // Splits into the first count nodes and the rest
+    static std::pair<Node*, Node*> split(Node* node, int count)
+    {
+        if(!node) {
+            return {nullptr, nullptr};
+        }
+
+        node->parent = nullptr;
+
+        if(sizeOf(node->left) >= count) {
+            auto [left, right] = split(node->left, count);
+            node->left         = right;
+            update(node);
+            return {left, node};
+        }
+
+        auto [left, right] = split(node->right, count - sizeOf(node->left) - 1);
+        node->right        = left;
+        update(node);
+        return {node, right};
+    }
+
+    static Node* merge(Node* left, Node* right)
+    {
+        if(!left || !right) {
+            Node* node = left ? left : right;
+            if(node) {
+                node->parent = nullptr;
+            }
+            return node;
+        }
+
+        if(left->priority > right->priority) {
+            left->right = merge(left->right, right);
+            update(left);
+            left->parent = nullptr;
+            return left;
+        }
+
+        right->left = merge(left, right->left);
+        update(right);
+        right->parent = nullptr;
+        return right;
+    }
+
+    uint32_t nextPriority()
+    {
+        // xorshift32
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed;
+    }
+
+    NodeMap m_nodes;
+    Node* m_root{nullptr};
+    uint32_t m_seed{2463534242};
+};
+} // namespace Fooyin
@@ -108,6 +108,22 @@ protected:
         m_root = std::make_unique<Item>();
     }
 
+    /*!
+     * Releases ownership of the root item, leaving an empty root in its place.
+     * Items parented to the root remain valid as long as the returned root is alive.
+     */
+    std::unique_ptr<Item> takeRoot()
+    {
+        auto root = std::move(m_root);
+        resetRoot();
+        return root;
+    }
+
+    void setRoot(std::unique_ptr<Item> root)
+    {
+        m_root = std::move(root);
+    }
+
 private:
     std::unique_ptr<Item> m_root;
 };
@@ -28,7 +28,7 @@
 
 #include <QFileInfo>
 
-constexpr auto CurrentSchemaVersion = 14;
+constexpr auto CurrentSchemaVersion = 15;
 
 namespace {
 Fooyin::DbConnection::DbParams dbConnectionParams()
@@ -20,6 +20,7 @@
 #include "librarydatabase.h"
 
 #include <utils/database/dbquery.h>
+#include <utils/database/dbtransaction.h>
 
 namespace Fooyin {
 bool LibraryDatabase::getAllLibraries(LibraryInfoMap& libraries)
@@ -93,4 +94,94 @@ bool LibraryDatabase::renameLibrary(int id, const QString& name)
 
     return query.exec();
 }
+
+bool LibraryDatabase::getDirectorySnapshots(int libraryId, DirectorySnapshots& snapshots)
+{
+    const QString statement = QStringLiteral(
+        "SELECT Path, ModifiedDate, ChangedDate, Size, NameFilters FROM LibraryDirectories "
+        "WHERE LibraryID = :libraryId;");
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(QStringLiteral(":libraryId"), libraryId);
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    while(query.next()) {
+        DirectorySnapshot snapshot;
+        snapshot.modifiedTime = query.value(1).toULongLong();
+        snapshot.changedTime  = query.value(2).toULongLong();
+        snapshot.size         = query.value(3).toLongLong();
+        snapshot.nameFilters  = query.value(4).toString();
+
+        snapshots.emplace(query.value(0).toString(), snapshot);
+    }
+
+    return true;
+}
+
+bool LibraryDatabase::storeDirectorySnapshots(int libraryId, const DirectorySnapshots& snapshots)
+{
+    if(libraryId < 0 || snapshots.empty()) {
+        return true;
+    }
+
+    DbTransaction transaction{db()};
+
+    if(!transaction) {
+        return false;
+    }
+
+    const QString statement = QStringLiteral(
+        "INSERT OR REPLACE INTO LibraryDirectories (LibraryID, Path, ModifiedDate, ChangedDate, Size, NameFilters) "
+        "VALUES (:libraryId, :path, :modifiedDate, :changedDate, :size, :nameFilters);");
+
+    DbQuery query{db(), statement};
+
+    for(const auto& [path, snapshot] : snapshots) {
+        query.bindValue(QStringLiteral(":libraryId"), libraryId);
+        query.bindValue(QStringLiteral(":path"), path);
+        query.bindValue(QStringLiteral(":modifiedDate"), static_cast<quint64>(snapshot.modifiedTime));
+        query.bindValue(QStringLiteral(":changedDate"), static_cast<quint64>(snapshot.changedTime));
+        query.bindValue(QStringLiteral(":size"), static_cast<qint64>(snapshot.size));
+        query.bindValue(QStringLiteral(":nameFilters"), snapshot.nameFilters);
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
+
+bool LibraryDatabase::removeDirectorySnapshots(int libraryId, const QStringList& dirs)
+{
+    if(libraryId < 0 || dirs.empty()) {
+        return true;
+    }
+
+    DbTransaction transaction{db()};
+
+    if(!transaction) {
+        return false;
+    }
+
+    const QString statement
+        = QStringLiteral("DELETE FROM LibraryDirectories WHERE LibraryID = :libraryId AND Path = :path;");
+
+    DbQuery query{db(), statement};
+
+    for(const QString& dir : dirs) {
+        query.bindValue(QStringLiteral(":libraryId"), libraryId);
+        query.bindValue(QStringLiteral(":path"), dir);
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
 } // namespace Fooyin
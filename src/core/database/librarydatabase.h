@@ -22,7 +22,25 @@
 #include <core/library/libraryinfo.h>
 #include <utils/database/dbmodule.h>
 
+#include <unordered_map>
+
 namespace Fooyin {
+/*!
+ * The state of a library directory when it was last scanned.
+ * A directory's modified time changes whenever entries are added, removed or renamed in it.
+ * The file types it was listed with are kept, as files of other types were never read.
+ */
+struct DirectorySnapshot
+{
+    uint64_t modifiedTime{0};
+    uint64_t changedTime{0};
+    int64_t size{0};
+    QString nameFilters;
+
+    bool operator==(const DirectorySnapshot& other) const = default;
+};
+using DirectorySnapshots = std::unordered_map<QString, DirectorySnapshot>;
+
 class LibraryDatabase : public DbModule
 {
 public:
@@ -32,5 +50,9 @@ public:
 
     bool removeLibrary(int id);
     bool renameLibrary(int id, const QString& name);
+
+    bool getDirectorySnapshots(int libraryId, DirectorySnapshots& snapshots);
+    bool storeDirectorySnapshots(int libraryId, const DirectorySnapshots& snapshots);
+    bool removeDirectorySnapshots(int libraryId, const QStringList& dirs);
 };
 } // namespace Fooyin
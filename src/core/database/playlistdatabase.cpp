@@ -22,6 +22,8 @@
 #include <utils/database/dbquery.h>
 #include <utils/database/dbtransaction.h>
 
+#include <algorithm>
+
 namespace Fooyin {
 std::vector<PlaylistInfo> PlaylistDatabase::getAllPlaylists()
 {
@@ -75,7 +77,10 @@ int PlaylistDatabase::insertPlaylist(const QString& name, int index, bool isAuto
         return -1;
     }
 
-    return query.lastInsertId().toInt();
+    const int id = query.lastInsertId().toInt();
+    m_storedTrackIds.emplace(id, std::vector<int>{});
+
+    return id;
 }
 
 bool PlaylistDatabase::savePlaylist(Playlist& playlist)
@@ -99,7 +104,7 @@ bool PlaylistDatabase::savePlaylist(Playlist& playlist)
     }
 
     if(!playlist.isAutoPlaylist() && playlist.tracksModified()) {
-        updated = insertPlaylistTracks(playlist.dbId(), playlist.tracks());
+        updated = savePlaylistTracks(playlist.dbId(), playlist.tracks());
     }
 
     if(updated) {
@@ -118,7 +123,13 @@ bool PlaylistDatabase::saveModifiedPlaylists(const PlaylistList& playlists)
         savePlaylist(*playlist);
     }
 
-    return transaction.commit();
+    if(!transaction.commit()) {
+        // Stored tracks are unknown, so the next save of each playlist rewrites all of its tracks
+        m_storedTrackIds.clear();
+        return false;
+    }
+
+    return true;
 }
 
 bool PlaylistDatabase::removePlaylist(int id)
@@ -128,7 +139,12 @@ bool PlaylistDatabase::removePlaylist(int id)
     DbQuery query{db(), statement};
     query.bindValue(QStringLiteral(":id"), id);
 
-    return query.exec();
+    if(!query.exec()) {
+        return false;
+    }
+
+    m_storedTrackIds.erase(id);
+    return true;
 }
 
 bool PlaylistDatabase::renamePlaylist(int id, const QString& name)
@@ -146,25 +162,48 @@ bool PlaylistDatabase::renamePlaylist(int id, const QString& name)
     return query.exec();
 }
 
-bool PlaylistDatabase::insertPlaylistTrack(int playlistId, const Track& track, int index)
+void PlaylistDatabase::invalidateStoredTracks()
 {
-    const QString statement = QStringLiteral(
-        "INSERT INTO PlaylistTracks (PlaylistID, TrackID, TrackIndex) VALUES (:playlistId, :trackId, :index);");
-
-    DbQuery query{db(), statement};
-    query.bindValue(QStringLiteral(":playlistId"), playlistId);
-    query.bindValue(QStringLiteral(":trackId"), track.id());
-    query.bindValue(QStringLiteral(":index"), index);
-
-    return query.exec();
+    m_storedTrackIds.clear();
 }
 
-bool PlaylistDatabase::insertPlaylistTracks(int playlistId, const TrackList& tracks)
+bool PlaylistDatabase::savePlaylistTracks(int playlistId, const TrackList& tracks)
 {
     if(playlistId < 0) {
         return false;
     }
 
+    std::vector<int> trackIds;
+    trackIds.reserve(tracks.size());
+    for(const auto& track : tracks) {
+        if(track.isValid() && track.isInDatabase()) {
+            trackIds.push_back(track.id());
+        }
+    }
+
+    auto storedIt = m_storedTrackIds.find(playlistId);
+    // Entries are removed along with their tracks, which would leave gaps the delta can't account for
+    if(storedIt != m_storedTrackIds.end() && storedTrackCount(playlistId) != storedIt->second.size()) {
+        m_storedTrackIds.erase(storedIt);
+        storedIt = m_storedTrackIds.end();
+    }
+
+    const bool saved = storedIt != m_storedTrackIds.cend()
+                         ? updatePlaylistTracks(playlistId, storedIt->second, trackIds)
+                         : replacePlaylistTracks(playlistId, trackIds);
+
+    if(saved) {
+        m_storedTrackIds[playlistId] = std::move(trackIds);
+    }
+    else {
+        m_storedTrackIds.erase(playlistId);
+    }
+
+    return saved;
+}
+
+bool PlaylistDatabase::replacePlaylistTracks(int playlistId, const std::vector<int>& trackIds)
+{
     // Remove current playlist tracks
     const auto statement = QStringLiteral("DELETE FROM PlaylistTracks WHERE PlaylistID = :id;");
 
@@ -175,39 +214,130 @@ bool PlaylistDatabase::insertPlaylistTracks(int playlistId, const TrackList& tra
         return false;
     }
 
-    for(int i{0}; const auto& track : tracks) {
-        if(track.isValid() && track.isInDatabase()) {
-            if(!insertPlaylistTrack(playlistId, track, i++)) {
-                return false;
-            }
+    return insertPlaylistTracks(playlistId, trackIds, 0);
+}
+
+bool PlaylistDatabase::updatePlaylistTracks(int playlistId, const std::vector<int>& storedIds,
+                                            const std::vector<int>& trackIds)
+{
+    // Only the range between the unchanged start and end of the playlist is rewritten
+    const auto prefix = static_cast<size_t>(std::ranges::mismatch(storedIds, trackIds).in1 - storedIds.cbegin());
+
+    const size_t maxSuffix = std::min(storedIds.size(), trackIds.size()) - prefix;
+    size_t suffix{0};
+    while(suffix < maxSuffix && storedIds[storedIds.size() - suffix - 1] == trackIds[trackIds.size() - suffix - 1]) {
+        ++suffix;
+    }
+
+    const size_t removedEnd  = storedIds.size() - suffix;
+    const size_t insertedEnd = trackIds.size() - suffix;
+
+    if(removedEnd > prefix) {
+        const auto statement = QStringLiteral(
+            "DELETE FROM PlaylistTracks WHERE PlaylistID = :id AND TrackIndex >= :first AND TrackIndex < :last;");
+
+        DbQuery query{db(), statement};
+        query.bindValue(QStringLiteral(":id"), playlistId);
+        query.bindValue(QStringLiteral(":first"), static_cast<qulonglong>(prefix));
+        query.bindValue(QStringLiteral(":last"), static_cast<qulonglong>(removedEnd));
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    if(suffix > 0 && insertedEnd != removedEnd) {
+        const auto statement = QStringLiteral("UPDATE PlaylistTracks SET TrackIndex = TrackIndex + :shift "
+                                              "WHERE PlaylistID = :id AND TrackIndex >= :first;");
+
+        const auto shift = static_cast<qlonglong>(insertedEnd) - static_cast<qlonglong>(removedEnd);
+
+        DbQuery query{db(), statement};
+        query.bindValue(QStringLiteral(":shift"), shift);
+        query.bindValue(QStringLiteral(":id"), playlistId);
+        query.bindValue(QStringLiteral(":first"), static_cast<qulonglong>(removedEnd));
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return insertPlaylistTracks(playlistId, std::span{trackIds}.subspan(prefix, insertedEnd - prefix), prefix);
+}
+
+bool PlaylistDatabase::insertPlaylistTracks(int playlistId, std::span<const int> trackIds, size_t firstIndex)
+{
+    if(trackIds.empty()) {
+        return true;
+    }
+
+    const QString statement = QStringLiteral(
+        "INSERT INTO PlaylistTracks (PlaylistID, TrackID, TrackIndex) VALUES (:playlistId, :trackId, :index);");
+
+    // Prepared once and reused for every track
+    DbQuery query{db(), statement};
+
+    for(size_t i{0}; i < trackIds.size(); ++i) {
+        query.bindValue(QStringLiteral(":playlistId"), playlistId);
+        query.bindValue(QStringLiteral(":trackId"), trackIds[i]);
+        query.bindValue(QStringLiteral(":index"), static_cast<qulonglong>(firstIndex + i));
+
+        if(!query.exec()) {
+            return false;
         }
     }
 
     return true;
 }
 
+std::optional<size_t> PlaylistDatabase::storedTrackCount(int playlistId) const
+{
+    const auto statement = QStringLiteral("SELECT COUNT(*) FROM PlaylistTracks WHERE PlaylistID = :id;");
+
+    DbQuery query{db(), statement};
+    query.bindValue(QStringLiteral(":id"), playlistId);
+
+    if(!query.exec() || !query.next()) {
+        return {};
+    }
+
+    return static_cast<size_t>(query.value(0).toULongLong());
+}
+
 TrackList PlaylistDatabase::populatePlaylistTracks(const Playlist& playlist,
                                                    const std::unordered_map<int, Track>& tracks)
 {
-    const auto statement
-        = QStringLiteral("SELECT TrackID FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;");
+    const auto statement = QStringLiteral(
+        "SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;");
 
     DbQuery query{db(), statement};
     query.bindValue(QStringLiteral(":playlistId"), playlist.dbId());
 
+    m_storedTrackIds.erase(playlist.dbId());
+
     if(!query.exec()) {
         return {};
     }
 
     TrackList playlistTracks;
+    std::vector<int> storedIds;
+    bool contiguous{true};
 
     while(query.next()) {
         const int trackId = query.value(0).toInt();
+        contiguous        = contiguous && std::cmp_equal(query.value(1).toLongLong(), storedIds.size());
+        storedIds.push_back(trackId);
+
         if(tracks.contains(trackId)) {
             playlistTracks.push_back(tracks.at(trackId));
         }
     }
 
+    // Playlists with gaps or duplicates in their indexes are rewritten in full on the next save
+    if(contiguous) {
+        m_storedTrackIds.emplace(playlist.dbId(), std::move(storedIds));
+    }
+
     return playlistTracks;
 }
 } // namespace Fooyin
@@ -19,11 +19,21 @@
 
 #pragma once
 
+#include "fycore_export.h"
+
 #include <core/playlist/playlist.h>
 #include <core/track.h>
 #include <utils/database/dbmodule.h>
 
+#include <optional>
+#include <span>
+#include <unordered_map>
+
 namespace Fooyin {
+namespace Testing {
+class PlaylistDatabaseTest;
+} // namespace Testing
+
 struct PlaylistInfo
 {
     int dbId{-1};
@@ -33,7 +43,7 @@ struct PlaylistInfo
     QString query;
 };
 
-class PlaylistDatabase : public DbModule
+class FYCORE_EXPORT PlaylistDatabase : public DbModule
 {
 public:
     std::vector<PlaylistInfo> getAllPlaylists();
@@ -46,9 +56,23 @@ public:
     bool removePlaylist(int id);
     bool renamePlaylist(int id, const QString& name);
 
+    /*!
+     * Forgets the stored tracks of every playlist, so the next save of each rewrites its tracks in full.
+     * Must be called when tracks are deleted, as their playlist entries are removed along with them.
+     */
+    void invalidateStoredTracks();
+
 private:
-    bool insertPlaylistTrack(int playlistId, const Fooyin::Track& track, int index);
-    bool insertPlaylistTracks(int playlistId, const TrackList& tracks);
+    friend class Testing::PlaylistDatabaseTest;
+
+    bool savePlaylistTracks(int playlistId, const TrackList& tracks);
+    bool replacePlaylistTracks(int playlistId, const std::vector<int>& trackIds);
+    bool updatePlaylistTracks(int playlistId, const std::vector<int>& storedIds, const std::vector<int>& trackIds);
+    bool insertPlaylistTracks(int playlistId, std::span<const int> trackIds, size_t firstIndex);
+    [[nodiscard]] std::optional<size_t> storedTrackCount(int playlistId) const;
     TrackList populatePlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks);
+
+    // TrackIDs of each playlist as currently stored in the database, keyed by PlaylistID
+    std::unordered_map<int, std::vector<int>> m_storedTrackIds;
 };
 } // namespace Fooyin
@@ -19,20 +19,31 @@
 
 #include "trackdatabase.h"
 
+#include "stringpool.h"
+
 #include <core/constants.h>
 #include <core/track.h>
 #include <utils/database/dbquery.h>
 #include <utils/database/dbtransaction.h>
 #include <utils/fileutils.h>
+#include <utils/timer.h>
 
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QtConcurrentRun>
 
-Q_LOGGING_CATEGORY(TRK_DB, "fy.trackdb")
+#include <deque>
+#include <optional>
 
-using BindingsMap = std::map<QString, QVariant>;
+Q_LOGGING_CATEGORY(TRK_DB, "fy.trackdb")
+Q_LOGGING_CATEGORY(TRK_DB_WRITE, "fy.trackdb.write")
 
 namespace {
+constexpr auto TrackColumnCount = 43;
+// Number of fetched values converted to tracks per task when loading the library
+constexpr auto LoadChunkValues = static_cast<size_t>(2000 * TrackColumnCount);
+
 QString fetchTrackColumns()
 {
     static const QString columns = QStringLiteral("TrackID,"
@@ -82,48 +93,306 @@ QString fetchTrackColumns()
     return columns;
 }
 
-BindingsMap trackBindings(const Fooyin::Track& track)
-{
-    return {{QStringLiteral(":filePath"), track.filepath()},
-            {QStringLiteral(":subsong"), track.subsong()},
-            {QStringLiteral(":title"), track.title()},
-            {QStringLiteral(":trackNumber"), track.trackNumber()},
-            {QStringLiteral(":trackTotal"), track.trackTotal()},
-            {QStringLiteral(":artists"), track.artist()},
-            {QStringLiteral(":albumArtist"), track.albumArtist()},
-            {QStringLiteral(":album"), track.album()},
-            {QStringLiteral(":discNumber"), track.discNumber()},
-            {QStringLiteral(":discTotal"), track.discTotal()},
-            {QStringLiteral(":date"), track.date()},
-            {QStringLiteral(":composer"), track.composer()},
-            {QStringLiteral(":performer"), track.performer()},
-            {QStringLiteral(":genres"), track.genre()},
-            {QStringLiteral(":comment"), track.comment()},
-            {QStringLiteral(":cuePath"), track.cuePath()},
-            {QStringLiteral(":offset"), static_cast<quint64>(track.offset())},
-            {QStringLiteral(":duration"), static_cast<quint64>(track.duration())},
-            {QStringLiteral(":fileSize"), static_cast<quint64>(track.fileSize())},
-            {QStringLiteral(":bitRate"), track.bitrate()},
-            {QStringLiteral(":sampleRate"), track.sampleRate()},
-            {QStringLiteral(":channels"), track.channels()},
-            {QStringLiteral(":bitDepth"), track.bitDepth()},
-            {QStringLiteral(":codec"), track.codec()},
-            {QStringLiteral(":codecProfile"), track.codecProfile()},
-            {QStringLiteral(":tool"), track.tool()},
-            {QStringLiteral(":tagTypes"), track.tagType()},
-            {QStringLiteral(":encoding"), track.encoding()},
-            {QStringLiteral(":extraTags"), track.serialiseExtraTags()},
-            {QStringLiteral(":extraProperties"), track.serialiseExtraProperties()},
-            {QStringLiteral(":modifiedDate"), static_cast<quint64>(track.modifiedTime())},
-            {QStringLiteral(":trackHash"), track.hash()},
-            {QStringLiteral(":libraryID"), track.libraryId()},
-            {QStringLiteral(":rgTrackGain"), track.rgTrackGain()},
-            {QStringLiteral(":rgAlbumGain"), track.rgAlbumGain()},
-            {QStringLiteral(":rgTrackPeak"), track.rgTrackPeak()},
-            {QStringLiteral(":rgAlbumPeak"), track.rgAlbumPeak()}};
-}
-
-Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
+// Columns written when inserting or updating a track, in binding order
+const QStringList& writeTrackColumns()
+{
+    static const QStringList columns{QStringLiteral("FilePath"),
+                                     QStringLiteral("Subsong"),
+                                     QStringLiteral("Title"),
+                                     QStringLiteral("TrackNumber"),
+                                     QStringLiteral("TrackTotal"),
+                                     QStringLiteral("Artists"),
+                                     QStringLiteral("AlbumArtist"),
+                                     QStringLiteral("Album"),
+                                     QStringLiteral("DiscNumber"),
+                                     QStringLiteral("DiscTotal"),
+                                     QStringLiteral("Date"),
+                                     QStringLiteral("Composer"),
+                                     QStringLiteral("Performer"),
+                                     QStringLiteral("Genres"),
+                                     QStringLiteral("Comment"),
+                                     QStringLiteral("CuePath"),
+                                     QStringLiteral("Offset"),
+                                     QStringLiteral("Duration"),
+                                     QStringLiteral("FileSize"),
+                                     QStringLiteral("BitRate"),
+                                     QStringLiteral("SampleRate"),
+                                     QStringLiteral("Channels"),
+                                     QStringLiteral("BitDepth"),
+                                     QStringLiteral("Codec"),
+                                     QStringLiteral("CodecProfile"),
+                                     QStringLiteral("Tool"),
+                                     QStringLiteral("TagTypes"),
+                                     QStringLiteral("Encoding"),
+                                     QStringLiteral("ExtraTags"),
+                                     QStringLiteral("ExtraProperties"),
+                                     QStringLiteral("ModifiedDate"),
+                                     QStringLiteral("TrackHash"),
+                                     QStringLiteral("LibraryID"),
+                                     QStringLiteral("RGTrackGain"),
+                                     QStringLiteral("RGAlbumGain"),
+                                     QStringLiteral("RGTrackPeak"),
+                                     QStringLiteral("RGAlbumPeak")};
+    return columns;
+}
+
+const QString& insertTrackStatement()
+{
+    static const QString statement = []() {
+        const QStringList& columns = writeTrackColumns();
+        const QStringList placeholders(columns.size(), QStringLiteral("?"));
+
+        return QStringLiteral("INSERT INTO Tracks (%1) VALUES (%2);").arg(columns.join(u','), placeholders.join(u','));
+    }();
+
+    return statement;
+}
+
+const QString& updateTrackStatement()
+{
+    static const QString statement = []() {
+        QStringList assignments;
+        std::ranges::transform(writeTrackColumns(), std::back_inserter(assignments),
+                               [](const QString& column) { return column + u" = ?"; });
+
+        return QStringLiteral("UPDATE Tracks SET %1 WHERE TrackID = ?;").arg(assignments.join(u','));
+    }();
+
+    return statement;
+}
+
+// Binds the values of writeTrackColumns(), returning the next position
+int bindTrackValues(Fooyin::DbQuery& query, const Fooyin::Track& track)
+{
+    int pos{0};
+
+    query.bindValue(pos++, track.filepath());
+    query.bindValue(pos++, track.subsong());
+    query.bindValue(pos++, track.title());
+    query.bindValue(pos++, track.trackNumber());
+    query.bindValue(pos++, track.trackTotal());
+    query.bindValue(pos++, track.artist());
+    query.bindValue(pos++, track.albumArtist());
+    query.bindValue(pos++, track.album());
+    query.bindValue(pos++, track.discNumber());
+    query.bindValue(pos++, track.discTotal());
+    query.bindValue(pos++, track.date());
+    query.bindValue(pos++, track.composer());
+    query.bindValue(pos++, track.performer());
+    query.bindValue(pos++, track.genre());
+    query.bindValue(pos++, track.comment());
+    query.bindValue(pos++, track.cuePath());
+    query.bindValue(pos++, static_cast<quint64>(track.offset()));
+    query.bindValue(pos++, static_cast<quint64>(track.duration()));
+    query.bindValue(pos++, static_cast<quint64>(track.fileSize()));
+    query.bindValue(pos++, track.bitrate());
+    query.bindValue(pos++, track.sampleRate());
+    query.bindValue(pos++, track.channels());
+    query.bindValue(pos++, track.bitDepth());
+    query.bindValue(pos++, track.codec());
+    query.bindValue(pos++, track.codecProfile());
+    query.bindValue(pos++, track.tool());
+    query.bindValue(pos++, track.tagType());
+    query.bindValue(pos++, track.encoding());
+    query.bindValue(pos++, track.serialiseExtraTags());
+    query.bindValue(pos++, track.serialiseExtraProperties());
+    query.bindValue(pos++, static_cast<quint64>(track.modifiedTime()));
+    query.bindValue(pos++, track.hash());
+    query.bindValue(pos++, track.libraryId());
+    query.bindValue(pos++, track.rgTrackGain());
+    query.bindValue(pos++, track.rgAlbumGain());
+    query.bindValue(pos++, track.rgTrackPeak());
+    query.bindValue(pos++, track.rgAlbumPeak());
+
+    return pos;
+}
+
+void logWriteRate(const char* action, int count, const Fooyin::Timer& timer)
+{
+    if(count == 0) {
+        return;
+    }
+
+    const auto elapsed = timer.elapsed().count();
+    const auto rate    = elapsed > 0 ? (static_cast<double>(count) * 1000.0 / static_cast<double>(elapsed)) : 0.0;
+
+    qCDebug(TRK_DB_WRITE) << action << count << "tracks in" << timer.elapsedFormatted() << "(" << qRound(rate)
+                          << "rows/s)";
+}
+
+/*!
+ * Writes tracks and their stats using statements which are prepared on first use
+ * and then reused for every track written through the same writer.
+ */
+class TrackWriter
+{
+public:
+    explicit TrackWriter(QSqlDatabase db)
+        : m_db{std::move(db)}
+    { }
+
+    bool insertTrack(Fooyin::Track& track);
+    bool updateTrack(const Fooyin::Track& track);
+    bool insertOrUpdateStats(const Fooyin::Track& track);
+
+private:
+    Fooyin::DbQuery& prepared(std::optional<Fooyin::DbQuery>& query, const QString& statement);
+
+    QSqlDatabase m_db;
+
+    std::optional<Fooyin::DbQuery> m_insertQuery;
+    std::optional<Fooyin::DbQuery> m_updateQuery;
+    std::optional<Fooyin::DbQuery> m_statsQuery;
+    std::optional<Fooyin::DbQuery> m_updateStatsQuery;
+};
+
+Fooyin::DbQuery& TrackWriter::prepared(std::optional<Fooyin::DbQuery>& query, const QString& statement)
+{
+    if(!query) {
+        query.emplace(m_db, statement);
+    }
+    return query.value();
+}
+
+bool TrackWriter::insertTrack(Fooyin::Track& track)
+{
+    auto& query = prepared(m_insertQuery, insertTrackStatement());
+
+    bindTrackValues(query, track);
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    track.setId(query.lastInsertId().toInt());
+
+    return insertOrUpdateStats(track);
+}
+
+bool TrackWriter::updateTrack(const Fooyin::Track& track)
+{
+    if(track.id() < 0) {
+        qCWarning(TRK_DB) << "Cannot update track" << track.filepath() << "(Invalid ID)";
+        return false;
+    }
+
+    auto& query = prepared(m_updateQuery, updateTrackStatement());
+
+    const int idPos = bindTrackValues(query, track);
+    query.bindValue(idPos, track.id());
+
+    return query.exec();
+}
+
+bool TrackWriter::insertOrUpdateStats(const Fooyin::Track& track)
+{
+    if(track.hash().isEmpty()) {
+        qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
+        return false;
+    }
+
+    uint64_t added{0};
+    uint64_t firstPlayed{0};
+    uint64_t lastPlayed{0};
+    int playCount{0};
+    float rating{0};
+
+    {
+        auto& query = prepared(m_statsQuery,
+                               QStringLiteral("SELECT AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM "
+                                              "TrackStats WHERE TrackHash = ?;"));
+
+        query.bindValue(0, track.hash());
+
+        if(!query.exec()) {
+            return false;
+        }
+
+        if(query.next()) {
+            added       = query.value(0).toULongLong();
+            firstPlayed = query.value(1).toULongLong();
+            lastPlayed  = query.value(2).toULongLong();
+            playCount   = query.value(3).toInt();
+            rating      = query.value(4).toFloat();
+        }
+
+        query.finish();
+    }
+
+    bool dbNeedsUpdate{false};
+
+    const uint64_t trackAdded       = track.addedTime();
+    const uint64_t trackFirstPlayed = track.firstPlayed();
+    const uint64_t trackLastPlayed  = track.lastPlayed();
+    const int trackPlayCount        = track.playCount();
+    const float trackRating         = track.rating();
+
+    if(trackAdded != added) {
+        if(added == 0 || (trackAdded > 0 && trackAdded < added)) {
+            added         = trackAdded;
+            dbNeedsUpdate = true;
+        }
+    }
+    if(trackFirstPlayed != firstPlayed) {
+        if(firstPlayed == 0 || (trackFirstPlayed > 0 && trackFirstPlayed < firstPlayed)) {
+            firstPlayed   = trackFirstPlayed;
+            dbNeedsUpdate = true;
+        }
+    }
+    if(trackLastPlayed != lastPlayed) {
+        if(trackLastPlayed > lastPlayed) {
+            lastPlayed    = trackLastPlayed;
+            dbNeedsUpdate = true;
+        }
+    }
+    if(trackPlayCount != playCount) {
+        if(trackPlayCount > playCount) {
+            playCount     = trackPlayCount;
+            dbNeedsUpdate = true;
+        }
+    }
+    if(trackRating != rating) {
+        rating        = trackRating;
+        dbNeedsUpdate = true;
+    }
+
+    if(!dbNeedsUpdate) {
+        return true;
+    }
+
+    auto& query = prepared(m_updateStatsQuery, QStringLiteral("INSERT OR REPLACE INTO TrackStats (TrackHash, "
+                                                              "AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) "
+                                                              "VALUES (?, ?, ?, ?, ?, ?);"));
+
+    query.bindValue(0, track.hash());
+    query.bindValue(1, QVariant::fromValue(added));
+    query.bindValue(2, QVariant::fromValue(firstPlayed));
+    query.bindValue(3, QVariant::fromValue(lastPlayed));
+    query.bindValue(4, playCount);
+    query.bindValue(5, rating);
+
+    return query.exec();
+}
+
+// The column values of a single fetched row, in fetchTrackColumns() order
+class TrackRow
+{
+public:
+    explicit TrackRow(const QVariant* values)
+        : m_values{values}
+    { }
+
+    [[nodiscard]] const QVariant& value(int index) const
+    {
+        return m_values[index];
+    }
+
+private:
+    const QVariant* m_values;
+};
+
+template <typename Row>
+Fooyin::Track readToTrack(const Row& q)
 {
     Fooyin::Track track;
 
@@ -160,6 +429,10 @@ Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
     track.storeExtraProperties(q.value(30).toByteArray());
     track.setModifiedTime(q.value(31).toULongLong());
     track.setLibraryId(q.value(32).toInt());
+    // Interned before the hash is set, as the metadata setters regenerate it otherwise
+    if(track.isInLibrary()) {
+        Fooyin::StringPool::instance().internTrack(track);
+    }
     track.setHash(q.value(33).toString());
 
     bool isValid{false};
@@ -182,10 +455,25 @@ Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
     track.setPlayCount(q.value(41).toInt());
     track.setRating(q.value(42).toFloat());
 
-    track.generateHash();
+    // The stored hash was generated from the same metadata when the track was written
+    if(track.hash().isEmpty()) {
+        track.generateHash();
+    }
 
     return track;
 }
+
+Fooyin::TrackList readToTracks(const std::vector<QVariant>& values)
+{
+    Fooyin::TrackList tracks;
+    tracks.reserve(values.size() / TrackColumnCount);
+
+    for(size_t i{0}; i + TrackColumnCount <= values.size(); i += static_cast<size_t>(TrackColumnCount)) {
+        tracks.emplace_back(readToTrack(TrackRow{&values.at(i)}));
+    }
+
+    return tracks;
+}
 } // namespace
 
 namespace Fooyin {
@@ -195,19 +483,30 @@ bool TrackDatabase::storeTracks(TrackList& tracks)
         return true;
     }
 
+    const Timer timer;
+
     DbTransaction transaction{db()};
 
     if(!transaction) {
         return false;
     }
 
+    TrackWriter writer{db()};
+    int inserted{0};
+
     for(auto& track : tracks) {
-        if(track.id() < 0) {
-            insertTrack(track);
+        if(track.id() < 0 && writer.insertTrack(track)) {
+            ++inserted;
         }
     }
 
-    return transaction.commit();
+    if(!transaction.commit()) {
+        return false;
+    }
+
+    logWriteRate("Inserted", inserted, timer);
+
+    return true;
 }
 
 bool TrackDatabase::updateTracks(TrackList& tracks)
@@ -216,19 +515,30 @@ bool TrackDatabase::updateTracks(TrackList& tracks)
         return true;
     }
 
+    const Timer timer;
+
     DbTransaction transaction{db()};
 
     if(!transaction) {
         return false;
     }
 
+    TrackWriter writer{db()};
+    int updated{0};
+
     for(auto& track : tracks) {
-        if(track.id() >= 0) {
-            updateTrack(track);
+        if(track.id() >= 0 && writer.updateTrack(track)) {
+            ++updated;
         }
     }
 
-    return transaction.commit();
+    if(!transaction.commit()) {
+        return false;
+    }
+
+    logWriteRate("Updated", updated, timer);
+
+    return true;
 }
 
 bool TrackDatabase::reloadTrack(Track& track) const
@@ -294,10 +604,43 @@ TrackList TrackDatabase::getAllTracks() const
         tracks.reserve(numRows);
     }
 
+    // Rows are fetched here in chunks. Each chunk is converted to tracks on the global thread pool
+    // while the following chunks are fetched, and the results are appended in order.
+    const auto maxPending = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    std::deque<QFuture<TrackList>> pending;
+
+    const auto takeDecoded = [&tracks, &pending]() {
+        const TrackList decoded = pending.front().takeResult();
+        tracks.insert(tracks.end(), decoded.cbegin(), decoded.cend());
+        pending.pop_front();
+    };
+
+    std::vector<QVariant> values;
+    values.reserve(LoadChunkValues);
+
     while(q.next()) {
-        tracks.emplace_back(readToTrack(q));
+        for(int column{0}; column < TrackColumnCount; ++column) {
+            values.push_back(q.value(column));
+        }
+
+        if(values.size() >= LoadChunkValues) {
+            if(pending.size() >= maxPending) {
+                takeDecoded();
+            }
+            pending.push_back(QtConcurrent::run([chunk = std::move(values)]() { return readToTracks(chunk); }));
+
+            values = {};
+            values.reserve(LoadChunkValues);
+        }
     }
 
+    while(!pending.empty()) {
+        takeDecoded();
+    }
+
+    const TrackList remaining = readToTracks(values);
+    tracks.insert(tracks.end(), remaining.cbegin(), remaining.cend());
+
     return tracks;
 }
 
@@ -344,66 +687,12 @@ int TrackDatabase::idForTrack(Track& track) const
 
 bool TrackDatabase::updateTrack(const Track& track)
 {
-    if(track.id() < 0) {
-        qCWarning(TRK_DB) << "Cannot update track" << track.filepath() << "(Invalid ID)";
-        return false;
-    }
-
-    const auto statement = QStringLiteral("UPDATE TRACKS SET "
-                                          "FilePath = :filePath,"
-                                          "Subsong = :subsong,"
-                                          "Title = :title, "
-                                          "TrackNumber = :trackNumber,"
-                                          "TrackTotal = :trackTotal,"
-                                          "Artists = :artists,"
-                                          "AlbumArtist = :albumArtist,"
-                                          "Album = :album,"
-                                          "DiscNumber = :discNumber,"
-                                          "DiscTotal = :discTotal,"
-                                          "Date = :date,"
-                                          "Composer = :composer,"
-                                          "Performer = :performer,"
-                                          "Genres = :genres,"
-                                          "Comment = :comment,"
-                                          "CuePath = :cuePath,"
-                                          "Offset = :offset,"
-                                          "Duration = :duration,"
-                                          "FileSize = :fileSize,"
-                                          "BitRate = :bitRate,"
-                                          "SampleRate = :sampleRate,"
-                                          "Channels = :channels,"
-                                          "BitDepth = :bitDepth,"
-                                          "Codec = :codec,"
-                                          "CodecProfile = :codecProfile,"
-                                          "Tool = :tool,"
-                                          "TagTypes = :tagTypes,"
-                                          "Encoding = :encoding,"
-                                          "ExtraTags = :extraTags,"
-                                          "ExtraProperties = :extraProperties,"
-                                          "ModifiedDate = :modifiedDate,"
-                                          "TrackHash = :trackHash,"
-                                          "LibraryID = :libraryID,"
-                                          "RGTrackGain = :rgTrackGain,"
-                                          "RGAlbumGain = :rgAlbumGain,"
-                                          "RGTrackPeak = :rgTrackPeak,"
-                                          "RGAlbumPeak = :rgAlbumPeak"
-                                          " WHERE TrackID = :trackId;");
-
-    DbQuery query{db(), statement};
-
-    query.bindValue(QStringLiteral(":trackId"), track.id());
-
-    const auto bindings = trackBindings(track);
-    for(const auto& [name, value] : bindings) {
-        query.bindValue(name, value);
-    }
-
-    return query.exec();
+    return TrackWriter{db()}.updateTrack(track);
 }
 
 bool TrackDatabase::updateTrackStats(const Track& track)
 {
-    return insertOrUpdateStats(track);
+    return TrackWriter{db()}.insertOrUpdateStats(track);
 }
 
 bool TrackDatabase::updateTrackStats(const TrackList& tracks)
@@ -411,9 +700,10 @@ bool TrackDatabase::updateTrackStats(const TrackList& tracks)
     bool success{true};
 
     DbTransaction transaction{db()};
+    TrackWriter writer{db()};
 
     for(const Track& track : tracks) {
-        if(!insertOrUpdateStats(track)) {
+        if(!writer.insertOrUpdateStats(track)) {
             success = false;
         }
     }
@@ -588,194 +878,6 @@ int TrackDatabase::trackCount() const
     return -1;
 }
 
-bool TrackDatabase::insertTrack(Track& track) const
-{
-    const auto statement = QStringLiteral("INSERT INTO Tracks ("
-                                          "FilePath,"
-                                          "Subsong,"
-                                          "Title,"
-                                          "TrackNumber,"
-                                          "TrackTotal,"
-                                          "Artists,"
-                                          "AlbumArtist,"
-                                          "Album,"
-                                          "DiscNumber,"
-                                          "DiscTotal,"
-                                          "Date,"
-                                          "Composer,"
-                                          "Performer,"
-                                          "Genres,"
-                                          "Comment,"
-                                          "CuePath,"
-                                          "Offset,"
-                                          "Duration,"
-                                          "FileSize,"
-                                          "BitRate,"
-                                          "SampleRate,"
-                                          "Channels,"
-                                          "BitDepth,"
-                                          "Codec,"
-                                          "CodecProfile,"
-                                          "Tool,"
-                                          "TagTypes,"
-                                          "Encoding,"
-                                          "ExtraTags,"
-                                          "ExtraProperties,"
-                                          "ModifiedDate,"
-                                          "TrackHash,"
-                                          "LibraryID,"
-                                          "RGTrackGain,"
-                                          "RGAlbumGain,"
-                                          "RGTrackPeak,"
-                                          "RGAlbumPeak"
-                                          ") "
-                                          "VALUES ("
-                                          ":filePath,"
-                                          ":subsong,"
-                                          ":title, "
-                                          ":trackNumber,"
-                                          ":trackTotal,"
-                                          ":artists,"
-                                          ":albumArtist,"
-                                          ":album,"
-                                          ":discNumber,"
-                                          ":discTotal,"
-                                          ":date, "
-                                          ":composer,"
-                                          ":performer,"
-                                          ":genres,"
-                                          ":comment,"
-                                          ":cuePath,"
-                                          ":offset,"
-                                          ":duration,"
-                                          ":fileSize,"
-                                          ":bitRate,"
-                                          ":sampleRate,"
-                                          ":channels,"
-                                          ":bitDepth,"
-                                          ":codec,"
-                                          ":codecProfile,"
-                                          ":tool,"
-                                          ":tagTypes,"
-                                          ":encoding,"
-                                          ":extraTags,"
-                                          ":extraProperties,"
-                                          ":modifiedDate,"
-                                          ":trackHash,"
-                                          ":libraryID,"
-                                          ":rgTrackGain,"
-                                          ":rgAlbumGain,"
-                                          ":rgTrackPeak,"
-                                          ":rgAlbumPeak"
-                                          ");");
-
-    DbQuery query{db(), statement};
-
-    const auto bindings = trackBindings(track);
-    for(const auto& [name, value] : bindings) {
-        query.bindValue(name, value);
-    }
-
-    if(!query.exec()) {
-        return false;
-    }
-
-    track.setId(query.lastInsertId().toInt());
-
-    return insertOrUpdateStats(track);
-}
-
-bool TrackDatabase::insertOrUpdateStats(const Track& track) const
-{
-    if(track.hash().isEmpty()) {
-        qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
-        return false;
-    }
-
-    uint64_t added{0};
-    uint64_t firstPlayed{0};
-    uint64_t lastPlayed{0};
-    int playCount{0};
-    float rating{0};
-
-    {
-        const auto statement = QStringLiteral("SELECT AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM "
-                                              "TrackStats WHERE TrackHash = :trackHash;");
-
-        DbQuery query{db(), statement};
-
-        query.bindValue(QStringLiteral(":trackHash"), track.hash());
-
-        if(!query.exec()) {
-            return false;
-        }
-
-        if(query.next()) {
-            added       = query.value(0).toULongLong();
-            firstPlayed = query.value(1).toULongLong();
-            lastPlayed  = query.value(2).toULongLong();
-            playCount   = query.value(3).toInt();
-            rating      = query.value(4).toFloat();
-        }
-    }
-
-    bool dbNeedsUpdate{false};
-
-    const uint64_t trackAdded       = track.addedTime();
-    const uint64_t trackFirstPlayed = track.firstPlayed();
-    const uint64_t trackLastPlayed  = track.lastPlayed();
-    const int trackPlayCount        = track.playCount();
-    const float trackRating         = track.rating();
-
-    if(trackAdded != added) {
-        if(added == 0 || (trackAdded > 0 && trackAdded < added)) {
-            added         = trackAdded;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackFirstPlayed != firstPlayed) {
-        if(firstPlayed == 0 || (trackFirstPlayed > 0 && trackFirstPlayed < firstPlayed)) {
-            firstPlayed   = trackFirstPlayed;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackLastPlayed != lastPlayed) {
-        if(trackLastPlayed > lastPlayed) {
-            lastPlayed    = trackLastPlayed;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackPlayCount != playCount) {
-        if(trackPlayCount > playCount) {
-            playCount     = trackPlayCount;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackRating != rating) {
-        rating        = trackRating;
-        dbNeedsUpdate = true;
-    }
-
-    if(!dbNeedsUpdate) {
-        return true;
-    }
-
-    const auto statement = QStringLiteral(
-        "INSERT OR REPLACE INTO TrackStats (TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating) VALUES "
-        "(:trackHash, :addedDate, :firstPlayed, :lastPlayed, :playCount, :rating);");
-
-    DbQuery query{db(), statement};
-
-    query.bindValue(QStringLiteral(":trackHash"), track.hash());
-    query.bindValue(QStringLiteral(":addedDate"), QVariant::fromValue(added));
-    query.bindValue(QStringLiteral(":firstPlayed"), QVariant::fromValue(firstPlayed));
-    query.bindValue(QStringLiteral(":lastPlayed"), QVariant::fromValue(lastPlayed));
-    query.bindValue(QStringLiteral(":playCount"), playCount);
-    query.bindValue(QStringLiteral(":rating"), rating);
-
-    return query.exec();
-}
-
 void TrackDatabase::removeUnmanagedTracks() const
 {
     const auto statement = QStringLiteral(
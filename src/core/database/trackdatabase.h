@@ -54,8 +54,6 @@ public:
 
 private:
     [[nodiscard]] int trackCount() const;
-    bool insertTrack(Track& track) const;
-    bool insertOrUpdateStats(const Track& track) const;
     void removeUnmanagedTracks() const;
     void updateLastSeenStats() const;
     void deleteExpiredStats() const;
@@ -0,0 +1,204 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/engine/audioanalysis.h>
+
+#include <core/engine/audiobuffer.h>
+#include <core/engine/audioconverter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+void storeMax(std::atomic<float>& level, float value)
+{
+    float current = level.load(std::memory_order_relaxed);
+    while(value > current && !level.compare_exchange_weak(current, value, std::memory_order_relaxed)) { }
+}
+} // namespace
+
+namespace Fooyin {
+AudioAnalysis::AudioAnalysis()
+    : m_users{0}
+    , m_version{0}
+    , m_channels{0}
+{ }
+
+int AudioAnalysis::addUser()
+{
+    m_users.fetch_add(1, std::memory_order_relaxed);
+
+    for(int user{0}; user < MaxUsers; ++user) {
+        auto& userLevels = m_userLevels.at(user);
+        bool registered{false};
+        if(userLevels.registered.compare_exchange_strong(registered, true, std::memory_order_relaxed)) {
+            return user;
+        }
+    }
+
+    return -1;
+}
+
+void AudioAnalysis::removeUser(int user)
+{
+    m_users.fetch_sub(1, std::memory_order_relaxed);
+
+    if(user < 0 || user >= MaxUsers) {
+        return;
+    }
+
+    // Clear the max-hold so the next user of this slot starts from silence
+    auto& userLevels = m_userLevels.at(user);
+    for(int ch{0}; ch < MaxChannels; ++ch) {
+        userLevels.peak[ch].store(0.0F, std::memory_order_relaxed);
+        userLevels.rms[ch].store(0.0F, std::memory_order_relaxed);
+    }
+    userLevels.registered.store(false, std::memory_order_relaxed);
+}
+
+bool AudioAnalysis::isActive() const
+{
+    return m_users.load(std::memory_order_relaxed) > 0;
+}
+
+void AudioAnalysis::analyse(const AudioBuffer& buffer)
+{
+    if(!isActive() || !buffer.isValid()) {
+        return;
+    }
+
+    const AudioFormat format = buffer.format();
+    const int stride         = format.channelCount();
+    const int channels       = std::min(stride, MaxChannels);
+    const int frames         = buffer.frameCount();
+
+    if(channels <= 0 || frames <= 0) {
+        return;
+    }
+
+    // Samples are copied into a buffer reused across calls, converting to float if needed
+    m_samples.resize(static_cast<size_t>(frames) * stride);
+    auto* samples = reinterpret_cast<std::byte*>(m_samples.data());
+
+    if(format.sampleFormat() == SampleFormat::F32) {
+        std::memcpy(samples, buffer.data(), m_samples.size() * sizeof(float));
+    }
+    else {
+        AudioFormat floatFormat{format};
+        floatFormat.setSampleFormat(SampleFormat::F32);
+        if(!Audio::convert(format, buffer.data(), floatFormat, samples, frames)) {
+            return;
+        }
+    }
+
+    std::array<float, MaxChannels> peak{};
+    std::array<float, MaxChannels> rms{};
+
+    const float* frameSamples = m_samples.data();
+    for(int frame{0}; frame < frames; ++frame, frameSamples += stride) {
+        for(int ch{0}; ch < channels; ++ch) {
+            const float sample = frameSamples[ch];
+            peak[ch]           = std::max(peak[ch], std::abs(sample));
+            rms[ch] += sample * sample;
+        }
+    }
+
+    for(int ch{0}; ch < channels; ++ch) {
+        rms[ch] = std::sqrt(rms[ch] / static_cast<float>(frames));
+    }
+
+    accumulate(channels, peak, rms);
+    publish(channels, peak, rms);
+}
+
+AudioAnalysis::Levels AudioAnalysis::levels() const
+{
+    Levels levels;
+
+    while(true) {
+        const uint64_t version = m_version.load(std::memory_order_acquire);
+        if(version % 2 != 0) {
+            // Write in progress
+            continue;
+        }
+
+        levels.channels = m_channels.load(std::memory_order_relaxed);
+        for(int ch{0}; ch < MaxChannels; ++ch) {
+            levels.peak[ch] = m_peak[ch].load(std::memory_order_relaxed);
+            levels.rms[ch]  = m_rms[ch].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(m_version.load(std::memory_order_relaxed) == version) {
+            levels.sequence = version / 2;
+            return levels;
+        }
+    }
+}
+
+AudioAnalysis::Levels AudioAnalysis::takeLevels(int user)
+{
+    if(user < 0 || user >= MaxUsers) {
+        return levels();
+    }
+
+    Levels levels;
+    levels.sequence = m_version.load(std::memory_order_acquire) / 2;
+    levels.channels = m_channels.load(std::memory_order_relaxed);
+
+    auto& userLevels = m_userLevels.at(user);
+    for(int ch{0}; ch < MaxChannels; ++ch) {
+        levels.peak[ch] = userLevels.peak[ch].exchange(0.0F, std::memory_order_relaxed);
+        levels.rms[ch]  = userLevels.rms[ch].exchange(0.0F, std::memory_order_relaxed);
+    }
+
+    return levels;
+}
+
+void AudioAnalysis::accumulate(int channels, const std::array<float, MaxChannels>& peak,
+                               const std::array<float, MaxChannels>& rms)
+{
+    for(auto& userLevels : m_userLevels) {
+        if(!userLevels.registered.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        for(int ch{0}; ch < channels; ++ch) {
+            storeMax(userLevels.peak[ch], peak[ch]);
+            storeMax(userLevels.rms[ch], rms[ch]);
+        }
+    }
+}
+
+void AudioAnalysis::publish(int channels, const std::array<float, MaxChannels>& peak,
+                            const std::array<float, MaxChannels>& rms)
+{
+    const uint64_t version = m_version.load(std::memory_order_relaxed);
+    m_version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_channels.store(channels, std::memory_order_relaxed);
+    for(int ch{0}; ch < MaxChannels; ++ch) {
+        m_peak[ch].store(peak[ch], std::memory_order_relaxed);
+        m_rms[ch].store(rms[ch], std::memory_order_relaxed);
+    }
+
+    m_version.store(version + 2, std::memory_order_release);
+}
+} // namespace Fooyin
@@ -47,7 +47,8 @@ constexpr auto PositionInterval = 50;
 constexpr auto MaxDecodeLength = 100;
 
 namespace Fooyin {
-AudioPlaybackEngine::AudioPlaybackEngine(std::shared_ptr<AudioLoader> audioLoader, SettingsManager* settings,
+AudioPlaybackEngine::AudioPlaybackEngine(std::shared_ptr<AudioLoader> audioLoader,
+                                         std::shared_ptr<AudioAnalysis> analysis, SettingsManager* settings,
                                          QObject* parent)
     : AudioEngine{parent}
     , m_audioLoader{std::move(audioLoader)}
@@ -67,7 +68,7 @@ AudioPlaybackEngine::AudioPlaybackEngine(std::shared_ptr<AudioLoader> audioLoade
     , m_decoder{nullptr}
     , m_nextDecoder{nullptr}
     , m_outputThread{new QThread(this)}
-    , m_renderer{settings}
+    , m_renderer{std::move(analysis), settings}
     , m_fadeIntervals{m_settings->value<Settings::Core::Internal::FadingIntervals>().value<FadingIntervals>()}
 {
     m_renderer.moveToThread(m_outputThread);
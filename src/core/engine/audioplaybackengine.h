@@ -38,8 +38,8 @@ class AudioPlaybackEngine : public AudioEngine
     Q_OBJECT
 
 public:
-    explicit AudioPlaybackEngine(std::shared_ptr<AudioLoader> audioLoader, SettingsManager* settings,
-                                 QObject* parent = nullptr);
+    explicit AudioPlaybackEngine(std::shared_ptr<AudioLoader> audioLoader, std::shared_ptr<AudioAnalysis> analysis,
+                                 SettingsManager* settings, QObject* parent = nullptr);
     ~AudioPlaybackEngine() override;
 
     void loadTrack(const Track& track) override;
@@ -22,6 +22,7 @@
 #include "internalcoresettings.h"
 
 #include <core/coresettings.h>
+#include <core/engine/audioanalysis.h>
 #include <core/engine/audiobuffer.h>
 #include <core/engine/audioconverter.h>
 #include <core/engine/audioengine.h>
@@ -55,8 +56,9 @@ void alignBufferOffset(int& bufferOffset, int oldBps, int newBps)
 } // namespace
 
 namespace Fooyin {
-AudioRenderer::AudioRenderer(SettingsManager* settings, QObject* parent)
+AudioRenderer::AudioRenderer(std::shared_ptr<AudioAnalysis> analysis, SettingsManager* settings, QObject* parent)
     : QObject{parent}
+    , m_analysis{std::move(analysis)}
     , m_settings{settings}
     , m_volume{0.0}
     , m_gainScale{1.0}
@@ -577,6 +579,7 @@ int AudioRenderer::writeAudioSamples(int samples)
         if(bytesLeft <= 0) {
             m_currentBufferOffset    = 0;
             m_currentBufferResampled = false;
+            m_analysis->analyse(buffer);
             emit bufferProcessed(buffer);
             m_bufferQueue.pop_front();
             continue;
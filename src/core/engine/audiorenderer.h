@@ -30,6 +30,7 @@
 #include <deque>
 
 namespace Fooyin {
+class AudioAnalysis;
 class AudioBuffer;
 class AudioFormat;
 class SettingsManager;
@@ -39,7 +40,8 @@ class AudioRenderer : public QObject
     Q_OBJECT
 
 public:
-    explicit AudioRenderer(SettingsManager* settings, QObject* parent = nullptr);
+    explicit AudioRenderer(std::shared_ptr<AudioAnalysis> analysis, SettingsManager* settings,
+                           QObject* parent = nullptr);
 
     void init(const Track& track, const AudioFormat& format);
     void start();
@@ -94,6 +96,7 @@ private:
     int writeAudioSamples(int samples);
     int renderAudio(int samples);
 
+    std::shared_ptr<AudioAnalysis> m_analysis;
     SettingsManager* m_settings;
     std::unique_ptr<AudioOutput> m_audioOutput;
     Track m_currentTrack;
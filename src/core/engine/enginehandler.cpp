@@ -22,6 +22,7 @@
 #include "audioplaybackengine.h"
 
 #include <core/coresettings.h>
+#include <core/engine/audioanalysis.h>
 #include <core/engine/audioengine.h>
 #include <core/player/playercontroller.h>
 #include <core/track.h>
@@ -53,6 +54,7 @@ public:
     PlayerController* m_playerController;
     SettingsManager* m_settings;
 
+    std::shared_ptr<AudioAnalysis> m_analysis;
     QThread m_engineThread;
     AudioEngine* m_engine;
 
@@ -71,7 +73,8 @@ EngineHandlerPrivate::EngineHandlerPrivate(EngineHandler* self, std::shared_ptr<
     : m_self{self}
     , m_playerController{playerController}
     , m_settings{settings}
-    , m_engine{new AudioPlaybackEngine(std::move(decoderProvider), m_settings)}
+    , m_analysis{std::make_shared<AudioAnalysis>()}
+    , m_engine{new AudioPlaybackEngine(std::move(decoderProvider), m_analysis, m_settings)}
 {
     m_engine->moveToThread(&m_engineThread);
     m_engineThread.start();
@@ -298,6 +301,11 @@ void EngineHandler::addOutput(const QString& name, OutputCreator output)
     }
     p->m_outputs.emplace(name, std::move(output));
 }
+
+AudioAnalysis* EngineHandler::analysis() const
+{
+    return p->m_analysis.get();
+}
 } // namespace Fooyin
 
 #include "moc_enginehandler.cpp"
@@ -49,6 +49,8 @@ public:
     [[nodiscard]] OutputDevices getOutputDevices(const QString& output) const override;
     void addOutput(const QString& name, OutputCreator output) override;
 
+    [[nodiscard]] AudioAnalysis* analysis() const override;
+
 private:
     std::unique_ptr<EngineHandlerPrivate> p;
 };
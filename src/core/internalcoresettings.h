@@ -82,6 +82,7 @@ constexpr auto LibraryRestrictTypes    = "Library/RestrictTypes";
 constexpr auto LibraryExcludeTypes     = "Library/ExcludeTypes";
 constexpr auto ExternalRestrictTypes   = "Library/ExternalRestrictTypes";
 constexpr auto ExternalExcludeTypes    = "Library/ExternalExcludeTypes";
+constexpr auto LibraryScanThreads      = "Library/ScanThreads";
 constexpr auto FFmpegAllExtensions     = "Engine/FFmpegAllExtensions";
 
 enum CoreInternalSettings : uint32_t
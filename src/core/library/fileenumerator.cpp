@@ -0,0 +1,223 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "fileenumerator.h"
+
+#include <utils/fileutils.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <set>
+
+constexpr auto MaxQueuedDirs = 64U;
+
+namespace {
+bool isCue(const QFileInfo& file)
+{
+    return file.suffix().compare(u"cue", Qt::CaseInsensitive) == 0;
+}
+} // namespace
+
+namespace Fooyin {
+FileEnumerator::FileEnumerator(QStringList paths, const QStringList& nameFilters, KnownDirectories unchangedDirs)
+    : m_paths{std::move(paths)}
+    , m_nameFilters{Utils::extensionsToWildcards(nameFilters)}
+    , m_nameFiltersKey{nameFiltersKey(nameFilters)}
+    , m_unchangedDirs{std::move(unchangedDirs)}
+{ }
+
+FileEnumerator::~FileEnumerator()
+{
+    stop();
+    m_future.waitForFinished();
+}
+
+void FileEnumerator::start()
+{
+    m_future = QtConcurrent::run([this]() { enumerate(); });
+}
+
+void FileEnumerator::stop()
+{
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_stopped = true;
+    }
+    m_cv.notify_all();
+}
+
+bool FileEnumerator::next(QFileInfoList& files)
+{
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [this]() { return !m_queue.empty() || m_finished || m_stopped; });
+
+    if(m_queue.empty() || m_stopped) {
+        return false;
+    }
+
+    files = std::move(m_queue.front());
+    m_queue.pop_front();
+    lock.unlock();
+
+    m_cv.notify_all();
+    return true;
+}
+
+size_t FileEnumerator::enumeratedFiles() const
+{
+    return m_enumeratedFiles.load(std::memory_order_relaxed);
+}
+
+const DirectorySnapshots& FileEnumerator::snapshots() const
+{
+    return m_snapshots;
+}
+
+DirectorySnapshot FileEnumerator::directorySnapshot(const QFileInfo& info)
+{
+    const QDateTime modifiedTime = info.lastModified();
+    const QDateTime changedTime  = info.metadataChangeTime();
+
+    DirectorySnapshot snapshot;
+    snapshot.modifiedTime = modifiedTime.isValid() ? static_cast<uint64_t>(modifiedTime.toMSecsSinceEpoch()) : 0;
+    snapshot.changedTime  = changedTime.isValid() ? static_cast<uint64_t>(changedTime.toMSecsSinceEpoch()) : 0;
+    snapshot.size         = info.size();
+
+    return snapshot;
+}
+
+QString FileEnumerator::nameFiltersKey(const QStringList& nameFilters)
+{
+    QStringList filters;
+    std::ranges::transform(nameFilters, std::back_inserter(filters),
+                           [](const QString& filter) { return filter.toLower(); });
+    filters.sort();
+    filters.removeDuplicates();
+
+    return filters.join(u';');
+}
+
+void FileEnumerator::sortFiles(QFileInfoList& files)
+{
+    std::ranges::sort(files, {}, &QFileInfo::filePath);
+    std::ranges::stable_sort(files, [](const QFileInfo& a, const QFileInfo& b) { return isCue(a) && !isCue(b); });
+}
+
+void FileEnumerator::enumerate()
+{
+    std::vector<QString> dirs;
+
+    for(const QString& path : m_paths) {
+        const QFileInfo info{path};
+        if(info.isDir()) {
+            dirs.push_back(info.absoluteFilePath());
+        }
+        else if(info.isFile()) {
+            push({info});
+        }
+    }
+
+    // Directories are visited depth-first from the back
+    std::ranges::reverse(dirs);
+
+    while(!dirs.empty() && !isStopped()) {
+        const QString dirPath = dirs.back();
+        dirs.pop_back();
+
+        if(const auto unchangedIt = m_unchangedDirs.find(dirPath); unchangedIt != m_unchangedDirs.cend()) {
+            const auto& [snapshot, subdirs, knownFiles] = unchangedIt->second;
+            addSnapshot(dirPath, snapshot);
+
+            // Only the known files need checking, as nothing can have been added to or removed from the directory
+            const std::set<QString> uniqueFiles{knownFiles.cbegin(), knownFiles.cend()};
+            QFileInfoList files;
+            for(const QString& file : uniqueFiles) {
+                const QFileInfo info{file};
+                if(QDir::match(m_nameFilters, info.fileName()) && info.size() > 0) {
+                    files.push_back(info);
+                }
+            }
+            if(!files.empty()) {
+                sortFiles(files);
+                push(std::move(files));
+            }
+
+            for(auto subdirIt = subdirs.crbegin(); subdirIt != subdirs.crend(); ++subdirIt) {
+                dirs.push_back(*subdirIt);
+            }
+            continue;
+        }
+
+        const QDir dir{dirPath};
+        // Taken before listing so changes made while scanning are picked up next time
+        addSnapshot(dirPath, directorySnapshot(QFileInfo{dirPath}));
+
+        QFileInfoList files = dir.entryInfoList(m_nameFilters, QDir::Files);
+        std::erase_if(files, [](const QFileInfo& file) { return file.size() <= 0; });
+        if(!files.empty()) {
+            sortFiles(files);
+            push(std::move(files));
+        }
+
+        // Visit subdirectories in name order
+        const QStringList subdirs = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDir::Name);
+        for(auto subdirIt = subdirs.crbegin(); subdirIt != subdirs.crend(); ++subdirIt) {
+            dirs.push_back(dir.absoluteFilePath(*subdirIt));
+        }
+    }
+
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_finished = true;
+    }
+    m_cv.notify_all();
+}
+
+void FileEnumerator::addSnapshot(const QString& dir, DirectorySnapshot snapshot)
+{
+    snapshot.nameFilters = m_nameFiltersKey;
+    m_snapshots.emplace(dir, std::move(snapshot));
+}
+
+void FileEnumerator::push(QFileInfoList files)
+{
+    m_enumeratedFiles.fetch_add(static_cast<size_t>(files.size()), std::memory_order_relaxed);
+
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [this]() { return m_queue.size() < MaxQueuedDirs || m_stopped; });
+
+    if(m_stopped) {
+        return;
+    }
+
+    m_queue.push_back(std::move(files));
+    lock.unlock();
+
+    m_cv.notify_all();
+}
+
+bool FileEnumerator::isStopped()
+{
+    const std::scoped_lock lock{m_mutex};
+    return m_stopped;
+}
+} // namespace Fooyin
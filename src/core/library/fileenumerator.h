@@ -0,0 +1,111 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include "database/librarydatabase.h"
+
+#include <QFileInfoList>
+#include <QFuture>
+#include <QStringList>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Fooyin {
+// A directory which hasn't changed since the last scan, along with its contents at that time
+struct KnownDirectory
+{
+    DirectorySnapshot snapshot;
+    QStringList subdirs;
+    // Library files in the directory, which may still have been modified in place
+    QStringList files;
+};
+using KnownDirectories = std::unordered_map<QString, KnownDirectory>;
+
+/*!
+ * Enumerates the files under a set of paths on a separate thread, one directory at a time,
+ * so files can be processed while the rest of the tree is still being listed.
+ * Files in each directory are sorted with cue sheets first. At most MaxQueuedDirs directories
+ * are buffered before enumeration waits for the consumer.
+ * Unchanged directories aren't listed; only their known subdirectories and files are visited.
+ * Editing a file in place doesn't change its directory, so known files are still returned
+ * for the consumer to compare their modified time.
+ * Files are counted as soon as they're found, so the total is known ahead of the consumer.
+ */
+class FYCORE_EXPORT FileEnumerator
+{
+public:
+    FileEnumerator(QStringList paths, const QStringList& nameFilters, KnownDirectories unchangedDirs);
+    ~FileEnumerator();
+
+    FileEnumerator(const FileEnumerator&)            = delete;
+    FileEnumerator& operator=(const FileEnumerator&) = delete;
+
+    void start();
+    void stop();
+
+    /*!
+     * Waits for the files of the next directory.
+     * @returns false once enumeration has finished or been stopped.
+     */
+    bool next(QFileInfoList& files);
+
+    /** Returns the number of files found so far. Safe to call from any thread. */
+    [[nodiscard]] size_t enumeratedFiles() const;
+
+    /*!
+     * Returns the snapshots of every directory visited.
+     * @note only valid once next() has returned false.
+     */
+    [[nodiscard]] const DirectorySnapshots& snapshots() const;
+
+    /** Returns the current state of the directory @p info, without any name filters. */
+    static DirectorySnapshot directorySnapshot(const QFileInfo& info);
+    /** Returns @p nameFilters in the form stored in a DirectorySnapshot, independent of their order. */
+    static QString nameFiltersKey(const QStringList& nameFilters);
+    /** Sorts @p files by path, with cue sheets first. */
+    static void sortFiles(QFileInfoList& files);
+
+private:
+    void enumerate();
+    void addSnapshot(const QString& dir, DirectorySnapshot snapshot);
+    void push(QFileInfoList files);
+    bool isStopped();
+
+    QStringList m_paths;
+    QStringList m_nameFilters;
+    QString m_nameFiltersKey;
+    KnownDirectories m_unchangedDirs;
+    DirectorySnapshots m_snapshots;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<QFileInfoList> m_queue;
+    bool m_finished{false};
+    bool m_stopped{false};
+    std::atomic<size_t> m_enumeratedFiles{0};
+
+    QFuture<void> m_future;
+};
+} // namespace Fooyin
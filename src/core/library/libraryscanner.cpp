@@ -19,10 +19,13 @@
 
 #include "libraryscanner.h"
 
+#include "database/librarydatabase.h"
 #include "database/trackdatabase.h"
+#include "fileenumerator.h"
 #include "internalcoresettings.h"
 #include "librarywatcher.h"
 #include "playlist/playlistloader.h"
+#include "stringpool.h"
 
 #include <core/coresettings.h>
 #include <core/library/libraryinfo.h>
@@ -40,6 +43,9 @@
 #include <QDirIterator>
 #include <QFileSystemWatcher>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include <ranges>
 
@@ -49,22 +55,6 @@ constexpr auto BatchSize   = 250;
 constexpr auto ArchivePath = R"(unpack://%1|%2|file://%3!)";
 
 namespace {
-void sortFiles(QFileInfoList& files)
-{
-    std::ranges::sort(files, {}, &QFileInfo::filePath);
-    std::ranges::stable_sort(files, [](const QFileInfo& a, const QFileInfo& b) {
-        const bool aIsCue = a.suffix().compare(u"cue", Qt::CaseInsensitive) == 0;
-        const bool bIsCue = b.suffix().compare(u"cue", Qt::CaseInsensitive) == 0;
-        if(aIsCue && !bIsCue) {
-            return true;
-        }
-        if(!aIsCue && bIsCue) {
-            return false;
-        }
-        return false;
-    });
-}
-
 std::optional<QFileInfo> findMatchingCue(const QFileInfo& file)
 {
     static const QStringList cueExtensions{QStringLiteral("*.cue")};
@@ -122,11 +112,37 @@ QFileInfoList getFiles(const QStringList& paths, const QStringList& restrictExte
         }
     }
 
-    sortFiles(files);
+    Fooyin::FileEnumerator::sortFiles(files);
 
     return files;
 }
 
+uint64_t lastModifiedTime(const QFileInfo& info)
+{
+    const QDateTime lastModifiedTime{info.lastModified()};
+    if(lastModifiedTime.isValid()) {
+        return static_cast<uint64_t>(lastModifiedTime.toMSecsSinceEpoch());
+    }
+    return 0;
+}
+
+// A file waiting to have its tags read by the read pool
+struct PendingRead
+{
+    QString filepath;
+    uint64_t lastModified{0};
+    // Set if the file is already in the library
+    std::optional<Fooyin::Track> libraryTrack;
+    Fooyin::TrackList tracks;
+};
+
+bool isWithinPaths(const QString& dir, const QStringList& paths)
+{
+    return std::ranges::any_of(paths, [&dir](const QString& path) {
+        return dir == path || (dir.startsWith(path) && dir.at(path.size()) == u'/');
+    });
+}
+
 void readFileProperties(Fooyin::Track& track)
 {
     const QFileInfo fileInfo{track.filepath()};
@@ -183,9 +199,17 @@ public:
     void setTrackProps(Track& track, const QString& file);
 
     void updateExistingTrack(Track& track, const QString& file);
+    void addNewTracks(TrackList& tracks, const QString& file);
     void readNewTrack(const QString& file);
 
+    void setupReadPool();
+    [[nodiscard]] TrackList readAudioTracks(const QString& filepath) const;
+    bool queueFile(const QString& file, bool onlyModified);
+    void readQueuedFiles();
+
     void readFile(const QString& file, bool onlyModified);
+    void findUnchangedDirs(const QStringList& roots, const QStringList& nameFilters, bool onlyModified);
+    void saveDirectorySnapshots(const DirectorySnapshots& snapshots);
     void populateExistingTracks(const TrackList& tracks, bool includeMissing = true);
     bool getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified);
 
@@ -199,10 +223,13 @@ public:
     std::shared_ptr<AudioLoader> m_audioLoader;
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
+    QThreadPool m_readPool;
+    std::vector<PendingRead> m_pendingReads;
 
     bool m_monitor{false};
     LibraryInfo m_currentLibrary;
     TrackDatabase m_trackDatabase;
+    LibraryDatabase m_libraryDatabase;
 
     TrackList m_tracksToStore;
     TrackList m_tracksToUpdate;
@@ -214,9 +241,13 @@ public:
     std::unordered_map<QString, TrackList> m_existingCueTracks;
     std::unordered_map<QString, TrackList> m_missingCueTracks;
     std::set<QString> m_cueFilesScanned;
+    DirectorySnapshots m_dirSnapshots;
+    KnownDirectories m_unchangedDirs;
 
     std::set<QString> m_filesScanned;
     size_t m_totalFiles{0};
+    // Set while enumerating, as files found but not yet scanned count towards the total
+    const FileEnumerator* m_enumerator{nullptr};
 
     std::unordered_map<int, LibraryWatcher> m_watchers;
 };
@@ -235,6 +266,11 @@ void LibraryScannerPrivate::finishScan()
 void LibraryScannerPrivate::cleanupScan()
 {
     m_audioLoader->destroyThreadInstance();
+    // Exits the pool threads, which also destroys their reader instances
+    m_readPool.waitForDone();
+    // Release metadata strings which haven't been interned since the previous scan
+    StringPool::instance().prune();
+    m_pendingReads.clear();
     m_filesScanned.clear();
     m_totalFiles = 0;
     m_tracksToStore.clear();
@@ -246,6 +282,8 @@ void LibraryScannerPrivate::cleanupScan()
     m_existingCueTracks.clear();
     m_missingCueTracks.clear();
     m_cueFilesScanned.clear();
+    m_dirSnapshots.clear();
+    m_unchangedDirs.clear();
 }
 
 void LibraryScannerPrivate::addWatcher(const LibraryInfo& library)
@@ -267,7 +305,8 @@ void LibraryScannerPrivate::addWatcher(const LibraryInfo& library)
 
 void LibraryScannerPrivate::reportProgress(const QString& file) const
 {
-    emit m_self->progressChanged(static_cast<int>(m_filesScanned.size()), file, static_cast<int>(m_totalFiles));
+    const size_t totalFiles = m_totalFiles + (m_enumerator ? m_enumerator->enumeratedFiles() : 0);
+    emit m_self->progressChanged(static_cast<int>(m_filesScanned.size()), file, static_cast<int>(totalFiles));
 }
 
 void LibraryScannerPrivate::fileScanned(const QString& file)
@@ -329,6 +368,11 @@ TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
         return readArchiveTracks(filepath);
     }
 
+    return readAudioTracks(filepath);
+}
+
+TrackList LibraryScannerPrivate::readAudioTracks(const QString& filepath) const
+{
     auto* tagReader = m_audioLoader->readerForFile(filepath);
     if(!tagReader) {
         return {};
@@ -624,6 +668,8 @@ void LibraryScannerPrivate::setTrackProps(Track& track, const QString& file)
 
     if(m_currentLibrary.id >= 0) {
         track.setLibraryId(m_currentLibrary.id);
+        // Only library tracks are pooled, as the pool is pruned once their scan finishes
+        StringPool::instance().internTrack(track);
     }
     track.generateHash();
     track.setIsEnabled(true);
@@ -672,10 +718,11 @@ void LibraryScannerPrivate::updateExistingTrack(Track& track, const QString& fil
 void LibraryScannerPrivate::readNewTrack(const QString& file)
 {
     TrackList tracks = readTracks(file);
-    if(tracks.empty()) {
-        return;
-    }
+    addNewTracks(tracks, file);
+}
 
+void LibraryScannerPrivate::addNewTracks(TrackList& tracks, const QString& file)
+{
     for(Track& track : tracks) {
         Track refoundTrack = matchMissingTrack(track);
         if(refoundTrack.isInLibrary() || refoundTrack.isInDatabase()) {
@@ -703,6 +750,98 @@ void LibraryScannerPrivate::readNewTrack(const QString& file)
     }
 }
 
+void LibraryScannerPrivate::setupReadPool()
+{
+    using namespace Settings::Core::Internal;
+
+    int threadCount = m_settings.value(QLatin1String{LibraryScanThreads}, 0).toInt();
+    if(threadCount <= 0) {
+        threadCount = QThread::idealThreadCount();
+    }
+
+    m_readPool.setMaxThreadCount(threadCount);
+}
+
+bool LibraryScannerPrivate::queueFile(const QString& file, bool onlyModified)
+{
+    if(m_cueFilesScanned.contains(file)) {
+        return false;
+    }
+
+    const QFileInfo info{file};
+    const uint64_t lastModified = lastModifiedTime(info);
+
+    if(m_trackPaths.contains(file)) {
+        const Track& libraryTrack = m_trackPaths.at(file).front();
+
+        if(!libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
+           || libraryTrack.modifiedTime() < lastModified || !onlyModified) {
+            m_pendingReads.push_back({.filepath = file, .lastModified = lastModified, .libraryTrack = libraryTrack});
+            return true;
+        }
+        return false;
+    }
+
+    if(m_existingArchives.contains(file) || m_audioLoader->isArchive(file)) {
+        // Archives update the scan progress as they're read, so read them in order on this thread
+        readQueuedFiles();
+        readFile(file, onlyModified);
+        return false;
+    }
+
+    m_pendingReads.push_back({.filepath = file, .lastModified = lastModified});
+    return true;
+}
+
+void LibraryScannerPrivate::readQueuedFiles()
+{
+    if(m_pendingReads.empty()) {
+        return;
+    }
+
+    // Tag reading is independent per file, so read in parallel using the per-thread reader instances.
+    // Everything else (matching, database writes) is handled in file order on this thread.
+    QtConcurrent::blockingMap(&m_readPool, m_pendingReads, [this](PendingRead& read) {
+        if(!m_self->mayRun()) {
+            return;
+        }
+
+        if(read.libraryTrack) {
+            Track changedTrack{read.libraryTrack.value()};
+            if(m_audioLoader->readTrackMetadata(changedTrack)) {
+                read.tracks.push_back(changedTrack);
+            }
+        }
+        else {
+            read.tracks = readAudioTracks(read.filepath);
+        }
+    });
+
+    for(PendingRead& read : m_pendingReads) {
+        if(!m_self->mayRun()) {
+            break;
+        }
+
+        if(read.libraryTrack) {
+            if(!read.tracks.empty()) {
+                Track& changedTrack = read.tracks.front();
+                if(read.lastModified > 0) {
+                    changedTrack.setModifiedTime(read.lastModified);
+                }
+                updateExistingTrack(changedTrack, read.filepath);
+            }
+        }
+        else {
+            addNewTracks(read.tracks, read.filepath);
+        }
+
+        fileScanned(read.filepath);
+        checkBatchFinished();
+    }
+
+    m_pendingReads.clear();
+}
+
 void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
 {
     if(!m_self->mayRun()) {
@@ -754,6 +893,75 @@ void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
     }
 }
 
+void LibraryScannerPrivate::findUnchangedDirs(const QStringList& roots, const QStringList& nameFilters,
+                                              bool onlyModified)
+{
+    m_dirSnapshots.clear();
+    m_unchangedDirs.clear();
+
+    if(m_currentLibrary.id < 0) {
+        return;
+    }
+
+    m_libraryDatabase.getDirectorySnapshots(m_currentLibrary.id, m_dirSnapshots);
+    std::erase_if(m_dirSnapshots, [&roots](const auto& entry) { return !isWithinPaths(entry.first, roots); });
+
+    if(!onlyModified) {
+        return;
+    }
+
+    // A directory listed with other file types may contain files which are now eligible
+    const QString nameFiltersKey = FileEnumerator::nameFiltersKey(nameFilters);
+
+    for(const auto& [dir, snapshot] : m_dirSnapshots) {
+        const QFileInfo info{dir};
+        if(!info.isDir()) {
+            continue;
+        }
+
+        DirectorySnapshot current = FileEnumerator::directorySnapshot(info);
+        current.nameFilters       = nameFiltersKey;
+        if(current == snapshot) {
+            m_unchangedDirs[dir].snapshot = snapshot;
+        }
+    }
+
+    for(const QString& dir : m_dirSnapshots | std::views::keys) {
+        const auto parentIt = m_unchangedDirs.find(QFileInfo{dir}.path());
+        if(parentIt != m_unchangedDirs.end()) {
+            parentIt->second.subdirs.push_back(dir);
+        }
+    }
+
+    for(auto& unchangedDir : m_unchangedDirs | std::views::values) {
+        std::ranges::sort(unchangedDir.subdirs);
+    }
+
+    qCDebug(LIB_SCANNER) << m_unchangedDirs.size() << "of" << m_dirSnapshots.size()
+                         << "directories unchanged since last scan";
+}
+
+void LibraryScannerPrivate::saveDirectorySnapshots(const DirectorySnapshots& snapshots)
+{
+    QStringList removedDirs;
+    for(const QString& dir : m_dirSnapshots | std::views::keys) {
+        if(!snapshots.contains(dir)) {
+            removedDirs.push_back(dir);
+        }
+    }
+
+    DirectorySnapshots changedSnapshots;
+    for(const auto& [dir, snapshot] : snapshots) {
+        const auto prevIt = m_dirSnapshots.find(dir);
+        if(prevIt == m_dirSnapshots.cend() || prevIt->second != snapshot) {
+            changedSnapshots.emplace(dir, snapshot);
+        }
+    }
+
+    m_libraryDatabase.removeDirectorySnapshots(m_currentLibrary.id, removedDirs);
+    m_libraryDatabase.storeDirectorySnapshots(m_currentLibrary.id, changedSnapshots);
+}
+
 void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool includeMissing)
 {
     for(const Track& track : tracks) {
@@ -763,6 +971,29 @@ void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool
         }
 
         if(includeMissing) {
+            const QString dir = track.isInArchive() ? QFileInfo{track.archivePath()}.absolutePath() : track.path();
+            const auto unchangedIt = m_unchangedDirs.find(dir);
+
+            if(unchangedIt != m_unchangedDirs.end()) {
+                if(!track.isEnabled() || track.libraryId() != m_currentLibrary.id) {
+                    // Needs rescanning to be re-enabled or moved into this library
+                    m_unchangedDirs.erase(unchangedIt);
+                }
+                else {
+                    // Files edited in place don't change their directory, so still need their modified time checked
+                    QStringList& knownFiles = unchangedIt->second.files;
+                    knownFiles.push_back(track.isInArchive() ? track.archivePath() : track.filepath());
+                    if(track.hasCue() && track.cuePath() != u"Embedded" && QFileInfo{track.cuePath()}.path() == dir) {
+                        knownFiles.push_back(track.cuePath());
+                    }
+
+                    if(!track.hasCue()) {
+                        // Nothing can have been removed from an unchanged directory
+                        continue;
+                    }
+                }
+            }
+
             if(track.hasCue()) {
                 const auto cuePath = track.cuePath() == u"Embedded" ? track.filepath() : track.cuePath();
                 m_existingCueTracks[cuePath].emplace_back(track);
@@ -789,7 +1020,9 @@ void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool
 
 bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified)
 {
-    populateExistingTracks(tracks);
+    QStringList roots;
+    std::ranges::transform(paths, std::back_inserter(roots),
+                           [](const QString& path) { return QFileInfo{path}.absoluteFilePath(); });
 
     using namespace Settings::Core::Internal;
 
@@ -802,29 +1035,66 @@ bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const
         restrictExtensions.append(QStringLiteral("cue"));
     }
 
-    const auto files = getFiles(paths, restrictExtensions, excludeExtensions, {});
+    QStringList nameFilters{restrictExtensions};
+    for(const auto& ext : excludeExtensions) {
+        nameFilters.removeAll(ext);
+    }
+
+    findUnchangedDirs(roots, nameFilters, onlyModified);
+    populateExistingTracks(tracks);
 
-    m_totalFiles = files.size();
+    m_totalFiles = 0;
     reportProgress({});
 
-    for(const auto& file : files) {
-        if(!m_self->mayRun()) {
-            return false;
-        }
+    setupReadPool();
 
-        const QString filepath = file.absoluteFilePath();
+    FileEnumerator enumerator{roots, nameFilters, m_unchangedDirs};
+    m_enumerator = &enumerator;
+    enumerator.start();
 
-        if(file.suffix() == u"cue") {
-            readCue(filepath, onlyModified);
-        }
-        else {
-            readFile(filepath, onlyModified);
+    bool cancelled{false};
+    QFileInfoList files;
+    while(!cancelled && enumerator.next(files)) {
+        for(const auto& file : files) {
+            if(!m_self->mayRun()) {
+                cancelled = true;
+                break;
+            }
+
+            const QString filepath = file.absoluteFilePath();
+
+            if(file.suffix() == u"cue") {
+                readQueuedFiles();
+                readCue(filepath, onlyModified);
+            }
+            else if(queueFile(filepath, onlyModified)) {
+                if(m_pendingReads.size() >= BatchSize) {
+                    readQueuedFiles();
+                }
+                continue;
+            }
+
+            fileScanned(filepath);
+            checkBatchFinished();
         }
+    }
 
-        fileScanned(filepath);
-        checkBatchFinished();
+    // Keep the final count, as the enumerator doesn't outlive this scan
+    m_totalFiles += enumerator.enumeratedFiles();
+    m_enumerator = nullptr;
+
+    if(cancelled) {
+        return false;
+    }
+
+    readQueuedFiles();
+
+    if(!m_self->mayRun()) {
+        return false;
     }
 
+    saveDirectorySnapshots(enumerator.snapshots());
+
     for(const auto& missingTracks : m_missingFiles | std::views::values) {
         for(const auto& missingTrack : missingTracks) {
             if(missingTrack.isInLibrary() || missingTrack.isEnabled()) {
@@ -869,6 +1139,7 @@ void LibraryScanner::initialiseThread()
 
     p->m_dbHandler = std::make_unique<DbConnectionHandler>(p->m_dbPool);
     p->m_trackDatabase.initialise(DbConnectionProvider{p->m_dbPool});
+    p->m_libraryDatabase.initialise(DbConnectionProvider{p->m_dbPool});
 }
 
 void LibraryScanner::stopThread()
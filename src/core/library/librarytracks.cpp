@@ -0,0 +1,184 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/librarytracks.h>
+
+#include <core/library/tracksort.h>
+
+#include <algorithm>
+
+namespace Fooyin {
+void LibraryTracks::reset(const TrackList& tracks)
+{
+    m_tracks = tracks;
+
+    m_trackIndexes.clear();
+    m_hashIds.clear();
+    m_trackIndexes.reserve(m_tracks.size());
+
+    for(const Track& track : m_tracks) {
+        addToHashIndex(track);
+    }
+    indexFrom(0);
+}
+
+void LibraryTracks::insertTracks(const TrackList& tracks)
+{
+    if(tracks.empty()) {
+        return;
+    }
+
+    const size_t firstInserted = TrackSorter::insertSortedTracks(m_tracks, tracks);
+    for(const Track& track : tracks) {
+        addToHashIndex(track);
+    }
+    indexFrom(firstInserted);
+}
+
+void LibraryTracks::updateTracks(const TrackList& tracks)
+{
+    TrackList movedTracks;
+    std::set<int> movedIds;
+    size_t firstMoved{m_tracks.size()};
+
+    for(const Track& track : tracks) {
+        const auto indexIt = m_trackIndexes.find(track.id());
+        if(indexIt == m_trackIndexes.cend()) {
+            continue;
+        }
+
+        Track& libraryTrack = m_tracks.at(indexIt->second);
+
+        if(libraryTrack.hash() != track.hash()) {
+            removeFromHashIndex(libraryTrack);
+            addToHashIndex(track);
+        }
+
+        if(libraryTrack.sort() == track.sort()) {
+            libraryTrack = track;
+            libraryTrack.clearWasModified();
+        }
+        else {
+            Track movedTrack{track};
+            movedTrack.clearWasModified();
+            movedTracks.push_back(movedTrack);
+            movedIds.emplace(track.id());
+            firstMoved = std::min(firstMoved, indexIt->second);
+        }
+    }
+
+    if(movedTracks.empty()) {
+        return;
+    }
+
+    // Tracks before the first moved track keep their position, both on removal and re-insertion
+    std::erase_if(m_tracks, [&movedIds](const Track& track) { return movedIds.contains(track.id()); });
+    const size_t firstInserted = TrackSorter::insertSortedTracks(m_tracks, movedTracks);
+    indexFrom(std::min(firstMoved, firstInserted));
+}
+
+void LibraryTracks::removeTracks(const std::set<int>& ids)
+{
+    size_t firstRemoved{m_tracks.size()};
+
+    for(const int id : ids) {
+        const auto indexIt = m_trackIndexes.find(id);
+        if(indexIt == m_trackIndexes.cend()) {
+            continue;
+        }
+
+        firstRemoved = std::min(firstRemoved, indexIt->second);
+        removeFromHashIndex(m_tracks.at(indexIt->second));
+        m_trackIndexes.erase(indexIt);
+    }
+
+    if(firstRemoved == m_tracks.size()) {
+        return;
+    }
+
+    std::erase_if(m_tracks, [&ids](const Track& track) { return ids.contains(track.id()); });
+    indexFrom(firstRemoved);
+}
+
+const TrackList& LibraryTracks::tracks() const
+{
+    return m_tracks;
+}
+
+bool LibraryTracks::empty() const
+{
+    return m_tracks.empty();
+}
+
+size_t LibraryTracks::size() const
+{
+    return m_tracks.size();
+}
+
+const Track* LibraryTracks::track(int id) const
+{
+    const auto indexIt = m_trackIndexes.find(id);
+    if(indexIt == m_trackIndexes.cend()) {
+        return nullptr;
+    }
+    return &m_tracks.at(indexIt->second);
+}
+
+Track* LibraryTracks::track(int id)
+{
+    const auto indexIt = m_trackIndexes.find(id);
+    if(indexIt == m_trackIndexes.cend()) {
+        return nullptr;
+    }
+    return &m_tracks.at(indexIt->second);
+}
+
+TrackIds LibraryTracks::idsForHash(const QString& hash) const
+{
+    if(const auto hashIt = m_hashIds.find(hash); hashIt != m_hashIds.cend()) {
+        return hashIt->second;
+    }
+    return {};
+}
+
+void LibraryTracks::indexFrom(size_t position)
+{
+    for(size_t i{position}; i < m_tracks.size(); ++i) {
+        m_trackIndexes[m_tracks.at(i).id()] = i;
+    }
+}
+
+void LibraryTracks::addToHashIndex(const Track& track)
+{
+    m_hashIds[track.hash()].push_back(track.id());
+}
+
+void LibraryTracks::removeFromHashIndex(const Track& track)
+{
+    auto hashIt = m_hashIds.find(track.hash());
+    if(hashIt == m_hashIds.end()) {
+        return;
+    }
+
+    std::erase(hashIt->second, track.id());
+    if(hashIt->second.empty()) {
+        m_hashIds.erase(hashIt);
+    }
+}
+} // namespace Fooyin
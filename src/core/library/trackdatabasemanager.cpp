@@ -21,6 +21,7 @@
 
 #include "database/trackdatabase.h"
 #include "internalcoresettings.h"
+#include "stringpool.h"
 
 #include <core/coresettings.h>
 #include <core/engine/audioloader.h>
@@ -28,6 +29,8 @@
 #include <core/track.h>
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/settings/settingsmanager.h>
+#include <utils/stringutils.h>
+#include <utils/timer.h>
 
 #include <QFileInfo>
 #include <QLoggingCategory>
@@ -71,8 +74,17 @@ void TrackDatabaseManager::getAllTracks()
 {
     setState(Running);
 
+    const Timer timer;
+
     TrackList tracks = m_trackDatabase.getAllTracks();
 
+    qCInfo(TRK_DBMAN) << "Loaded" << tracks.size() << "tracks from the database in" << timer.elapsedFormatted();
+
+    const auto poolStats = StringPool::instance().stats();
+    qCInfo(TRK_DBMAN) << "Metadata string pool:" << poolStats.strings << "strings using"
+                      << Utils::formatFileSize(poolStats.bytes) << "-" << Utils::formatFileSize(poolStats.savedBytes)
+                      << "saved by sharing";
+
     if(m_settings->fileValue(Settings::Core::Internal::MarkUnavailableStartup, false).toBool()) {
         std::ranges::for_each(tracks, [](auto& track) { track.setIsEnabled(track.exists()); });
     }
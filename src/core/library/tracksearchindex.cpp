@@ -0,0 +1,295 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksearchindex.h>
+
+#include <QHashFunctions>
+#include <QStringList>
+
+#include <algorithm>
+#include <mutex>
+#include <ranges>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+// Splits the case-folded @p text into runs of letters and numbers
+QStringList tokenise(const QString& text)
+{
+    QStringList tokens;
+
+    const QString folded = text.toCaseFolded();
+    qsizetype start{-1};
+
+    for(qsizetype i{0}; i < folded.size(); ++i) {
+        if(folded.at(i).isLetterOrNumber()) {
+            if(start < 0) {
+                start = i;
+            }
+        }
+        else if(start >= 0) {
+            tokens.emplace_back(folded.mid(start, i - start));
+            start = -1;
+        }
+    }
+
+    if(start >= 0) {
+        tokens.emplace_back(folded.mid(start));
+    }
+
+    return tokens;
+}
+
+QStringList searchFields(const Fooyin::Track& track)
+{
+    // Must match the fields of Track::hasMatch and searchSignature
+    return {track.artist(),    track.title(),    track.album(), track.albumArtist(),
+            track.performer(), track.composer(), track.genre(), track.filepath()};
+}
+
+// Identifies the searched metadata of @p track, so matches are only applied to the metadata which was indexed
+size_t searchSignature(const Fooyin::Track& track)
+{
+    const size_t signature = qHashMulti(0, track.artist(), track.title(), track.album(), track.albumArtist(),
+                                        track.performer(), track.composer(), track.genre(), track.filepath());
+    // 0 is reserved for tracks which aren't indexed
+    return signature == 0 ? 1 : signature;
+}
+
+void intersect(std::vector<bool>& result, const std::vector<bool>& other)
+{
+    for(size_t i{0}; i < result.size(); ++i) {
+        result[i] = result[i] && other[i];
+    }
+}
+} // namespace
+
+namespace Fooyin {
+TrackSearchMatches::TrackSearchMatches(std::vector<bool> matched, std::vector<size_t> signatures, bool exact)
+    : m_matched{std::move(matched)}
+    , m_signatures{std::move(signatures)}
+    , m_exact{exact}
+{ }
+
+std::optional<bool> TrackSearchMatches::matches(const Track& track) const
+{
+    const int id = track.id();
+    if(id < 0 || std::cmp_greater_equal(id, m_signatures.size())) {
+        return {};
+    }
+
+    const size_t signature = m_signatures.at(id);
+    if(signature == 0 || signature != searchSignature(track)) {
+        return {};
+    }
+
+    if(!m_matched.at(id)) {
+        return false;
+    }
+
+    if(m_exact) {
+        return true;
+    }
+
+    return {};
+}
+
+void TrackSearchIndex::reset(const TrackList& tracks)
+{
+    // Build outside of the lock so searches aren't blocked while indexing the whole library
+    TrackSearchIndex index;
+    for(const Track& track : tracks) {
+        index.addTrack(track);
+    }
+
+    const std::unique_lock lock{m_mutex};
+
+    m_tokens      = std::move(index.m_tokens);
+    m_tokenIds    = std::move(index.m_tokenIds);
+    m_postings    = std::move(index.m_postings);
+    m_trackTokens = std::move(index.m_trackTokens);
+    m_maxId       = index.m_maxId;
+}
+
+void TrackSearchIndex::addTracks(const TrackList& tracks)
+{
+    const std::unique_lock lock{m_mutex};
+
+    std::vector<int> existingIds;
+    for(const Track& track : tracks) {
+        if(m_trackTokens.contains(track.id())) {
+            existingIds.push_back(track.id());
+        }
+    }
+    removeIds(existingIds);
+
+    for(const Track& track : tracks) {
+        addTrack(track);
+    }
+}
+
+void TrackSearchIndex::updateTracks(const TrackList& tracks)
+{
+    addTracks(tracks);
+}
+
+void TrackSearchIndex::removeTracks(const TrackList& tracks)
+{
+    std::vector<int> ids;
+    ids.reserve(tracks.size());
+    std::ranges::transform(tracks, std::back_inserter(ids), &Track::id);
+
+    const std::unique_lock lock{m_mutex};
+    removeIds(ids);
+}
+
+size_t TrackSearchIndex::size() const
+{
+    const std::shared_lock lock{m_mutex};
+    return m_trackTokens.size();
+}
+
+std::optional<TrackSearchMatches> TrackSearchIndex::search(const QString& search, bool singleString) const
+{
+    const QStringList terms = singleString ? QStringList{search} : search.split(u' ', Qt::SkipEmptyParts);
+    if(terms.empty()) {
+        return {};
+    }
+
+    const std::shared_lock lock{m_mutex};
+
+    if(m_trackTokens.empty()) {
+        return {};
+    }
+
+    const auto idCount = static_cast<size_t>(m_maxId + 1);
+
+    std::vector<bool> matched;
+    bool exact{true};
+    std::unordered_set<QString> searchedTokens;
+
+    for(const QString& term : terms) {
+        const QStringList tokens = tokenise(term);
+        if(tokens.empty()) {
+            // Only punctuation, so there are no words to look up
+            return {};
+        }
+
+        // A term which is a single word can only appear inside a single indexed word.
+        // Otherwise each word of the term must appear, but the matches still need to be confirmed.
+        if(tokens.size() > 1 || tokens.front().size() != term.size()) {
+            exact = false;
+        }
+
+        for(const QString& token : tokens) {
+            if(!searchedTokens.emplace(token).second) {
+                continue;
+            }
+
+            std::vector<bool> tokenMatches(idCount, false);
+            matchToken(token, tokenMatches);
+
+            if(matched.empty()) {
+                matched = std::move(tokenMatches);
+            }
+            else {
+                intersect(matched, tokenMatches);
+            }
+        }
+    }
+
+    std::vector<size_t> signatures(idCount, 0);
+    for(const auto& [id, track] : m_trackTokens) {
+        signatures[id] = track.signature;
+    }
+
+    return TrackSearchMatches{std::move(matched), std::move(signatures), exact};
+}
+
+void TrackSearchIndex::addTrack(const Track& track)
+{
+    const int id = track.id();
+    if(id < 0) {
+        return;
+    }
+
+    TokenIds tokenIds;
+
+    for(const QString& field : searchFields(track)) {
+        for(const QString& token : tokenise(field)) {
+            auto [tokenIt, inserted] = m_tokenIds.try_emplace(token, static_cast<int>(m_tokens.size()));
+            if(inserted) {
+                m_tokens.push_back(token);
+                m_postings.emplace_back();
+            }
+            tokenIds.push_back(tokenIt->second);
+        }
+    }
+
+    std::ranges::sort(tokenIds);
+    const auto duplicates = std::ranges::unique(tokenIds);
+    tokenIds.erase(duplicates.begin(), duplicates.end());
+
+    for(const int tokenId : tokenIds) {
+        m_postings.at(tokenId).push_back(id);
+    }
+
+    m_trackTokens[id] = {.signature = searchSignature(track), .tokens = std::move(tokenIds)};
+    m_maxId           = std::max(m_maxId, id);
+}
+
+void TrackSearchIndex::removeIds(const std::vector<int>& ids)
+{
+    if(ids.empty()) {
+        return;
+    }
+
+    std::unordered_set<int> removedIds;
+    std::unordered_set<int> affectedTokens;
+
+    for(const int id : ids) {
+        const auto tokensIt = m_trackTokens.find(id);
+        if(tokensIt == m_trackTokens.end()) {
+            continue;
+        }
+        removedIds.emplace(id);
+        const TokenIds& tokenIds = tokensIt->second.tokens;
+        affectedTokens.insert(tokenIds.cbegin(), tokenIds.cend());
+        m_trackTokens.erase(tokensIt);
+    }
+
+    // Each affected posting list is filtered once per batch rather than once per track
+    for(const int tokenId : affectedTokens) {
+        std::erase_if(m_postings.at(tokenId), [&removedIds](const int id) { return removedIds.contains(id); });
+    }
+}
+
+void TrackSearchIndex::matchToken(const QString& token, std::vector<bool>& matched) const
+{
+    for(size_t i{0}; i < m_tokens.size(); ++i) {
+        const auto& postings = m_postings.at(i);
+        if(postings.empty() || !m_tokens.at(i).contains(token)) {
+            continue;
+        }
+        for(const int id : postings) {
+            matched[id] = true;
+        }
+    }
+}
+} // namespace Fooyin
@@ -19,13 +19,65 @@
 
 #include <core/library/tracksort.h>
 
+#include <QCollator>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+// Below this size a list is handled on the calling thread
+constexpr auto MinChunkSize = 2000;
+
+struct Chunk
+{
+    int begin{0};
+    int end{0};
+};
+
+std::vector<Chunk> splitIntoChunks(int count)
+{
+    const int threadCount = std::max(1, QThread::idealThreadCount());
+    const int chunkSize   = std::max(MinChunkSize, (count + threadCount - 1) / threadCount);
+
+    std::vector<Chunk> chunks;
+    for(int begin{0}; begin < count; begin += chunkSize) {
+        chunks.push_back({.begin = begin, .end = std::min(begin + chunkSize, count)});
+    }
+    return chunks;
+}
+
+QCollator sortCollator()
+{
+    QCollator collator;
+    collator.setNumericMode(true);
+    return collator;
+}
+
+bool sortLessThan(const QCollator& collator, const QString& lhs, const QString& rhs, Qt::SortOrder order)
+{
+    const auto cmp = collator.compare(lhs, rhs);
+
+    if(cmp == 0) {
+        return false;
+    }
+
+    if(order == Qt::AscendingOrder) {
+        return cmp < 0;
+    }
+    return cmp > 0;
+}
+} // namespace
+
 namespace Fooyin {
 TrackSorter::TrackSorter()
     : TrackSorter{nullptr}
 { }
 
 TrackSorter::TrackSorter(LibraryManager* libraryManager)
-    : m_parser{new ScriptRegistry(libraryManager)}
+    : m_libraryManager{libraryManager}
+    , m_parser{new ScriptRegistry(libraryManager)}
 { }
 
 TrackSorter::~TrackSorter() = default;
@@ -37,22 +89,86 @@ TrackList TrackSorter::calcSortFields(const QString& sort, const TrackList& trac
 
 TrackList TrackSorter::calcSortFields(const ParsedScript& sortScript, const TrackList& tracks)
 {
-    const std::scoped_lock lock{m_parserGuard};
-
     TrackList calcTracks{tracks};
-    for(Track& track : calcTracks) {
-        track.setSort(m_parser.evaluate(sortScript, track));
+
+    const std::vector<QString> keys = calcSortKeys(
+        sortScript, calcTracks.size(), [&calcTracks](size_t index) -> const Track& { return calcTracks[index]; });
+
+    for(size_t i{0}; i < calcTracks.size(); ++i) {
+        applySortKey(calcTracks[i], keys[i]);
     }
+
     return calcTracks;
 }
 
 TrackList TrackSorter::sortTracks(const TrackList& tracks, Qt::SortOrder order)
 {
-    TrackList sortedTracks{tracks};
-    sortTracks(sortedTracks, std::identity{}, order);
+    std::vector<QString> keys;
+    keys.reserve(tracks.size());
+    std::ranges::transform(tracks, std::back_inserter(keys), [](const Track& track) { return track.sort(); });
+
+    TrackList sortedTracks;
+    sortedTracks.reserve(tracks.size());
+
+    for(const int index : sortIndexes(keys, order)) {
+        sortedTracks.push_back(tracks.at(index));
+    }
+
     return sortedTracks;
 }
 
+size_t TrackSorter::insertSortedTracks(TrackList& tracks, const TrackList& newTracks, Qt::SortOrder order)
+{
+    if(newTracks.empty()) {
+        return tracks.size();
+    }
+
+    const QCollator collator = sortCollator();
+    const auto insertBefore  = [&collator, order](const Track& newTrack, const Track& track) {
+        return sortLessThan(collator, newTrack.sort(), track.sort(), order);
+    };
+
+    // Find where each new track belongs in the existing list. As newTracks is sorted,
+    // every search can start from the previous position.
+    std::vector<size_t> positions;
+    positions.reserve(newTracks.size());
+
+    auto searchStart = tracks.cbegin();
+    for(const Track& newTrack : newTracks) {
+        searchStart = std::upper_bound(searchStart, tracks.cend(), newTrack, insertBefore);
+        positions.push_back(static_cast<size_t>(std::distance(tracks.cbegin(), searchStart)));
+    }
+
+    // Merge from the back so only tracks after the first insertion point are moved
+    const size_t oldSize = tracks.size();
+    tracks.resize(oldSize + newTracks.size());
+
+    size_t read  = oldSize;
+    size_t write = tracks.size();
+
+    for(size_t i{newTracks.size()}; i > 0; --i) {
+        const size_t position = positions[i - 1];
+        while(read > position) {
+            tracks[--write] = std::move(tracks[--read]);
+        }
+        tracks[--write] = newTracks[i - 1];
+    }
+
+    return positions.front();
+}
+
+bool TrackSorter::hasSortTies(const TrackList& tracks, const std::vector<size_t>& indexes)
+{
+    const QCollator collator = sortCollator();
+    const auto equalSort     = [&collator, &tracks](size_t lhs, size_t rhs) {
+        return collator.compare(tracks[lhs].sort(), tracks[rhs].sort()) == 0;
+    };
+
+    return std::ranges::any_of(indexes, [&tracks, &equalSort](size_t index) {
+        return (index > 0 && equalSort(index - 1, index)) || (index + 1 < tracks.size() && equalSort(index, index + 1));
+    });
+}
+
 TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& tracks, Qt::SortOrder order)
 {
     return calcSortTracks(parseScript(sort), tracks, order);
@@ -66,8 +182,10 @@ TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& trac
 
 TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks, Qt::SortOrder order)
 {
-    const TrackList calcTracks = calcSortFields(sortScript, tracks);
-    return sortTracks(calcTracks, order);
+    const std::vector<QString> keys
+        = calcSortKeys(sortScript, tracks.size(), [&tracks](size_t index) -> const Track& { return tracks[index]; });
+
+    return sortByKeys(tracks, keys, std::identity{}, order);
 }
 
 TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const TrackList& tracks,
@@ -84,8 +202,7 @@ TrackList TrackSorter::calcSortTracks(const ParsedScript& sortScript, const Trac
         tracksToSort.push_back(tracks.at(index));
     }
 
-    const TrackList calcTracks      = calcSortFields(sortScript, tracksToSort);
-    const TrackList sortedSubTracks = sortTracks(calcTracks, order);
+    const TrackList sortedSubTracks = calcSortTracks(sortScript, tracksToSort, order);
 
     for(auto i{0}; const int index : validIndexes) {
         sortedTracks[index] = sortedSubTracks.at(i++);
@@ -99,4 +216,96 @@ ParsedScript TrackSorter::parseScript(const QString& sort)
     const std::scoped_lock lock{m_parserGuard};
     return m_parser.parse(sort);
 }
+
+const ParsedScript& TrackSorter::parseScript(const ParsedScript& sort)
+{
+    return sort;
+}
+
+std::vector<QString> TrackSorter::calcSortKeys(const ParsedScript& sortScript, size_t count,
+                                               const std::function<const Track&(size_t)>& trackAt)
+{
+    std::vector<QString> keys(count);
+
+    std::vector<Chunk> chunks = splitIntoChunks(static_cast<int>(count));
+
+    if(chunks.size() <= 1) {
+        const std::scoped_lock lock{m_parserGuard};
+
+        const CompiledScript script = m_parser.compile(sortScript);
+        for(size_t i{0}; i < count; ++i) {
+            keys[i] = m_parser.evaluate(script, trackAt(i));
+        }
+
+        return keys;
+    }
+
+    QtConcurrent::blockingMap(chunks, [this, &sortScript, &trackAt, &keys](const Chunk& chunk) {
+        // Parsers hold evaluation state, so each chunk needs its own
+        ScriptParser parser{new ScriptRegistry(m_libraryManager)};
+        const CompiledScript script = parser.compile(sortScript);
+
+        for(int i{chunk.begin}; i < chunk.end; ++i) {
+            keys[i] = parser.evaluate(script, trackAt(i));
+        }
+    });
+
+    return keys;
+}
+
+std::vector<int> TrackSorter::sortIndexes(const std::vector<QString>& keys, Qt::SortOrder order)
+{
+    std::vector<int> indexes(keys.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+
+    const auto sortCompare = [&keys, order](const QCollator& collator) {
+        return [&keys, order, &collator](int lhs, int rhs) {
+            return sortLessThan(collator, keys[lhs], keys[rhs], order);
+        };
+    };
+
+    std::vector<Chunk> chunks = splitIntoChunks(static_cast<int>(keys.size()));
+
+    if(chunks.size() <= 1) {
+        const QCollator collator = sortCollator();
+        std::ranges::stable_sort(indexes, sortCompare(collator));
+        return indexes;
+    }
+
+    // QCollator isn't thread-safe, so every task uses its own
+    QtConcurrent::blockingMap(chunks, [&indexes, &sortCompare](const Chunk& chunk) {
+        const QCollator collator = sortCollator();
+        std::stable_sort(indexes.begin() + chunk.begin, indexes.begin() + chunk.end, sortCompare(collator));
+    });
+
+    // Merge on the calling thread: nesting another blockingMap here could starve callers which
+    // are themselves running on the global pool
+    const QCollator collator = sortCollator();
+    const auto compare       = sortCompare(collator);
+
+    while(chunks.size() > 1) {
+        std::vector<Chunk> mergedChunks;
+
+        for(size_t i{0}; i + 1 < chunks.size(); i += 2) {
+            std::inplace_merge(indexes.begin() + chunks[i].begin, indexes.begin() + chunks[i].end,
+                               indexes.begin() + chunks[i + 1].end, compare);
+            mergedChunks.push_back({.begin = chunks[i].begin, .end = chunks[i + 1].end});
+        }
+        if(chunks.size() % 2 != 0) {
+            mergedChunks.push_back(chunks.back());
+        }
+
+        chunks = std::move(mergedChunks);
+    }
+
+    return indexes;
+}
+
+void TrackSorter::applySortKey(Track& track, const QString& key)
+{
+    // Avoid detaching tracks whose key hasn't changed
+    if(track.sort() != key) {
+        track.setSort(key);
+    }
+}
 } // namespace Fooyin
@@ -22,15 +22,19 @@
 #include "internalcoresettings.h"
 #include "library/librarymanager.h"
 #include "librarythreadhandler.h"
+#include "stringpool.h"
 
 #include <core/coresettings.h>
 #include <core/library/libraryinfo.h>
+#include <core/library/librarytracks.h>
+#include <core/library/tracksearchindex.h>
 #include <core/library/tracksort.h>
 #include <utils/async.h>
 #include <utils/fileutils.h>
 #include <utils/settings/settingsmanager.h>
 
 #include <QDateTime>
+#include <QThreadPool>
 
 #include <ranges>
 
@@ -46,7 +50,6 @@ public:
 
     void loadTracks(const TrackList& trackToLoad);
     QFuture<void> addTracks(const TrackList& newTracks);
-    void updateLibraryTracks(const TrackList& updatedTracks);
     QFuture<void> updateTracksMetadata(const TrackList& tracksToUpdate);
     QFuture<void> updateTracks(const TrackList& tracksToUpdate);
 
@@ -59,10 +62,11 @@ public:
 
     void changeSort(const QString& sort);
     QFuture<TrackList> recalSortTracks(const QString& sort, const TrackList& tracks);
-    QFuture<TrackList> resortTracks(const TrackList& tracks);
 
     void handleTracksLoaded();
 
+    void updateSearchIndex(const std::function<void(TrackSearchIndex&)>& update);
+
     UnifiedMusicLibrary* m_self;
 
     LibraryManager* m_libraryManager;
@@ -72,7 +76,10 @@ public:
     LibraryThreadHandler m_threadHandler;
     TrackSorter m_sorter;
 
-    TrackList m_tracks;
+    LibraryTracks m_tracks;
+
+    std::shared_ptr<TrackSearchIndex> m_searchIndex;
+    QThreadPool m_searchIndexPool;
 };
 
 UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self, LibraryManager* libraryManager,
@@ -86,7 +93,11 @@ UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self
     , m_settings{settings}
     , m_threadHandler{m_dbPool, m_self, std::move(playlistLoader), std::move(audioLoader), m_settings}
     , m_sorter{m_libraryManager}
+    , m_searchIndex{std::make_shared<TrackSearchIndex>()}
 {
+    // Index updates must be applied in the order the library changed
+    m_searchIndexPool.setMaxThreadCount(1);
+
     m_settings->subscribe<Settings::Core::LibrarySortScript>(m_self, [this](const QString& sort) { changeSort(sort); });
     m_settings->subscribe<Settings::Core::Internal::MonitorLibraries>(
         m_self, [this](bool enabled) { m_threadHandler.setupWatchers(m_libraryManager->allLibraries(), enabled); });
@@ -102,8 +113,8 @@ void UnifiedMusicLibraryPrivate::loadTracks(const TrackList& trackToLoad)
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), trackToLoad);
 
     sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
-        emit m_self->tracksLoaded(m_tracks);
+        m_tracks.reset(sortedTracks);
+        emit m_self->tracksLoaded(m_tracks.tracks());
     });
 }
 
@@ -115,39 +126,18 @@ QFuture<void> UnifiedMusicLibraryPrivate::addTracks(const TrackList& newTracks)
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToAdd);
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        std::ranges::copy(sortedTracks, std::back_inserter(m_tracks));
-
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-
-            emit m_self->tracksAdded(sortedTracks);
-        });
+        m_tracks.insertTracks(sortedTracks);
+        emit m_self->tracksAdded(sortedTracks);
     });
 }
 
-void UnifiedMusicLibraryPrivate::updateLibraryTracks(const TrackList& updatedTracks)
-{
-    for(const auto& track : updatedTracks) {
-        auto trackIt
-            = std::ranges::find_if(m_tracks, [&track](const Track& oldTrack) { return oldTrack.id() == track.id(); });
-        if(trackIt != m_tracks.end()) {
-            *trackIt = track;
-            trackIt->clearWasModified();
-        }
-    }
-}
-
 QFuture<void> UnifiedMusicLibraryPrivate::updateTracksMetadata(const TrackList& tracksToUpdate)
 {
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToUpdate);
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        updateLibraryTracks(sortedTracks);
-
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksMetadataChanged(sortedTracks);
-        });
+        m_tracks.updateTracks(sortedTracks);
+        emit m_self->tracksMetadataChanged(sortedTracks);
     });
 }
 
@@ -156,12 +146,8 @@ QFuture<void> UnifiedMusicLibraryPrivate::updateTracks(const TrackList& tracksTo
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToUpdate);
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        updateLibraryTracks(sortedTracks);
-
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksUpdated(sortedTracks);
-        });
+        m_tracks.updateTracks(sortedTracks);
+        emit m_self->tracksUpdated(sortedTracks);
     });
 }
 
@@ -200,24 +186,31 @@ void UnifiedMusicLibraryPrivate::removeLibrary(const LibraryInfo& library, const
         return;
     }
 
-    TrackList newTracks;
     TrackList removedTracks;
     TrackList updatedTracks;
+    std::set<int> removedIds;
 
-    for(auto& track : m_tracks) {
+    for(const Track& track : m_tracks.tracks()) {
         if(track.libraryId() == library.id) {
             if(tracksRemoved.contains(track.id())) {
                 removedTracks.push_back(track);
+                removedIds.emplace(track.id());
                 continue;
             }
-            track.setLibraryId(-1);
             updatedTracks.push_back(track);
-            newTracks.push_back(track);
         }
-        newTracks.push_back(track);
     }
 
-    m_tracks = newTracks;
+    m_tracks.removeTracks(removedIds);
+    for(Track& track : updatedTracks) {
+        track.setLibraryId(-1);
+        if(Track* libraryTrack = m_tracks.track(track.id())) {
+            libraryTrack->setLibraryId(-1);
+        }
+    }
+
+    // Release the pooled metadata strings of the removed tracks
+    StringPool::instance().prune();
 
     emit m_self->tracksDeleted(removedTracks);
     emit m_self->tracksMetadataChanged(updatedTracks);
@@ -230,9 +223,9 @@ void UnifiedMusicLibraryPrivate::libraryStatusChanged(const LibraryInfo& library
 
 void UnifiedMusicLibraryPrivate::changeSort(const QString& sort)
 {
-    recalSortTracks(sort, m_tracks).then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
-        emit m_self->tracksSorted(m_tracks);
+    recalSortTracks(sort, m_tracks.tracks()).then(m_self, [this](const TrackList& sortedTracks) {
+        m_tracks.reset(sortedTracks);
+        emit m_self->tracksSorted(m_tracks.tracks());
     });
 }
 
@@ -241,11 +234,6 @@ QFuture<TrackList> UnifiedMusicLibraryPrivate::recalSortTracks(const QString& so
     return Utils::asyncExec([this, sort, tracks]() { return m_sorter.calcSortTracks(sort, tracks); });
 }
 
-QFuture<TrackList> UnifiedMusicLibraryPrivate::resortTracks(const TrackList& tracks)
-{
-    return Utils::asyncExec([tracks]() { return TrackSorter::sortTracks(tracks); });
-}
-
 void UnifiedMusicLibraryPrivate::handleTracksLoaded()
 {
     m_threadHandler.setupWatchers(m_libraryManager->allLibraries(),
@@ -255,6 +243,13 @@ void UnifiedMusicLibraryPrivate::handleTracksLoaded()
     }
 }
 
+void UnifiedMusicLibraryPrivate::updateSearchIndex(const std::function<void(TrackSearchIndex&)>& update)
+{
+    // Consumers of the same signals may search before this runs, but index matches are only used for tracks
+    // whose metadata is the same as was indexed, so stale entries fall back to matching the track itself
+    m_searchIndexPool.start([index = m_searchIndex, update]() { update(*index); });
+}
+
 UnifiedMusicLibrary::UnifiedMusicLibrary(LibraryManager* libraryManager, DbConnectionPoolPtr dbPool,
                                          std::shared_ptr<PlaylistLoader> playlistLoader,
                                          std::shared_ptr<AudioLoader> audioLoader, SettingsManager* settings,
@@ -291,6 +286,22 @@ UnifiedMusicLibrary::UnifiedMusicLibrary(LibraryManager* libraryManager, DbConne
 
     QObject::connect(
         this, &MusicLibrary::tracksLoaded, this, [this]() { p->handleTracksLoaded(); }, Qt::QueuedConnection);
+
+    QObject::connect(this, &MusicLibrary::tracksLoaded, this, [this](const TrackList& tracks) {
+        p->updateSearchIndex([tracks](TrackSearchIndex& index) { index.reset(tracks); });
+    });
+    QObject::connect(this, &MusicLibrary::tracksAdded, this, [this](const TrackList& tracks) {
+        p->updateSearchIndex([tracks](TrackSearchIndex& index) { index.addTracks(tracks); });
+    });
+    QObject::connect(this, &MusicLibrary::tracksMetadataChanged, this, [this](const TrackList& tracks) {
+        p->updateSearchIndex([tracks](TrackSearchIndex& index) { index.updateTracks(tracks); });
+    });
+    QObject::connect(this, &MusicLibrary::tracksUpdated, this, [this](const TrackList& tracks) {
+        p->updateSearchIndex([tracks](TrackSearchIndex& index) { index.updateTracks(tracks); });
+    });
+    QObject::connect(this, &MusicLibrary::tracksDeleted, this, [this](const TrackList& tracks) {
+        p->updateSearchIndex([tracks](TrackSearchIndex& index) { index.removeTracks(tracks); });
+    });
 }
 
 UnifiedMusicLibrary::~UnifiedMusicLibrary() = default;
@@ -374,14 +385,13 @@ ScanRequest UnifiedMusicLibrary::loadPlaylist(const QList<QUrl>& files)
 
 TrackList UnifiedMusicLibrary::tracks() const
 {
-    return p->m_tracks;
+    return p->m_tracks.tracks();
 }
 
 Track UnifiedMusicLibrary::trackForId(int id) const
 {
-    auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-    if(trackIt != p->m_tracks.cend()) {
-        return *trackIt;
+    if(const Track* track = p->m_tracks.track(id)) {
+        return *track;
     }
     return {};
 }
@@ -392,15 +402,19 @@ TrackList UnifiedMusicLibrary::tracksForIds(const TrackIds& ids) const
     tracks.reserve(ids.size());
 
     for(const int id : ids) {
-        auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-        if(trackIt != p->m_tracks.cend()) {
-            tracks.push_back(*trackIt);
+        if(const Track* track = p->m_tracks.track(id)) {
+            tracks.push_back(*track);
         }
     }
 
     return tracks;
 }
 
+std::shared_ptr<const TrackSearchIndex> UnifiedMusicLibrary::searchIndex() const
+{
+    return p->m_searchIndex;
+}
+
 void UnifiedMusicLibrary::updateTrack(const Track& track)
 {
     updateTracks({track});
@@ -443,9 +457,9 @@ void UnifiedMusicLibrary::trackWasPlayed(const Track& track)
     const int playCount = track.playCount() + 1;
 
     TrackList tracksToUpdate;
-    for(const auto& libraryTrack : p->m_tracks) {
-        if(libraryTrack.hash() == hash) {
-            Track sameHashTrack{libraryTrack};
+    for(const int id : p->m_tracks.idsForHash(hash)) {
+        if(const Track* libraryTrack = p->m_tracks.track(id)) {
+            Track sameHashTrack{*libraryTrack};
             sameHashTrack.setFirstPlayed(currTime);
             sameHashTrack.setLastPlayed(currTime);
             sameHashTrack.setPlayCount(playCount);
@@ -24,11 +24,13 @@
 #include <core/scripting/scriptparser.h>
 #include <core/track.h>
 #include <utils/crypto.h>
+#include <utils/helpers.h>
 #include <utils/settings/settingsmanager.h>
 
 #include <random>
 #include <ranges>
-#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace {
 using AlbumTracks = std::vector<int>;
@@ -132,6 +134,8 @@ public:
     int getNextIndex(int delta, Playlist::PlayModes mode, bool onlyCheck);
     [[nodiscard]] std::optional<Track> getTrack(int index) const;
 
+    void updateQueryInfo();
+
     UId m_id;
     int m_dbId{-1};
     QString m_name;
@@ -158,6 +162,8 @@ public:
 
     bool m_isAutoPlaylist{false};
     QString m_query;
+    bool m_isIncrementalQuery{false};
+    Qt::SortOrder m_querySortOrder{Qt::AscendingOrder};
 };
 
 PlaylistPrivate::PlaylistPrivate(int dbId, QString name, int index, SettingsManager* settings)
@@ -473,6 +479,21 @@ std::optional<Track> PlaylistPrivate::getTrack(int index) const
     return m_tracks.at(index);
 }
 
+void PlaylistPrivate::updateQueryInfo()
+{
+    m_isIncrementalQuery = ScriptParser::isIncrementalQuery(m_query);
+    m_querySortOrder     = Qt::AscendingOrder;
+
+    // Only the first SORT BY in a query is used
+    const ParsedScript script = m_parser.parseQuery(m_query);
+    const auto sortIt         = std::ranges::find_if(script.expressions, [](const Expression& expr) {
+        return expr.type == Expr::SortAscending || expr.type == Expr::SortDescending;
+    });
+    if(sortIt != script.expressions.cend() && sortIt->type == Expr::SortDescending) {
+        m_querySortOrder = Qt::DescendingOrder;
+    }
+}
+
 Playlist::Playlist(PrivateKey /*key*/, int dbId, QString name, int index, SettingsManager* settings)
     : p{std::make_unique<PlaylistPrivate>(dbId, std::move(name), index, settings)}
 { }
@@ -592,6 +613,83 @@ bool Playlist::regenerateTracks(const TrackList& tracks)
     return false;
 }
 
+bool Playlist::supportsIncrementalUpdate() const
+{
+    return isAutoPlaylist() && p->m_isIncrementalQuery;
+}
+
+std::optional<bool> Playlist::updateAutoTracks(const TrackList& changedTracks, const TrackList& removedTracks)
+{
+    if(!supportsIncrementalUpdate()) {
+        return {};
+    }
+    if(changedTracks.empty() && removedTracks.empty()) {
+        return false;
+    }
+
+    std::unordered_set<int> removedIds;
+    for(const Track& track : removedTracks) {
+        removedIds.emplace(track.id());
+    }
+
+    // In case current date in previous query is cached
+    p->m_parser.clearCache();
+    TrackList matches = p->m_parser.filter(p->m_query, changedTracks);
+    std::erase_if(matches, [&removedIds](const Track& track) { return removedIds.contains(track.id()); });
+    // Matches hold the sort fields of the query if it uses SORT BY, otherwise those of the library
+    matches = TrackSorter::sortTracks(matches, p->m_querySortOrder);
+
+    std::unordered_map<int, const Track*> matchedTracks;
+    for(const Track& track : matches) {
+        matchedTracks.emplace(track.id(), &track);
+    }
+
+    std::unordered_set<int> staleIds{removedIds};
+    for(const Track& track : changedTracks) {
+        staleIds.emplace(track.id());
+    }
+
+    TrackList tracks;
+    tracks.reserve(p->m_tracks.size() + matches.size());
+    std::unordered_set<int> updatedIds;
+
+    for(const Track& track : p->m_tracks) {
+        if(!staleIds.contains(track.id())) {
+            tracks.push_back(track);
+            continue;
+        }
+        // Changed tracks which still match keep their position unless their sort fields have changed
+        const auto matchIt = matchedTracks.find(track.id());
+        if(matchIt != matchedTracks.cend() && matchIt->second->sort() == track.sort()) {
+            tracks.push_back(*matchIt->second);
+            updatedIds.emplace(track.id());
+        }
+    }
+
+    TrackList newTracks;
+    std::ranges::copy_if(matches, std::back_inserter(newTracks),
+                         [&updatedIds](const Track& track) { return !updatedIds.contains(track.id()); });
+    TrackSorter::insertSortedTracks(tracks, newTracks, p->m_querySortOrder);
+
+    // A full query keeps tracks with equal sort fields in library order, which isn't known here
+    std::vector<size_t> matchedIndexes;
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        if(matchedTracks.contains(tracks[i].id())) {
+            matchedIndexes.push_back(i);
+        }
+    }
+    if(TrackSorter::hasSortTies(tracks, matchedIndexes)) {
+        return {};
+    }
+
+    if(tracks == p->m_tracks) {
+        return false;
+    }
+
+    replaceTracks(tracks);
+    return true;
+}
+
 void Playlist::scheduleNextIndex(int index)
 {
     if(index >= 0 && index < trackCount()) {
@@ -697,6 +795,7 @@ void Playlist::setQuery(const QString& query)
     if(std::exchange(p->m_query, query) != query) {
         p->m_modified = true;
     }
+    p->updateQueryInfo();
 }
 
 void Playlist::setModified(bool modified)
@@ -744,51 +843,48 @@ void Playlist::updateTrackAtIndex(int index, const Track& track)
 
 std::vector<int> Playlist::removeTracks(const std::vector<int>& indexes)
 {
-    const auto updateAlbumShuffleOrder = [this](int removedIndex) {
-        for(auto& album : p->m_albumShuffleOrder) {
-            std::erase_if(album, [removedIndex](int trackIndex) { return trackIndex == removedIndex; });
-            std::ranges::transform(album, album.begin(), [removedIndex](int trackIndex) {
-                return trackIndex > removedIndex ? trackIndex - 1 : trackIndex;
-            });
-            if(album.empty()) {
-                std::erase_if(p->m_albumShuffleOrder, [&album](const auto& a) { return a == album; });
-            }
-        }
+    // Maps each current index to its index after removal, or -1 if removed
+    const std::vector<int> indexMap = Utils::removalIndexMap(p->m_tracks.size(), indexes);
+    const auto newIndex             = [&indexMap](int index) {
+        return index >= 0 && std::cmp_less(index, indexMap.size()) ? indexMap[index] : -1;
     };
 
     std::vector<int> removedIndexes;
-    std::set<int> indexesToRemove{indexes.cbegin(), indexes.cend()};
-
-    auto prevHistory = p->m_trackShuffleOrder | std::views::take(p->m_trackShuffleIndex + 1);
-    for(const int index : prevHistory) {
-        if(indexesToRemove.contains(index)) {
-            p->m_trackShuffleIndex -= 1;
+    for(int index{static_cast<int>(indexMap.size()) - 1}; index >= 0; --index) {
+        if(indexMap[index] < 0) {
+            removedIndexes.emplace_back(index);
         }
     }
 
-    int adjustedTrackIndex = currentTrackIndex();
+    if(removedIndexes.empty()) {
+        return {};
+    }
 
-    for(const int index : indexesToRemove | std::views::reverse) {
-        if(index <= currentTrackIndex()) {
-            adjustedTrackIndex = std::max(adjustedTrackIndex - 1, 0);
-        }
+    Utils::removeByIndexMap(p->m_tracks, indexMap);
 
-        if(index >= 0 && std::cmp_less(index, p->m_tracks.size())) {
-            p->m_tracks.erase(p->m_tracks.begin() + index);
-            removedIndexes.emplace_back(index);
+    const auto prevHistory = p->m_trackShuffleOrder | std::views::take(p->m_trackShuffleIndex + 1);
+    p->m_trackShuffleIndex
+        -= static_cast<int>(std::ranges::count_if(prevHistory, [&newIndex](int index) { return newIndex(index) < 0; }));
 
-            std::erase_if(p->m_trackShuffleOrder, [index](int num) { return num == index; });
-            std::ranges::transform(p->m_trackShuffleOrder, p->m_trackShuffleOrder.begin(),
-                                   [index](int num) { return num > index ? num - 1 : num; });
+    std::ranges::transform(p->m_trackShuffleOrder, p->m_trackShuffleOrder.begin(), newIndex);
+    std::erase(p->m_trackShuffleOrder, -1);
 
-            updateAlbumShuffleOrder(index);
-        }
+    for(auto& album : p->m_albumShuffleOrder) {
+        std::ranges::transform(album, album.begin(), newIndex);
+        std::erase(album, -1);
     }
+    std::erase_if(p->m_albumShuffleOrder, [](const AlbumTracks& album) { return album.empty(); });
 
-    std::erase_if(p->m_trackShuffleOrder, [](int num) { return num < 0; });
-    changeCurrentIndex(adjustedTrackIndex);
-    if(indexesToRemove.contains(p->m_nextTrackIndex)) {
-        p->m_nextTrackIndex = -1;
+    const int currentIndex = currentTrackIndex();
+    if(currentIndex >= 0) {
+        // The current index moves back by the number of tracks removed up to and including it
+        const auto removedBefore = std::ranges::count_if(removedIndexes, [currentIndex](int index) {
+            return index <= currentIndex;
+        });
+        changeCurrentIndex(std::max(currentIndex - static_cast<int>(removedBefore), 0));
+    }
+    if(p->m_nextTrackIndex >= 0) {
+        p->m_nextTrackIndex = newIndex(p->m_nextTrackIndex);
     }
 
     p->m_tracksModified = true;
@@ -51,6 +51,7 @@ public:
     void reloadPlaylists();
     void populatePlaylists();
     void regenerateAutoPlaylists();
+    void updateAutoPlaylists(const TrackList& changedTracks, const TrackList& removedTracks);
     bool noConcretePlaylists();
 
     void handleTracksChanged(const TrackList& tracks);
@@ -154,6 +155,33 @@ void PlaylistHandlerPrivate::regenerateAutoPlaylists()
     }
 }
 
+void PlaylistHandlerPrivate::updateAutoPlaylists(const TrackList& changedTracks, const TrackList& removedTracks)
+{
+    // Only fetched if a playlist can't be updated from the changed tracks alone
+    std::optional<TrackList> libraryTracks;
+
+    for(auto& playlist : m_playlists) {
+        if(!playlist->isAutoPlaylist()) {
+            continue;
+        }
+
+        std::optional<bool> changed;
+        if(playlist->supportsIncrementalUpdate()) {
+            changed = playlist->updateAutoTracks(changedTracks, removedTracks);
+        }
+        if(!changed) {
+            if(!libraryTracks) {
+                libraryTracks = m_library->tracks();
+            }
+            changed = playlist->regenerateTracks(libraryTracks.value());
+        }
+
+        if(changed.value()) {
+            emit m_self->tracksChanged(playlist.get(), {});
+        }
+    }
+}
+
 bool PlaylistHandlerPrivate::noConcretePlaylists()
 {
     return m_playlists.empty()
@@ -446,15 +474,20 @@ PlaylistHandler::PlaylistHandler(DbConnectionPoolPtr dbPool, std::shared_ptr<Aud
     }
 
     QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, [this]() { p->populatePlaylists(); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, [this]() { p->regenerateAutoPlaylists(); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, [this]() { p->regenerateAutoPlaylists(); });
+    QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this, [this]() { p->regenerateAutoPlaylists(); });
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this,
+                     [this](const TrackList& tracks) { p->updateAutoPlaylists(tracks, {}); });
+    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, [this](const TrackList& tracks) {
+        p->m_playlistConnector.invalidateStoredTracks();
+        p->updateAutoPlaylists({}, tracks);
+    });
     QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, [this](const TrackList& tracks) {
         p->handleTracksChanged(tracks);
-        p->regenerateAutoPlaylists();
+        p->updateAutoPlaylists(tracks, {});
     });
     QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, [this](const TrackList& tracks) {
         p->handleTracksUpdated(tracks);
-        p->regenerateAutoPlaylists();
+        p->updateAutoPlaylists(tracks, {});
     });
 
     p->m_settings->subscribe<Settings::Core::ShuffleAlbumsGroupScript>(this, [this]() { p->resetShuffleOrder(); });
@@ -22,6 +22,7 @@
 #include "scriptcache.h"
 
 #include <core/constants.h>
+#include <core/library/tracksearchindex.h>
 #include <core/library/tracksort.h>
 #include <core/scripting/scriptscanner.h>
 #include <core/track.h>
@@ -30,9 +31,19 @@
 
 #include <QDateTime>
 #include <QDebug>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <numeric>
 
 using TokenType = Fooyin::ScriptScanner::TokenType;
 
+// Number of tracks filtered between checks for cancellation
+constexpr auto CancelCheckInterval = 1024;
+// Track lists smaller than this are filtered on the calling thread
+constexpr auto ParallelFilterThreshold = 16384;
+constexpr size_t MinFilterChunkSize    = 4096;
+
 namespace {
 QDateTime evalDate(const Fooyin::Expression& expr)
 {
@@ -124,6 +135,78 @@ bool matchSearch(const Fooyin::Track& track, const QString& search, bool singleS
     return std::ranges::all_of(terms, [&track](const QString& term) { return track.hasMatch(term); });
 }
 
+// Returns the terms of a simple search query, or std::nullopt if it isn't one
+std::optional<QStringList> searchTerms(const Fooyin::ParsedScript& script)
+{
+    if(!script.isValid() || script.expressions.size() != 1) {
+        return {};
+    }
+
+    const auto& expr = script.expressions.front();
+    if(expr.type == Fooyin::Expr::QuotedLiteral) {
+        return QStringList{std::get<QString>(expr.value)};
+    }
+    if(expr.type == Fooyin::Expr::Literal) {
+        return std::get<QString>(expr.value).split(u' ', Qt::SkipEmptyParts);
+    }
+
+    return {};
+}
+
+const QString& exprValue(const Fooyin::Expression& expr)
+{
+    return std::get<QString>(expr.value);
+}
+
+const QString& exprValue(const Fooyin::CompiledExpression& expr)
+{
+    return expr.value;
+}
+
+int64_t exprNumber(const Fooyin::Expression& expr)
+{
+    return std::get<QString>(expr.value).toLongLong();
+}
+
+int64_t exprNumber(const Fooyin::CompiledExpression& expr)
+{
+    return expr.number;
+}
+
+const Fooyin::ExpressionList& exprArgs(const Fooyin::Expression& expr)
+{
+    return std::get<Fooyin::ExpressionList>(expr.value);
+}
+
+const Fooyin::CompiledExpressionList& exprArgs(const Fooyin::CompiledExpression& expr)
+{
+    return expr.args;
+}
+
+bool hasArgs(const Fooyin::Expression& expr)
+{
+    return std::holds_alternative<Fooyin::ExpressionList>(expr.value);
+}
+
+bool hasArgs(const Fooyin::CompiledExpression& /*expr*/)
+{
+    return true;
+}
+
+// LIMIT and SORT BY change the state of the parser when evaluated
+template <typename ExpressionType>
+bool containsQueryOption(const ExpressionType& expr)
+{
+    using Type = Fooyin::Expr::Type;
+    if(expr.type == Type::Limit || expr.type == Type::SortAscending || expr.type == Type::SortDescending) {
+        return true;
+    }
+    if(!hasArgs(expr)) {
+        return false;
+    }
+    return std::ranges::any_of(exprArgs(expr), [](const auto& arg) { return containsQueryOption(arg); });
+}
+
 bool isQueryExpression(Fooyin::Expr::Type type)
 {
     using Type = Fooyin::Expr::Type;
@@ -200,37 +283,41 @@ public:
     Expression sort();
     Expression limit();
 
-    ScriptResult evalExpression(const Expression& exp, const auto& tracks);
-    ScriptResult evalLiteral(const Expression& exp);
-    ScriptResult evalVariable(const Expression& exp, const auto& tracks);
-    ScriptResult evalVariableList(const Expression& exp, const auto& tracks);
-    ScriptResult evalVariableRaw(const Expression& exp, const auto& tracks);
-    ScriptResult evalFunction(const Expression& exp, const auto& tracks);
-    ScriptResult evalFunctionArg(const Expression& exp, const auto& tracks);
-    ScriptResult evalConditional(const Expression& exp, const auto& tracks);
-    ScriptResult evalNot(const Expression& exp, const auto& tracks);
-    ScriptResult evalGroup(const Expression& exp, const auto& tracks);
-    ScriptResult evalAnd(const Expression& exp, const auto& tracks);
-    ScriptResult evalOr(const Expression& exp, const auto& tracks);
-    ScriptResult evalXOr(const Expression& exp, const auto& tracks);
-    ScriptResult evalMissing(const Expression& exp, const auto& tracks);
-    ScriptResult evalPresent(const Expression& exp, const auto& tracks);
-    ScriptResult evalEquals(const Expression& exp, const auto& tracks);
-    ScriptResult evalContains(const Expression& exp, const auto& tracks);
-    ScriptResult evalContains(const Expression& exp, const Track& track);
-    ScriptResult evalLimit(const Expression& exp);
-    ScriptResult evalSort(const Expression& exp);
+    ScriptResult evalExpression(const auto& exp, const auto& tracks);
+    ScriptResult evalLiteral(const auto& exp);
+    ScriptResult evalVariable(const auto& exp, const auto& tracks);
+    ScriptResult evalVariableList(const auto& exp, const auto& tracks);
+    ScriptResult evalVariableRaw(const auto& exp, const auto& tracks);
+    ScriptResult evalFunction(const auto& exp, const auto& tracks);
+    ScriptResult evalFunctionArg(const auto& exp, const auto& tracks);
+    ScriptResult evalConditional(const auto& exp, const auto& tracks);
+    ScriptResult evalNot(const auto& exp, const auto& tracks);
+    ScriptResult evalGroup(const auto& exp, const auto& tracks);
+    ScriptResult evalAnd(const auto& exp, const auto& tracks);
+    ScriptResult evalOr(const auto& exp, const auto& tracks);
+    ScriptResult evalXOr(const auto& exp, const auto& tracks);
+    ScriptResult evalMissing(const auto& exp, const auto& tracks);
+    ScriptResult evalPresent(const auto& exp, const auto& tracks);
+    ScriptResult evalEquals(const auto& exp, const auto& tracks);
+    ScriptResult evalContains(const auto& exp, const auto& tracks);
+    ScriptResult evalContains(const auto& exp, const Track& track);
+    ScriptResult evalLimit(const auto& exp);
+    ScriptResult evalSort(const auto& exp);
+    ScriptResult variableValue(const auto& exp, const auto& tracks) const;
 
     ParsedScript parse(const QString& input);
     ParsedScript parseQuery(const QString& input);
-    QString evaluate(const ParsedScript& input, const auto& tracks);
+    QString evaluate(const auto& input, const auto& tracks);
+
+    CompiledExpression compileExpression(const Expression& expr) const;
+    CompiledScript compile(const ParsedScript& input) const;
 
-    template <typename TrackListType>
-    TrackListType evaluateQuery(const ParsedScript& input, const TrackListType& tracks);
+    template <typename ScriptType, typename TrackListType>
+    TrackListType evaluateQuery(const ScriptType& input, const TrackListType& tracks);
 
-    ScriptResult compareValues(const Expression& exp, const auto& tracks, const auto& comparator);
-    ScriptResult compareDates(const Expression& exp, const auto& tracks, const auto& comparator);
-    ScriptResult compareDateRange(const Expression& exp, const auto& tracks);
+    ScriptResult compareValues(const auto& exp, const auto& tracks, const auto& comparator);
+    ScriptResult compareDates(const auto& exp, const auto& tracks, const auto& comparator);
+    ScriptResult compareDateRange(const auto& exp, const auto& tracks);
     Expression checkOperator(const Expression& expr);
 
     void reset();
@@ -239,6 +326,8 @@ public:
 
     ScriptScanner m_scanner;
     std::unique_ptr<ScriptRegistry> m_registry;
+    std::shared_ptr<const TrackSearchIndex> m_searchIndex;
+    std::function<bool()> m_isCancelled;
 
     ScriptScanner::Token m_current;
     ScriptScanner::Token m_previous;
@@ -807,7 +896,7 @@ Expression ScriptParserPrivate::limit()
     return expr;
 }
 
-ScriptResult ScriptParserPrivate::evalExpression(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalExpression(const auto& exp, const auto& tracks)
 {
     switch(exp.type) {
         case(Expr::Literal):
@@ -872,18 +961,17 @@ ScriptResult ScriptParserPrivate::evalExpression(const Expression& exp, const au
     }
 }
 
-ScriptResult ScriptParserPrivate::evalLiteral(const Expression& exp)
+ScriptResult ScriptParserPrivate::evalLiteral(const auto& exp)
 {
     ScriptResult result;
-    result.value = std::get<QString>(exp.value);
+    result.value = exprValue(exp);
     result.cond  = true;
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalVariable(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalVariable(const auto& exp, const auto& tracks)
 {
-    const QString var   = std::get<QString>(exp.value);
-    ScriptResult result = m_registry->value(var.toLower(), tracks);
+    ScriptResult result = variableValue(exp, tracks);
 
     if(!result.cond) {
         return {};
@@ -896,15 +984,14 @@ ScriptResult ScriptParserPrivate::evalVariable(const Expression& exp, const auto
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalVariableList(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalVariableList(const auto& exp, const auto& tracks)
 {
-    const QString var = std::get<QString>(exp.value);
-    return m_registry->value(var.toLower(), tracks);
+    return variableValue(exp, tracks);
 }
 
-ScriptResult ScriptParserPrivate::evalVariableRaw(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalVariableRaw(const auto& exp, const auto& tracks)
 {
-    const QString var = std::get<QString>(exp.value);
+    const QString& var = exprValue(exp);
 
     ScriptResult result;
     if constexpr(std::is_same_v<std::decay_t<decltype(tracks)>, Track>) {
@@ -926,22 +1013,35 @@ ScriptResult ScriptParserPrivate::evalVariableRaw(const Expression& exp, const a
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalFunction(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalFunction(const auto& exp, const auto& tracks)
 {
-    auto func = std::get<FuncValue>(exp.value);
-    ScriptValueList args;
-    std::ranges::transform(func.args, std::back_inserter(args),
-                           [this, &tracks](const Expression& arg) { return evalExpression(arg, tracks); });
-    return m_registry->function(func.name, args, tracks);
+    const auto evalArgs = [this, &tracks](const auto& funcArgs) {
+        ScriptValueList args;
+        args.reserve(funcArgs.size());
+        std::ranges::transform(funcArgs, std::back_inserter(args),
+                               [this, &tracks](const auto& arg) { return evalExpression(arg, tracks); });
+        return args;
+    };
+
+    if constexpr(std::is_same_v<std::decay_t<decltype(exp)>, CompiledExpression>) {
+        if(!exp.function) {
+            return {};
+        }
+        return exp.function(evalArgs(exp.args), tracks);
+    }
+    else {
+        const auto& func = std::get<FuncValue>(exp.value);
+        return m_registry->function(func.name, evalArgs(func.args), tracks);
+    }
 }
 
-ScriptResult ScriptParserPrivate::evalFunctionArg(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalFunctionArg(const auto& exp, const auto& tracks)
 {
     ScriptResult result;
     bool allPassed{true};
 
-    auto arg = std::get<ExpressionList>(exp.value);
-    for(const Expression& subArg : arg) {
+    const auto& arg = exprArgs(exp);
+    for(const auto& subArg : arg) {
         const auto subExpr = evalExpression(subArg, tracks);
         if(!subExpr.cond) {
             allPassed = false;
@@ -961,14 +1061,14 @@ ScriptResult ScriptParserPrivate::evalFunctionArg(const Expression& exp, const a
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalConditional(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalConditional(const auto& exp, const auto& tracks)
 {
     ScriptResult result;
     QStringList exprResult;
     result.cond = true;
 
-    auto arg = std::get<ExpressionList>(exp.value);
-    for(const Expression& subArg : arg) {
+    const auto& arg = exprArgs(exp);
+    for(const auto& subArg : arg) {
         const auto subExpr = evalExpression(subArg, tracks);
 
         // Literals return false
@@ -1005,14 +1105,14 @@ ScriptResult ScriptParserPrivate::evalConditional(const Expression& exp, const a
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalNot(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalNot(const auto& exp, const auto& tracks)
 {
-    auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
 
     ScriptResult result;
     result.cond = true;
 
-    for(const Expression& arg : args) {
+    for(const auto& arg : args) {
         const auto subExpr = evalExpression(arg, tracks);
         result.cond        = !subExpr.cond;
         return result;
@@ -1021,14 +1121,14 @@ ScriptResult ScriptParserPrivate::evalNot(const Expression& exp, const auto& tra
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalGroup(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalGroup(const auto& exp, const auto& tracks)
 {
-    auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
 
     ScriptResult result;
     result.cond = true;
 
-    for(const Expression& arg : args) {
+    for(const auto& arg : args) {
         const auto subExpr = evalExpression(arg, tracks);
         if(!subExpr.cond) {
             result.cond = false;
@@ -1039,9 +1139,9 @@ ScriptResult ScriptParserPrivate::evalGroup(const Expression& exp, const auto& t
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalAnd(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalAnd(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1058,9 +1158,9 @@ ScriptResult ScriptParserPrivate::evalAnd(const Expression& exp, const auto& tra
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalOr(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalOr(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1073,9 +1173,9 @@ ScriptResult ScriptParserPrivate::evalOr(const Expression& exp, const auto& trac
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalXOr(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalXOr(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1088,34 +1188,31 @@ ScriptResult ScriptParserPrivate::evalXOr(const Expression& exp, const auto& tra
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalMissing(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalMissing(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() != 1) {
         return {};
     }
 
-    const Expression meta{Expr::VariableRaw, args.front().value};
-    ScriptResult result = evalExpression(meta, tracks);
+    ScriptResult result = evalVariableRaw(args.front(), tracks);
     result.cond         = !result.cond;
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalPresent(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalPresent(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() != 1) {
         return {};
     }
 
-    const Expression meta{Expr::VariableRaw, args.front().value};
-    ScriptResult result = evalExpression(meta, tracks);
-    return result;
+    return evalVariableRaw(args.front(), tracks);
 }
 
-ScriptResult ScriptParserPrivate::evalEquals(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalEquals(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1138,9 +1235,9 @@ ScriptResult ScriptParserPrivate::evalEquals(const Expression& exp, const auto&
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalContains(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::evalContains(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1161,15 +1258,15 @@ ScriptResult ScriptParserPrivate::evalContains(const Expression& exp, const auto
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalContains(const Expression& exp, const Track& track)
+ScriptResult ScriptParserPrivate::evalContains(const auto& exp, const Track& track)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
 
-    const Expression& field = args.at(0);
-    const Expression& value = args.at(1);
+    const auto& field = args.at(0);
+    const auto& value = args.at(1);
 
     const ScriptResult first = evalExpression(field, track);
     if(!first.cond) {
@@ -1193,7 +1290,7 @@ ScriptResult ScriptParserPrivate::evalContains(const Expression& exp, const Trac
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalLimit(const Expression& exp)
+ScriptResult ScriptParserPrivate::evalLimit(const auto& exp)
 {
     ScriptResult result;
     result.cond = true;
@@ -1202,13 +1299,12 @@ ScriptResult ScriptParserPrivate::evalLimit(const Expression& exp)
         return result;
     }
 
-    const QString limit = std::get<QString>(exp.value);
-    m_limit             = limit.toInt();
+    m_limit = exprValue(exp).toInt();
 
     return result;
 }
 
-ScriptResult ScriptParserPrivate::evalSort(const Expression& exp)
+ScriptResult ScriptParserPrivate::evalSort(const auto& exp)
 {
     ScriptResult result;
     result.cond = true;
@@ -1217,7 +1313,7 @@ ScriptResult ScriptParserPrivate::evalSort(const Expression& exp)
         return result;
     }
 
-    m_sortScript = std::get<QString>(exp.value);
+    m_sortScript = exprValue(exp);
     m_sortOrder  = exp.type == Expr::SortAscending ? Qt::AscendingOrder : Qt::DescendingOrder;
 
     return result;
@@ -1296,7 +1392,7 @@ ParsedScript ScriptParserPrivate::parseQuery(const QString& input)
     return m_currentScript;
 }
 
-QString ScriptParserPrivate::evaluate(const ParsedScript& input, const auto& tracks)
+QString ScriptParserPrivate::evaluate(const auto& input, const auto& tracks)
 {
     if(!input.isValid() || !m_registry) {
         return {};
@@ -1304,8 +1400,7 @@ QString ScriptParserPrivate::evaluate(const ParsedScript& input, const auto& tra
 
     reset();
 
-    const ExpressionList expressions = input.expressions;
-    for(const auto& expr : expressions) {
+    for(const auto& expr : input.expressions) {
         const auto evalExpr = evalExpression(expr, tracks);
 
         if(evalExpr.value.isNull()) {
@@ -1342,8 +1437,63 @@ QString ScriptParserPrivate::evaluate(const ParsedScript& input, const auto& tra
     return {};
 }
 
-template <typename TrackListType>
-TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, const TrackListType& tracks)
+CompiledExpression ScriptParserPrivate::compileExpression(const Expression& expr) const
+{
+    CompiledExpression compiled;
+    compiled.type = expr.type;
+
+    if(const auto* value = std::get_if<QString>(&expr.value)) {
+        compiled.value = *value;
+    }
+    else if(const auto* func = std::get_if<FuncValue>(&expr.value)) {
+        compiled.value    = func->name;
+        compiled.function = m_registry->bindFunction(func->name);
+        compiled.args.reserve(func->args.size());
+        for(const Expression& arg : func->args) {
+            compiled.args.emplace_back(compileExpression(arg));
+        }
+    }
+    else if(const auto* args = std::get_if<ExpressionList>(&expr.value)) {
+        compiled.args.reserve(args->size());
+        for(const Expression& arg : *args) {
+            compiled.args.emplace_back(compileExpression(arg));
+        }
+    }
+
+    switch(expr.type) {
+        case(Expr::Variable):
+        case(Expr::VariableList):
+            compiled.variable = m_registry->bindVariable(compiled.value.toLower());
+            break;
+        case(Expr::Date):
+            compiled.number = compiled.value.toLongLong();
+            break;
+        default:
+            break;
+    }
+
+    return compiled;
+}
+
+CompiledScript ScriptParserPrivate::compile(const ParsedScript& input) const
+{
+    if(!input.isValid() || !m_registry) {
+        return {};
+    }
+
+    CompiledScript script;
+    script.input = input.input;
+    script.expressions.reserve(input.expressions.size());
+
+    for(const Expression& expr : input.expressions) {
+        script.expressions.emplace_back(compileExpression(expr));
+    }
+
+    return script;
+}
+
+template <typename ScriptType, typename TrackListType>
+TrackListType ScriptParserPrivate::evaluateQuery(const ScriptType& input, const TrackListType& tracks)
 {
     if(!input.isValid() || !m_registry) {
         return {};
@@ -1356,39 +1506,149 @@ TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, cons
         const auto& firstExpr = input.expressions.front();
         if(firstExpr.type == Expr::Literal || firstExpr.type == Expr::QuotedLiteral) {
             // Simple search query - just match all terms in metadata/filepath
-            const QString search = std::get<QString>(firstExpr.value);
-            return Utils::filter(tracks, [&search, &firstExpr](const auto& track) {
-                if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
-                    return matchSearch(track.track, search, firstExpr.type == Expr::QuotedLiteral);
+            const QString& search   = exprValue(firstExpr);
+            const bool singleString = firstExpr.type == Expr::QuotedLiteral;
+
+            std::optional<TrackSearchMatches> indexMatches;
+            if(m_searchIndex) {
+                indexMatches = m_searchIndex->search(search, singleString);
+            }
+
+            for(size_t i{0}; i < tracks.size(); ++i) {
+                if(i % CancelCheckInterval == 0 && m_isCancelled && m_isCancelled()) {
+                    return {};
+                }
+
+                const auto& track        = tracks.at(i);
+                const Track& searchTrack = [&track]() -> const Track& {
+                    if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
+                        return track.track;
+                    }
+                    else {
+                        return track;
+                    }
+                }();
+
+                bool matched{false};
+                if(indexMatches) {
+                    if(const auto indexMatched = indexMatches->matches(searchTrack)) {
+                        matched = indexMatched.value();
+                    }
+                    else {
+                        matched = matchSearch(searchTrack, search, singleString);
+                    }
                 }
                 else {
-                    return matchSearch(track, search, firstExpr.type == Expr::QuotedLiteral);
+                    matched = matchSearch(searchTrack, search, singleString);
                 }
-            });
+
+                if(matched) {
+                    filteredTracks.emplace_back(track);
+                }
+            }
+
+            return filteredTracks;
         }
         if(!isQueryExpression(firstExpr.type)) {
             return {};
         }
     }
 
-    int count{0};
-    for(const auto& track : tracks) {
-        if(m_limit > 0 && count >= m_limit) {
-            break;
+    // Top-level LIMIT and SORT BY only configure the query, so they're applied before filtering.
+    // The remaining predicates don't modify the parser, so they can be evaluated on several threads at once.
+    using ExpressionType = std::decay_t<decltype(input.expressions.front())>;
+    std::vector<const ExpressionType*> predicates;
+    bool hasNestedOptions{false};
+
+    for(const auto& expr : input.expressions) {
+        if(expr.type == Expr::Limit) {
+            evalLimit(expr);
+        }
+        else if(expr.type == Expr::SortAscending || expr.type == Expr::SortDescending) {
+            evalSort(expr);
+        }
+        else {
+            hasNestedOptions = hasNestedOptions || containsQueryOption(expr);
+            predicates.push_back(&expr);
         }
+    }
 
-        const bool matches = std::ranges::all_of(input.expressions, [&](const auto& expr) {
+    const auto matches = [this, &predicates](const auto& track) {
+        return std::ranges::all_of(predicates, [this, &track](const ExpressionType* expr) {
             if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
-                return evalExpression(expr, track.track).cond;
+                return evalExpression(*expr, track.track).cond;
             }
             else {
-                return evalExpression(expr, track).cond;
+                return evalExpression(*expr, track).cond;
             }
         });
+    };
+
+    const int limit = m_limit;
 
-        if(matches) {
-            filteredTracks.emplace_back(track);
-            ++count;
+    // Returns the first @p limit matches of the tracks in [first, last), or std::nullopt if cancelled
+    const auto filterRange = [this, &tracks, &matches, limit](size_t first, size_t last) {
+        std::optional<TrackListType> result{std::in_place};
+
+        for(size_t i{first}; i < last; ++i) {
+            if(limit > 0 && std::cmp_greater_equal(result->size(), limit)) {
+                break;
+            }
+            if((i - first) % CancelCheckInterval == 0 && m_isCancelled && m_isCancelled()) {
+                return std::optional<TrackListType>{};
+            }
+            if(matches(tracks.at(i))) {
+                result->emplace_back(tracks.at(i));
+            }
+        }
+
+        return result;
+    };
+
+    const size_t trackCount  = tracks.size();
+    const auto threadCount   = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    const bool filterInOrder = hasNestedOptions || threadCount == 1 || trackCount < ParallelFilterThreshold;
+
+    if(filterInOrder) {
+        auto result = filterRange(0, trackCount);
+        if(!result) {
+            return {};
+        }
+        filteredTracks = std::move(result.value());
+    }
+    else {
+        const size_t chunkSize  = std::max(MinFilterChunkSize, trackCount / (threadCount * 4));
+        const size_t chunkCount = (trackCount + chunkSize - 1) / chunkSize;
+        // With a limit, chunks are filtered a batch at a time so at most one batch is evaluated past the limit
+        const size_t batchSize = limit > 0 ? threadCount : chunkCount;
+
+        for(size_t batchStart{0}; batchStart < chunkCount; batchStart += batchSize) {
+            const size_t batchEnd = std::min(batchStart + batchSize, chunkCount);
+
+            std::vector<size_t> chunks(batchEnd - batchStart);
+            std::iota(chunks.begin(), chunks.end(), batchStart);
+            std::vector<std::optional<TrackListType>> results(chunks.size());
+
+            QtConcurrent::blockingMap(chunks, [&](const size_t chunk) {
+                const size_t first             = chunk * chunkSize;
+                results.at(chunk - batchStart) = filterRange(first, std::min(first + chunkSize, trackCount));
+            });
+
+            // Results are concatenated in chunk order, so matches keep the order of the tracks
+            for(auto& result : results) {
+                if(!result) {
+                    return {};
+                }
+                std::ranges::move(result.value(), std::back_inserter(filteredTracks));
+            }
+
+            if(limit > 0 && std::cmp_greater_equal(filteredTracks.size(), limit)) {
+                break;
+            }
+        }
+
+        if(limit > 0 && std::cmp_greater(filteredTracks.size(), limit)) {
+            filteredTracks.erase(filteredTracks.begin() + limit, filteredTracks.end());
         }
     }
 
@@ -1413,9 +1673,22 @@ TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, cons
     return filteredTracks;
 }
 
-ScriptResult ScriptParserPrivate::compareValues(const Expression& exp, const auto& tracks, const auto& comparator)
+ScriptResult ScriptParserPrivate::variableValue(const auto& exp, const auto& tracks) const
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    if constexpr(std::is_same_v<std::decay_t<decltype(exp)>, CompiledExpression>) {
+        if(!exp.variable) {
+            return {};
+        }
+        return exp.variable(tracks);
+    }
+    else {
+        return m_registry->value(std::get<QString>(exp.value).toLower(), tracks);
+    }
+}
+
+ScriptResult ScriptParserPrivate::compareValues(const auto& exp, const auto& tracks, const auto& comparator)
+{
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
@@ -1446,16 +1719,16 @@ ScriptResult ScriptParserPrivate::compareValues(const Expression& exp, const aut
     return result;
 }
 
-ScriptResult ScriptParserPrivate::compareDates(const Expression& exp, const auto& tracks, const auto& comparator)
+ScriptResult ScriptParserPrivate::compareDates(const auto& exp, const auto& tracks, const auto& comparator)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 2) {
         return {};
     }
 
     std::optional<int64_t> first;
 
-    const QString var = std::get<QString>(args.at(0).value);
+    const QString& var = exprValue(args.at(0));
     if constexpr(std::is_same_v<std::decay_t<decltype(tracks)>, Track>) {
         first = tracks.dateValue(var);
     }
@@ -1467,7 +1740,7 @@ ScriptResult ScriptParserPrivate::compareDates(const Expression& exp, const auto
         return {};
     }
 
-    const auto second = std::get<QString>(args.at(1).value).toLongLong();
+    const auto second = exprNumber(args.at(1));
 
     ScriptResult result;
     result.cond = comparator(first.value(), second);
@@ -1475,16 +1748,16 @@ ScriptResult ScriptParserPrivate::compareDates(const Expression& exp, const auto
     return result;
 }
 
-ScriptResult ScriptParserPrivate::compareDateRange(const Expression& exp, const auto& tracks)
+ScriptResult ScriptParserPrivate::compareDateRange(const auto& exp, const auto& tracks)
 {
-    const auto args = std::get<ExpressionList>(exp.value);
+    const auto& args = exprArgs(exp);
     if(args.size() < 3) {
         return {};
     }
 
     std::optional<int64_t> first;
 
-    const QString var = std::get<QString>(args.at(0).value);
+    const QString& var = exprValue(args.at(0));
     if constexpr(std::is_same_v<std::decay_t<decltype(tracks)>, Track>) {
         first = tracks.dateValue(var);
     }
@@ -1496,8 +1769,8 @@ ScriptResult ScriptParserPrivate::compareDateRange(const Expression& exp, const
         return {};
     }
 
-    const auto min = std::get<QString>(args.at(1).value).toLongLong();
-    const auto max = std::get<QString>(args.at(2).value).toLongLong();
+    const auto min = exprNumber(args.at(1));
+    const auto max = exprNumber(args.at(2));
 
     ScriptResult result;
     result.cond = first.value() > min && first.value() < max;
@@ -1571,6 +1844,16 @@ ScriptRegistry* ScriptParser::registry() const
 
 ScriptParser::~ScriptParser() = default;
 
+void ScriptParser::setSearchIndex(std::shared_ptr<const TrackSearchIndex> index)
+{
+    p->m_searchIndex = std::move(index);
+}
+
+void ScriptParser::setCancelCheck(std::function<bool()> isCancelled)
+{
+    p->m_isCancelled = std::move(isCancelled);
+}
+
 ParsedScript ScriptParser::parse(const QString& input)
 {
     if(input.isEmpty()) {
@@ -1589,6 +1872,60 @@ ParsedScript ScriptParser::parseQuery(const QString& input)
     return p->parseQuery(input);
 }
 
+bool ScriptParser::isNarrowerQuery(const QString& previous, const QString& query)
+{
+    if(previous.isEmpty() || query.isEmpty()) {
+        return false;
+    }
+
+    const auto previousTerms = searchTerms(parseQuery(previous));
+    const auto queryTerms    = searchTerms(parseQuery(query));
+    if(!previousTerms || !queryTerms || previousTerms->empty()) {
+        return false;
+    }
+
+    // Every track matching query also matches previous if each previous term is part of a term in query
+    return std::ranges::all_of(*previousTerms, [&queryTerms](const QString& previousTerm) {
+        return std::ranges::any_of(*queryTerms, [&previousTerm](const QString& term) {
+            return term.contains(previousTerm, Qt::CaseInsensitive);
+        });
+    });
+}
+
+bool ScriptParser::isIncrementalQuery(const QString& query)
+{
+    ScriptScanner scanner;
+    scanner.setSkipWhitespace(true);
+    scanner.setup(query);
+
+    // Keywords are checked rather than the parsed query, as DURING LAST is resolved to fixed dates when parsed
+    for(auto token = scanner.next(); token.type != TokenType::TokEos; token = scanner.next()) {
+        if(token.type == TokenType::TokLimit || token.type == TokenType::TokLast) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+CompiledScript ScriptParser::compile(const ParsedScript& input)
+{
+    if(!input.isValid()) {
+        return {};
+    }
+
+    return p->compile(input);
+}
+
+CompiledScript ScriptParser::compile(const QString& input)
+{
+    if(input.isEmpty()) {
+        return {};
+    }
+
+    return p->compile(parse(input));
+}
+
 QString ScriptParser::evaluate(const QString& input)
 {
     return evaluate(input, Track{});
@@ -1624,6 +1961,17 @@ QString ScriptParser::evaluate(const ParsedScript& input, const Track& track)
     return p->evaluate(input, track);
 }
 
+QString ScriptParser::evaluate(const CompiledScript& input, const Track& track)
+{
+    if(!input.isValid()) {
+        return {};
+    }
+
+    p->m_isQuery = false;
+
+    return p->evaluate(input, track);
+}
+
 QString ScriptParser::evaluate(const QString& input, const TrackList& tracks)
 {
     if(input.isEmpty()) {
@@ -1652,7 +2000,7 @@ TrackList ScriptParser::filter(const QString& input, const TrackList& tracks)
     }
 
     const auto script = parseQuery(input);
-    return p->evaluateQuery(script, tracks);
+    return filter(script, tracks);
 }
 
 TrackList ScriptParser::filter(const ParsedScript& input, const TrackList& tracks)
@@ -1663,6 +2011,17 @@ TrackList ScriptParser::filter(const ParsedScript& input, const TrackList& track
 
     p->m_isQuery = true;
 
+    return p->evaluateQuery(p->compile(input), tracks);
+}
+
+TrackList ScriptParser::filter(const CompiledScript& input, const TrackList& tracks)
+{
+    if(!input.isValid()) {
+        return {};
+    }
+
+    p->m_isQuery = true;
+
     return p->evaluateQuery(input, tracks);
 }
 
@@ -1673,7 +2032,7 @@ PlaylistTrackList ScriptParser::filter(const QString& input, const PlaylistTrack
     }
 
     const auto script = parseQuery(input);
-    return p->evaluateQuery(script, tracks);
+    return filter(script, tracks);
 }
 
 PlaylistTrackList ScriptParser::filter(const ParsedScript& input, const PlaylistTrackList& tracks)
@@ -1684,6 +2043,17 @@ PlaylistTrackList ScriptParser::filter(const ParsedScript& input, const Playlist
 
     p->m_isQuery = true;
 
+    return p->evaluateQuery(p->compile(input), tracks);
+}
+
+PlaylistTrackList ScriptParser::filter(const CompiledScript& input, const PlaylistTrackList& tracks)
+{
+    if(!input.isValid()) {
+        return {};
+    }
+
+    p->m_isQuery = true;
+
     return p->evaluateQuery(input, tracks);
 }
 
@@ -540,6 +540,96 @@ ScriptResult ScriptRegistry::function(const QString& func, const ScriptValueList
     return function(func, args, tracks.front());
 }
 
+ScriptRegistry::VariableFunc ScriptRegistry::bindVariable(const QString& var) const
+{
+    if(var.isEmpty()) {
+        return [](const Track& /*track*/) {
+            return ScriptResult{};
+        };
+    }
+
+    const QString variable = var.toUpper();
+
+    if(const auto it = p->m_metadata.find(variable); it != p->m_metadata.cend()) {
+        const TrackFunc* func = &it->second;
+        return [this, func](const Track& track) {
+            return calculateResult((*func)(track));
+        };
+    }
+    if(const auto it = p->m_playbackVars.find(variable); it != p->m_playbackVars.cend()) {
+        const NativeVoidFunc* func = &it->second;
+        return [this, func](const Track& /*track*/) {
+            return calculateResult((*func)());
+        };
+    }
+    if(const auto it = p->m_libraryVars.find(variable); it != p->m_libraryVars.cend()) {
+        const NativeTrackVoidFunc* func = &it->second;
+        return [this, func](const Track& track) {
+            return calculateResult((*func)(track));
+        };
+    }
+    if(const auto it = p->m_listProperties.find(variable); it != p->m_listProperties.cend()) {
+        const TrackListFunc* func = &it->second;
+        return [this, func](const Track& track) {
+            return calculateResult((*func)({track}));
+        };
+    }
+
+    return [this, variable](const Track& track) {
+        if(!track.hasExtraTag(variable)) {
+            return ScriptResult{};
+        }
+        return calculateResult(track.extraTag(variable));
+    };
+}
+
+ScriptRegistry::FunctionFunc ScriptRegistry::bindFunction(const QString& func) const
+{
+    if(func.isEmpty()) {
+        return {};
+    }
+
+    const auto it = p->m_funcs.find(func);
+    if(it == p->m_funcs.cend()) {
+        return {};
+    }
+
+    return std::visit(
+        [this](const auto& scriptFunc) -> FunctionFunc {
+            using FuncType = std::decay_t<decltype(scriptFunc)>;
+
+            if constexpr(std::is_same_v<FuncType, NativeFunc>) {
+                return [this, scriptFunc](const ScriptValueList& args, const Track& /*track*/) {
+                    const QString value = scriptFunc(containerCast<QStringList>(args));
+                    return ScriptResult{.value = value, .cond = !value.isEmpty()};
+                };
+            }
+            else if constexpr(std::is_same_v<FuncType, NativeVoidFunc>) {
+                return [scriptFunc](const ScriptValueList& /*args*/, const Track& /*track*/) {
+                    const QString value = scriptFunc();
+                    return ScriptResult{.value = value, .cond = !value.isEmpty()};
+                };
+            }
+            else if constexpr(std::is_same_v<FuncType, NativeTrackFunc>) {
+                return [this, scriptFunc](const ScriptValueList& args, const Track& track) {
+                    const QString value = scriptFunc(track, containerCast<QStringList>(args));
+                    return ScriptResult{.value = value, .cond = !value.isEmpty()};
+                };
+            }
+            else if constexpr(std::is_same_v<FuncType, NativeBoolFunc>) {
+                return [this, scriptFunc](const ScriptValueList& args, const Track& /*track*/) {
+                    return scriptFunc(containerCast<QStringList>(args));
+                };
+            }
+            else {
+                return [scriptFunc](const ScriptValueList& args, const Track& /*track*/) {
+                    return scriptFunc(args);
+                };
+            }
+        },
+        it->second);
+}
+
 void ScriptRegistry::setValue(const QString& var, const FuncRet& value, Track& track)
 {
     if(var.isEmpty()) {
@@ -0,0 +1,109 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "stringpool.h"
+
+#include <core/track.h>
+
+namespace Fooyin {
+StringPool& StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& str)
+{
+    if(str.isEmpty()) {
+        return {};
+    }
+
+    Shard& shard = shardFor(str);
+    const std::scoped_lock lock{shard.mutex};
+
+    auto& [pooled, entry] = *shard.strings.try_emplace(str).first;
+    entry.generation      = m_generation.load(std::memory_order_relaxed);
+    ++entry.uses;
+
+    return pooled;
+}
+
+QStringList StringPool::intern(const QStringList& strings)
+{
+    QStringList interned;
+    interned.reserve(strings.size());
+
+    for(const QString& str : strings) {
+        interned.emplace_back(intern(str));
+    }
+
+    return interned;
+}
+
+void StringPool::internTrack(Track& track)
+{
+    track.setArtists(intern(track.artists()));
+    track.setAlbum(intern(track.album()));
+    track.setAlbumArtists(intern(track.albumArtists()));
+    track.setGenres(intern(track.genres()));
+    track.setComposers(intern(track.composers()));
+    track.setPerformers(intern(track.performers()));
+    track.setCodec(intern(track.codec()));
+    track.setCodecProfile(intern(track.codecProfile()));
+    track.setTool(intern(track.tool()));
+    track.setTagTypes(intern(track.tagTypes()));
+    track.setEncoding(intern(track.encoding()));
+}
+
+void StringPool::prune()
+{
+    const uint32_t generation = m_generation.fetch_add(1, std::memory_order_relaxed);
+
+    for(Shard& shard : m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        std::erase_if(shard.strings,
+                      [generation](const auto& pooled) { return pooled.second.generation < generation; });
+    }
+}
+
+StringPool::Stats StringPool::stats() const
+{
+    Stats stats;
+
+    for(const Shard& shard : m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        for(const auto& [str, entry] : shard.strings) {
+            const auto bytes = static_cast<size_t>(str.size()) * sizeof(QChar);
+
+            ++stats.strings;
+            stats.bytes += bytes;
+            if(entry.uses > 1) {
+                stats.savedBytes += bytes * (entry.uses - 1);
+            }
+        }
+    }
+
+    return stats;
+}
+
+StringPool::Shard& StringPool::shardFor(const QString& str)
+{
+    return m_shards.at(qHash(str) % ShardCount);
+}
+} // namespace Fooyin
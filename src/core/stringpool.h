@@ -0,0 +1,92 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace Fooyin {
+class Track;
+
+/*!
+ * Thread-safe pool of shared strings for metadata which repeats across many tracks
+ * (artists, albums, genres, codecs etc).
+ * Interning a string returns the pooled copy, so equal values share a single allocation.
+ * Strings are pruned by generation: each prune drops the strings which haven't been interned since the
+ * previous one. Tracks still using a dropped string keep their copy, it just won't be shared with new ones.
+ * Only library tracks are pooled (when loaded from the database or built by a scan), as the pool is only
+ * pruned when a scan finishes or a library is removed.
+ */
+class FYCORE_EXPORT StringPool
+{
+public:
+    struct Stats
+    {
+        // Number of distinct strings held by the pool
+        size_t strings{0};
+        // Bytes used by the pooled strings
+        size_t bytes{0};
+        // Bytes which would have been allocated for repeated interns without the pool
+        size_t savedBytes{0};
+    };
+
+    static StringPool& instance();
+
+    [[nodiscard]] QString intern(const QString& str);
+    [[nodiscard]] QStringList intern(const QStringList& strings);
+
+    /** Replaces the repeated metadata of @p track with pooled strings. */
+    void internTrack(Track& track);
+
+    /** Removes strings which haven't been interned since the last call, and starts a new generation. */
+    void prune();
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    static constexpr size_t ShardCount = 16;
+
+    struct Entry
+    {
+        // The generation in which the string was last interned
+        uint32_t generation{0};
+        // Number of times the string has been interned
+        uint32_t uses{0};
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<QString, Entry> strings;
+    };
+
+    Shard& shardFor(const QString& str);
+
+    std::array<Shard, ShardCount> m_shards;
+    std::atomic<uint32_t> m_generation{0};
+};
+} // namespace Fooyin
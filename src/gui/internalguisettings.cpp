@@ -32,6 +32,8 @@
 #include <QStyle>
 
 constexpr int PixmapCacheSize = 32;
+// Memory budget in MB for populated playlists kept for tab switching
+constexpr int PlaylistModelCacheSize = 64;
 
 namespace {
 Fooyin::CoverPaths defaultCoverPaths()
@@ -163,5 +165,7 @@ GuiSettings::GuiSettings(SettingsManager* settingsManager)
     m_settings->createSetting<Internal::DirBrowserShowHorizScroll>(
         true, QStringLiteral("DirectoryBrowser/ShowHorizontalScrollbar"));
     m_settings->createSetting<Internal::LibTreeIconSize>(QSize{36, 36}, QStringLiteral("LibraryTree/IconSize"));
+    m_settings->createSetting<Internal::PlaylistModelCacheSize>(PlaylistModelCacheSize,
+                                                                QStringLiteral("PlaylistWidget/ModelCacheSize"));
 }
 } // namespace Fooyin
@@ -132,6 +132,7 @@ enum GuiInternalSettings : uint32_t
     SystemPalette             = 60 | Type::Variant,
     DirBrowserShowHorizScroll = 61 | Type::Bool,
     LibTreeIconSize           = 62 | Type::Variant,
+    PlaylistModelCacheSize    = 63 | Type::Int,
 };
 Q_ENUM_NS(GuiInternalSettings)
 } // namespace Settings::Gui::Internal
@@ -25,8 +25,10 @@
 #include <core/scripting/scriptparser.h>
 #include <core/scripting/scriptregistry.h>
 
-constexpr int InitialBatchSize = 3000;
-constexpr int BatchSize        = 4000;
+#include <span>
+
+constexpr size_t InitialBatchSize = 3000;
+constexpr size_t BatchSize        = 4000;
 
 namespace Fooyin {
 class LibraryTreePopulatorPrivate
@@ -41,7 +43,7 @@ public:
     LibraryTreeItem* getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent, const QString& title,
                                      int level);
     void iterateTrack(const Track& track);
-    bool runBatch(int size);
+    bool runBatches(std::span<const Track> tracks);
 
     LibraryTreePopulator* m_self;
 
@@ -52,7 +54,6 @@ public:
 
     LibraryTreeItem m_root;
     PendingTreeData m_data;
-    TrackList m_pendingTracks;
 };
 
 LibraryTreeItem* LibraryTreePopulatorPrivate::getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent,
@@ -89,7 +90,7 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
 
         for(int level{0}; const QString& item : items) {
             const QString title = item.trimmed();
-            const auto key      = Utils::generateMd5Hash(parent->key(), title);
+            const auto key      = Utils::generateKeyHash(parent->key(), title);
 
             auto* node = getOrInsertItem(key, parent, title, level);
 
@@ -102,39 +103,36 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
     }
 }
 
-bool LibraryTreePopulatorPrivate::runBatch(int size)
+bool LibraryTreePopulatorPrivate::runBatches(std::span<const Track> tracks)
 {
-    if(size <= 0) {
-        return true;
-    }
+    size_t batchSize{InitialBatchSize};
 
-    auto tracksBatch = std::ranges::views::take(m_pendingTracks, size);
+    // Always emit at least once so an empty library still resets the model
+    do {
+        const auto batch = tracks.first(std::min(batchSize, tracks.size()));
 
-    for(const Track& track : tracksBatch) {
-        if(!m_self->mayRun()) {
-            return false;
-        }
+        for(const Track& track : batch) {
+            if(!m_self->mayRun()) {
+                return false;
+            }
 
-        if(track.isInLibrary()) {
-            iterateTrack(track);
+            if(track.isInLibrary()) {
+                iterateTrack(track);
+            }
         }
-    }
 
-    if(!m_self->mayRun()) {
-        return false;
-    }
-
-    emit m_self->populated(m_data);
+        if(!m_self->mayRun()) {
+            return false;
+        }
 
-    auto tracksToKeep = std::ranges::views::drop(m_pendingTracks, size);
-    TrackList tempTracks;
-    std::ranges::copy(tracksToKeep, std::back_inserter(tempTracks));
-    m_pendingTracks = std::move(tempTracks);
+        emit m_self->populated(m_data);
+        m_data.clear();
 
-    m_data.clear();
+        tracks    = tracks.subspan(batch.size());
+        batchSize = BatchSize;
+    } while(!tracks.empty());
 
-    const auto remaining = static_cast<int>(m_pendingTracks.size());
-    return runBatch(std::min(remaining, BatchSize));
+    return true;
 }
 
 LibraryTreePopulator::LibraryTreePopulator(LibraryManager* libraryManager, QObject* parent)
@@ -158,8 +156,7 @@ void LibraryTreePopulator::run(const QString& grouping, const TrackList& tracks,
         p->m_script = p->m_parser.parse(p->m_currentGrouping);
     }
 
-    p->m_pendingTracks = tracks;
-    const bool success = p->runBatch(InitialBatchSize);
+    const bool success = p->runBatches(tracks);
 
     setState(Idle);
 
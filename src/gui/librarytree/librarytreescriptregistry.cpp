@@ -49,4 +49,14 @@ ScriptResult LibraryTreeScriptRegistry::value(const QString& var, const Track& t
     }
     return ScriptRegistry::value(var, track);
 }
+
+ScriptRegistry::VariableFunc LibraryTreeScriptRegistry::bindVariable(const QString& var) const
+{
+    if(var == u"frontcover" || var == u"backcover" || var == u"artistpicture") {
+        return [this, var](const Track& track) {
+            return value(var, track);
+        };
+    }
+    return ScriptRegistry::bindVariable(var);
+}
 } // namespace Fooyin
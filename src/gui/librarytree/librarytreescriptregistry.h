@@ -31,5 +31,6 @@ public:
 
     [[nodiscard]] bool isVariable(const QString& var, const Track& track) const override;
     [[nodiscard]] ScriptResult value(const QString& var, const Track& track) const override;
+    [[nodiscard]] VariableFunc bindVariable(const QString& var) const override;
 };
 } // namespace Fooyin
@@ -585,8 +585,9 @@ void LibraryTreeWidgetPrivate::searchChanged(const QString& search)
         return;
     }
 
-    Utils::asyncExec([search, tracks = m_library->tracks()]() {
+    Utils::asyncExec([search, tracks = m_library->tracks(), index = m_library->searchIndex()]() {
         ScriptParser parser;
+        parser.setSearchIndex(index);
         return parser.filter(search, tracks);
     }).then(m_self, [this](const TrackList& filteredTracks) {
         m_filteredTracks = filteredTracks;
@@ -724,8 +725,9 @@ void LibraryTreeWidgetPrivate::handleTracksAdded(const TrackList& tracks) const
     }
 
     if(!m_currentSearch.isEmpty()) {
-        Utils::asyncExec([search = m_currentSearch, tracks]() {
+        Utils::asyncExec([search = m_currentSearch, tracks, index = m_library->searchIndex()]() {
             ScriptParser parser;
+            parser.setSearchIndex(index);
             return parser.filter(search, tracks);
         }).then(m_self, [this](const TrackList& filteredTracks) { m_model->addTracks(filteredTracks); });
     }
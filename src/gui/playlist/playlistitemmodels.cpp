@@ -191,6 +191,8 @@ PlaylistTrackItem::PlaylistTrackItem(std::vector<RichScript> columns, const Play
     : m_columns{std::move(columns)}
     , m_track{track}
     , m_rowHeight{0}
+    , m_depth{0}
+    , m_textPending{false}
 { }
 
 PlaylistTrackItem::PlaylistTrackItem(RichScript left, RichScript right, const PlaylistTrack& track)
@@ -199,6 +201,7 @@ PlaylistTrackItem::PlaylistTrackItem(RichScript left, RichScript right, const Pl
     , m_track{track}
     , m_rowHeight{0}
     , m_depth{0}
+    , m_textPending{false}
 { }
 
 std::vector<RichScript> PlaylistTrackItem::columns() const
@@ -254,15 +257,22 @@ QSize PlaylistTrackItem::size(int column) const
     return m_sizes.at(column);
 }
 
+bool PlaylistTrackItem::textPending() const
+{
+    return m_textPending;
+}
+
 void PlaylistTrackItem::setColumns(const std::vector<RichScript>& columns)
 {
-    m_columns = columns;
+    m_columns     = columns;
+    m_textPending = false;
 }
 
 void PlaylistTrackItem::setLeftRight(const RichScript& left, const RichScript& right)
 {
-    m_left  = left;
-    m_right = right;
+    m_left        = left;
+    m_right       = right;
+    m_textPending = false;
 }
 
 void PlaylistTrackItem::setTrack(const PlaylistTrack& track)
@@ -285,6 +295,33 @@ void PlaylistTrackItem::setDepth(int depth)
     m_depth = depth;
 }
 
+void PlaylistTrackItem::setTextPending(bool pending)
+{
+    m_textPending = pending;
+}
+
+uint64_t PlaylistTrackItem::textGeneration() const
+{
+    return m_textGeneration;
+}
+
+void PlaylistTrackItem::setTextGeneration(uint64_t generation)
+{
+    m_textGeneration = generation;
+}
+
+void PlaylistTrackItem::clearText()
+{
+    for(auto& column : m_columns) {
+        column.text.clear();
+    }
+    m_left.text.clear();
+    m_right.text.clear();
+
+    m_textPending = true;
+    calculateSize();
+}
+
 void PlaylistTrackItem::removeColumn(int column)
 {
     if(column < 0 || std::cmp_greater_equal(column, m_columns.size())) {
@@ -296,6 +333,8 @@ void PlaylistTrackItem::removeColumn(int column)
 
 void PlaylistTrackItem::calculateSize()
 {
+    m_sizes.clear();
+
     auto addSize = [](const RichScript& script) {
         QSize blockSize;
         for(const auto& title : script.text) {
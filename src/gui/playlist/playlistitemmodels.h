@@ -87,6 +87,9 @@ public:
     [[nodiscard]] int rowHeight() const;
     [[nodiscard]] int depth() const;
     [[nodiscard]] QSize size(int column = 0) const;
+    [[nodiscard]] bool textPending() const;
+    // Incremented whenever the track is refreshed, so text evaluated before then can be discarded
+    [[nodiscard]] uint64_t textGeneration() const;
 
     void setColumns(const std::vector<RichScript>& columns);
     void setLeftRight(const RichScript& left, const RichScript& right);
@@ -95,6 +98,9 @@ public:
 
     void setRowHeight(int height);
     void setDepth(int depth);
+    void setTextPending(bool pending);
+    void setTextGeneration(uint64_t generation);
+    void clearText();
     void removeColumn(int column);
 
     void calculateSize();
@@ -108,5 +114,7 @@ private:
     std::vector<QSize> m_sizes;
     int m_rowHeight;
     int m_depth;
+    bool m_textPending;
+    uint64_t m_textGeneration{0};
 };
 } // namespace Fooyin
@@ -32,6 +32,7 @@
 #include <core/library/musiclibrary.h>
 #include <core/player/playercontroller.h>
 #include <core/playlist/playlist.h>
+#include <core/playlist/playlisthandler.h>
 #include <core/track.h>
 #include <gui/coverprovider.h>
 #include <gui/guiconstants.h>
@@ -55,6 +56,10 @@
 
 constexpr auto MimeModelId       = "application/x-playlistmodel-id";
 constexpr auto MaxPlaylistTracks = 250;
+// Tracks either side of a displayed row to evaluate alongside it
+constexpr auto TrackTextPrefetch = 100;
+// Maximum number of tracks holding evaluated text before the oldest are cleared
+constexpr auto TrackTextCacheSize = 5000;
 
 namespace {
 bool cmpItemsPlaylistItems(Fooyin::PlaylistItem* pItem1, Fooyin::PlaylistItem* pItem2, bool reverse = false)
@@ -125,6 +130,56 @@ int determineDropIndex(const QAbstractItemModel* model, const QModelIndex& paren
     return getPlaylistIndex(current);
 }
 
+void collectTrackKeys(const Fooyin::PlaylistItem* item, std::vector<Fooyin::UId>& keys)
+{
+    if(!item) {
+        return;
+    }
+
+    if(item->type() == Fooyin::PlaylistItem::Track) {
+        keys.push_back(item->key());
+        return;
+    }
+
+    const int childCount = item->childCount();
+    for(int row{0}; row < childCount; ++row) {
+        collectTrackKeys(item->child(row), keys);
+    }
+}
+
+const Fooyin::PlaylistItem* lastTrack(const Fooyin::PlaylistItem* item)
+{
+    if(!item || item->type() == Fooyin::PlaylistItem::Track) {
+        return item;
+    }
+
+    for(int row{item->childCount() - 1}; row >= 0; --row) {
+        if(const auto* track = lastTrack(item->child(row))) {
+            return track;
+        }
+    }
+
+    return nullptr;
+}
+
+// Returns the closest track before @p row of @p parent in playlist order
+const Fooyin::PlaylistItem* previousTrack(Fooyin::PlaylistItem* parent, int row)
+{
+    while(parent) {
+        for(int prevRow{row - 1}; prevRow >= 0; --prevRow) {
+            if(const auto* track = lastTrack(parent->child(prevRow))) {
+                return track;
+            }
+        }
+
+        parent->resetRow();
+        row    = parent->row();
+        parent = parent->parent();
+    }
+
+    return nullptr;
+}
+
 Fooyin::PlaylistItem* cloneParent(Fooyin::ItemKeyMap& nodes, Fooyin::PlaylistItem* parent)
 {
     const auto parentKey{Fooyin::UId::create()};
@@ -489,6 +544,7 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
     , m_disabledColour{Qt::red}
     , m_populator{playlistInteractor->playerController()}
     , m_playlistLoaded{false}
+    , m_sparseIndexes{false}
     , m_pixmapPadding{settings->value<Settings::Gui::Internal::PlaylistImagePadding>()}
     , m_pixmapPaddingTop{settings->value<Settings::Gui::Internal::PlaylistImagePaddingTop>()}
     , m_starRatingSize{settings->value<Settings::Gui::StarRatingSize>()}
@@ -502,6 +558,13 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
     m_populator.moveToThread(&m_populatorThread);
     m_populatorThread.start();
 
+    m_cache.setMaxCost(static_cast<size_t>(m_settings->value<Settings::Gui::Internal::PlaylistModelCacheSize>())
+                       * 1024 * 1024);
+
+    m_textTimer.setSingleShot(true);
+    m_textTimer.setInterval(0);
+    QObject::connect(&m_textTimer, &QTimer::timeout, this, &PlaylistModel::evaluateTrackText);
+
     m_settings->subscribe<Settings::Gui::Internal::PlaylistImagePadding>(this, [this](int padding) {
         m_pixmapPadding = padding;
         emit dataChanged({}, {}, {PlaylistItem::ImagePadding});
@@ -525,6 +588,22 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
 
     m_settings->subscribe<Settings::Gui::IconTheme>(this, [this]() { emit dataChanged({}, {}, {Qt::DecorationRole}); });
 
+    m_settings->subscribe<Settings::Gui::Internal::PlaylistModelCacheSize>(
+        this, [this](int size) { m_cache.setMaxCost(static_cast<size_t>(size) * 1024 * 1024); });
+    m_settings->subscribe<Settings::Core::UseVariousForCompilations>(this, [this]() { clearCache(); });
+
+    auto* playlistHandler = playlistInteractor->handler();
+    QObject::connect(playlistHandler, &PlaylistHandler::playlistRemoved, this,
+                     &PlaylistModel::invalidateCachedPlaylist);
+    QObject::connect(playlistHandler, &PlaylistHandler::tracksAdded, this, &PlaylistModel::invalidateCachedPlaylist);
+    QObject::connect(playlistHandler, &PlaylistHandler::tracksChanged, this, &PlaylistModel::invalidateCachedPlaylist);
+    QObject::connect(playlistHandler, &PlaylistHandler::tracksUpdated, this, &PlaylistModel::invalidateCachedPlaylist);
+    QObject::connect(playlistHandler, &PlaylistHandler::tracksRemoved, this, &PlaylistModel::invalidateCachedPlaylist);
+
+    QObject::connect(m_library, &MusicLibrary::tracksMetadataChanged, this, &PlaylistModel::invalidateCachedTracks);
+    QObject::connect(m_library, &MusicLibrary::tracksUpdated, this, &PlaylistModel::invalidateCachedTracks);
+    QObject::connect(m_library, &MusicLibrary::tracksDeleted, this, &PlaylistModel::invalidateCachedTracks);
+
     QObject::connect(&m_populator, &PlaylistPopulator::finished, this, [this]() {
         m_playlistLoaded = true;
         emit dataChanged({}, {});
@@ -543,6 +622,9 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
     QObject::connect(&m_populator, &PlaylistPopulator::tracksUpdated, this,
                      [this](const ItemList& data) { updateTracks(data); });
 
+    QObject::connect(&m_populator, &PlaylistPopulator::tracksEvaluated, this,
+                     [this](const ItemList& data) { updateTrackText(data); });
+
     QObject::connect(m_coverProvider, &CoverProvider::coverAdded, this,
                      [this](const Track& track) { coverUpdated(track); });
 }
@@ -761,13 +843,13 @@ MoveOperation PlaylistModel::moveTracks(const MoveOperation& operation)
         int targetIndex{0};
 
         if(end) {
-            targetIndex = targetItem->index() + 1;
+            targetIndex = playlistIndexOf(targetItem) + 1;
         }
         else if(targetRow >= targetParentItem->childCount()) {
             targetIndex = targetParentItem->childCount();
         }
         else {
-            targetIndex = targetParentItem->child(targetRow)->index();
+            targetIndex = playlistIndexOf(targetParentItem->child(targetRow));
         }
 
         int row = targetRow;
@@ -797,7 +879,7 @@ MoveOperation PlaylistModel::moveTracks(const MoveOperation& operation)
             }
 
             const int childCount   = static_cast<int>(children.size());
-            const int sourceIndex  = children.front()->index();
+            const int sourceIndex  = playlistIndexOf(children.front());
             const int reverseIndex = sourceIndex + (sourceIndex > targetIndex ? childCount : 0);
 
             const QModelIndex sourceParent = indexOfItem(sourceParentItem);
@@ -806,7 +888,6 @@ MoveOperation PlaylistModel::moveTracks(const MoveOperation& operation)
             row = dropMoveRows(sourceParent, children, targetParent, row);
             endMoveRows();
 
-            updateTrackIndexes();
             rootItem()->resetChildren();
 
             pendingGroups.emplace_back(reverseIndex, MoveOperationItemGroups{children});
@@ -825,7 +906,6 @@ MoveOperation PlaylistModel::moveTracks(const MoveOperation& operation)
     }
 
     cleanupHeaders();
-    updateTrackIndexes();
 
     tracksChanged();
 
@@ -866,6 +946,7 @@ void PlaylistModel::resetColumnAlignments()
 
 void PlaylistModel::setFont(const QFont& font)
 {
+    clearCache();
     QMetaObject::invokeMethod(&m_populator, [this, font]() { m_populator.setFont(font); });
 }
 
@@ -886,6 +967,8 @@ void PlaylistModel::reset(const PlaylistTrackList& tracks)
 {
     m_populator.stopThread();
 
+    m_treeKey.reset();
+
     m_playlistLoaded = false;
     m_resetting      = true;
 
@@ -898,6 +981,8 @@ void PlaylistModel::reset(const PlaylistTrackList& tracks)
 void PlaylistModel::reset(const PlaylistPreset& preset, const PlaylistColumnList& columns, Playlist* playlist,
                           const PlaylistTrackList& tracks)
 {
+    markTreeForCache(playlist);
+
     if(preset.isValid()) {
         m_currentPreset = preset;
     }
@@ -913,7 +998,19 @@ void PlaylistModel::reset(const PlaylistPreset& preset, const PlaylistColumnList
 
 void PlaylistModel::reset(const PlaylistPreset& preset, const PlaylistColumnList& columns, Playlist* playlist)
 {
-    reset(preset, columns, playlist, playlist ? playlist->playlistTracks() : PlaylistTrackList{});
+    if(!playlist) {
+        reset(preset, columns, playlist, {});
+        return;
+    }
+
+    PlaylistModelCacheKey key{playlist->id(), preset.isValid() ? preset : m_currentPreset, columns};
+
+    if(restoreCachedPlaylist(key, playlist)) {
+        return;
+    }
+
+    reset(preset, columns, playlist, playlist->playlistTracks());
+    m_treeKey = std::move(key);
 }
 
 PlaylistTrack PlaylistModel::playingTrack() const
@@ -936,23 +1033,16 @@ void PlaylistModel::stopAfterTrack(const QModelIndex& index)
 
 TrackIndexResult PlaylistModel::trackIndexAtPlaylistIndex(int index)
 {
-    if(m_trackIndexes.empty()) {
+    if(m_trackOrder.empty()) {
         return {};
     }
 
-    if(index >= 0) {
-        if(m_trackIndexes.contains(index)) {
-            const auto key = m_trackIndexes.at(index);
-            if(m_nodes.contains(key)) {
-                auto& item = m_nodes.at(key);
-                return {indexOfItem(&item), false};
-            }
-        }
+    if(PlaylistItem* item = itemAtPlaylistIndex(index)) {
+        return {indexOfItem(item), false};
     }
 
     // End of playlist - return last track index
-    const auto lastIndex = std::prev(m_trackIndexes.cend())->first;
-    const auto key       = m_trackIndexes.at(lastIndex);
+    const auto& key = m_trackOrder.at(m_trackOrder.size() - 1);
     if(m_nodes.contains(key)) {
         auto& item = m_nodes.at(key);
         return {indexOfItem(&item), true};
@@ -1040,7 +1130,13 @@ void PlaylistModel::refreshTracks(const std::vector<int>& indexes)
         const auto& [modelIndex, end] = trackIndexAtPlaylistIndex(index);
         if(!end) {
             if(const auto track = m_currentPlaylist->playlistTrack(index)) {
-                items.emplace(track.value(), *itemForIndex(modelIndex));
+                PlaylistItem* item = itemForIndex(modelIndex);
+                if(item->type() == PlaylistItem::Track) {
+                    // Discard any text still being evaluated from the previous track
+                    auto& trackData = std::get<PlaylistTrackItem>(item->data());
+                    trackData.setTextGeneration(trackData.textGeneration() + 1);
+                }
+                items.emplace(track.value(), *item);
             }
         }
     }
@@ -1068,7 +1164,6 @@ void PlaylistModel::removeTracks(const QModelIndexList& indexes)
     }
 
     cleanupHeaders();
-    updateTrackIndexes();
 
     tracksChanged();
 }
@@ -1196,9 +1291,7 @@ void PlaylistModel::populateModel(PendingData& data)
 
     if(m_resetting) {
         beginResetModel();
-        resetRoot();
-        m_nodes.clear();
-        m_trackParents.clear();
+        releaseTree();
     }
 
     m_nodes.merge(data.items);
@@ -1225,7 +1318,22 @@ void PlaylistModel::populateModel(PendingData& data)
         }
     }
 
-    updateTrackIndexes(false);
+    for(const UId& key : data.trackOrder) {
+        auto nodeIt = m_nodes.find(key);
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        PlaylistItem& item = nodeIt->second;
+        if(item.index() < 0) {
+            item.setIndex(m_trackOrder.size());
+        }
+        else if(item.index() != m_trackOrder.size()) {
+            // Filtered playlists keep the indexes of their tracks in the full playlist
+            m_sparseIndexes = true;
+        }
+        m_trackOrder.append(key);
+    }
 
     if(m_resetting) {
         endResetModel();
@@ -1289,15 +1397,287 @@ void PlaylistModel::updateTracks(const ItemList& tracks)
     for(const PlaylistItem& item : tracks) {
         if(m_nodes.contains(item.key())) {
             auto* node = &m_nodes.at(item.key());
+
+            // Text requested before the update was evaluated from the previous track
+            uint64_t textGeneration{0};
+            if(node->type() == PlaylistItem::Track) {
+                textGeneration = std::get<PlaylistTrackItem>(node->data()).textGeneration() + 1;
+            }
+
             node->setData(item.data());
             node->setState(PlaylistItem::State::None);
 
+            if(node->type() == PlaylistItem::Track) {
+                std::get<PlaylistTrackItem>(node->data()).setTextGeneration(textGeneration);
+            }
+
             const QModelIndex trackIndex = indexOfItem(node);
             emit dataChanged(trackIndex, trackIndex.siblingAtColumn(columnCount(trackIndex) - 1), {});
         }
     }
 }
 
+void PlaylistModel::markTreeForCache(Playlist* nextPlaylist)
+{
+    if(m_resetting) {
+        // The tree hasn't been replaced yet, so what it was built from is unchanged
+        return;
+    }
+
+    m_releasedTreeKey.reset();
+
+    if(nextPlaylist != m_currentPlaylist && m_currentPlaylist && m_playlistLoaded && m_treeKey
+       && m_trackOrder.size() == m_currentPlaylist->trackCount()) {
+        m_releasedTreeKey = m_treeKey;
+    }
+}
+
+bool PlaylistModel::restoreCachedPlaylist(const PlaylistModelCacheKey& key, Playlist* playlist)
+{
+    if(m_resetting && m_releasedTreeKey == key) {
+        // Switched back before the tree was replaced
+        m_populator.stopThread();
+        m_releasedTreeKey.reset();
+        beginResetModel();
+    }
+    else {
+        auto entry = m_cache.take(key);
+        if(!entry || entry->trackOrder.size() != playlist->trackCount()) {
+            return false;
+        }
+
+        m_populator.stopThread();
+        markTreeForCache(playlist);
+
+        beginResetModel();
+        releaseTree();
+
+        setRoot(std::move(entry->root));
+        m_nodes         = std::move(entry->nodes);
+        m_trackParents  = std::move(entry->trackParents);
+        m_trackOrder    = std::move(entry->trackOrder);
+        m_sparseIndexes = entry->sparseIndexes;
+    }
+
+    m_currentPreset   = key.preset;
+    m_columns         = key.columns;
+    m_pixmapColumns   = pixmapColumns();
+    m_currentPlaylist = playlist;
+    updateHeader(playlist);
+
+    m_treeKey        = key;
+    m_resetting      = false;
+    m_playlistLoaded = true;
+
+    endResetModel();
+    emit playlistLoaded();
+
+    return true;
+}
+
+void PlaylistModel::releaseTree()
+{
+    if(m_releasedTreeKey && m_cache.maxCost() > 0) {
+        // Evaluated text isn't kept as it may depend on playback state
+        for(const UId& key : m_textEvaluated) {
+            auto nodeIt = m_nodes.find(key);
+            if(nodeIt != m_nodes.end() && nodeIt->second.type() == PlaylistItem::Track) {
+                std::get<PlaylistTrackItem>(nodeIt->second.data()).clearText();
+            }
+        }
+
+        PlaylistModelCacheEntry entry;
+        entry.key           = m_releasedTreeKey.value();
+        entry.root          = takeRoot();
+        entry.nodes         = std::move(m_nodes);
+        entry.trackParents  = std::move(m_trackParents);
+        entry.trackOrder    = std::move(m_trackOrder);
+        entry.sparseIndexes = m_sparseIndexes;
+
+        m_cache.insert(std::move(entry));
+    }
+    else {
+        resetRoot();
+    }
+
+    m_releasedTreeKey.reset();
+    m_nodes.clear();
+    m_trackParents.clear();
+    m_trackOrder.clear();
+    m_sparseIndexes = false;
+    clearTrackText();
+}
+
+void PlaylistModel::invalidateCachedPlaylist(Playlist* playlist)
+{
+    if(!playlist) {
+        return;
+    }
+
+    const UId id = playlist->id();
+
+    m_cache.remove(id);
+
+    if(m_treeKey && m_treeKey->playlistId == id) {
+        m_treeKey.reset();
+    }
+    if(m_releasedTreeKey && m_releasedTreeKey->playlistId == id) {
+        m_releasedTreeKey.reset();
+    }
+}
+
+void PlaylistModel::invalidateCachedTracks(const TrackList& tracks)
+{
+    m_cache.removeTracks(tracks);
+
+    const bool inTree
+        = std::ranges::any_of(tracks, [this](const Track& track) { return m_trackParents.contains(track.id()); });
+    if(inTree) {
+        m_treeKey.reset();
+        m_releasedTreeKey.reset();
+    }
+}
+
+void PlaylistModel::clearCache()
+{
+    m_cache.clear();
+    m_treeKey.reset();
+    m_releasedTreeKey.reset();
+}
+
+void PlaylistModel::updateTrackText(const ItemList& tracks)
+{
+    if(m_resetting) {
+        return;
+    }
+
+    for(const PlaylistItem& item : tracks) {
+        m_textRequested.erase(item.key());
+
+        auto nodeIt = m_nodes.find(item.key());
+        if(nodeIt == m_nodes.end()) {
+            continue;
+        }
+
+        auto* node      = &nodeIt->second;
+        auto& trackData = std::get<PlaylistTrackItem>(node->data());
+        if(!trackData.textPending()) {
+            continue;
+        }
+
+        const auto& evaluated = std::get<PlaylistTrackItem>(item.data());
+        if(evaluated.columns().size() != trackData.columns().size()) {
+            // Columns changed while the text was being evaluated
+            continue;
+        }
+
+        if(evaluated.textGeneration() != trackData.textGeneration()) {
+            // Track was refreshed while its text was being evaluated
+            queueTrackText(node->key());
+            m_textTimer.start();
+            continue;
+        }
+
+        if(trackData.columns().empty()) {
+            trackData.setLeftRight(evaluated.left(), evaluated.right());
+        }
+        else {
+            trackData.setColumns(evaluated.columns());
+        }
+        trackData.calculateSize();
+
+        // Re-evaluated text moves to the back, so an older entry can't evict it early
+        if(!m_textEvaluatedKeys.emplace(node->key()).second) {
+            std::erase(m_textEvaluated, node->key());
+        }
+        m_textEvaluated.push_back(node->key());
+
+        const QModelIndex trackIndex = indexOfItem(node);
+        emit dataChanged(trackIndex, trackIndex.siblingAtColumn(columnCount(trackIndex) - 1), {});
+    }
+
+    // Evaluated text is kept for a bounded number of tracks; rows scrolled back into view are re-evaluated
+    while(std::cmp_greater(m_textEvaluated.size(), TrackTextCacheSize)) {
+        const UId key = m_textEvaluated.front();
+        m_textEvaluated.pop_front();
+        m_textEvaluatedKeys.erase(key);
+
+        auto nodeIt = m_nodes.find(key);
+        if(nodeIt != m_nodes.end() && nodeIt->second.type() == PlaylistItem::Track) {
+            std::get<PlaylistTrackItem>(nodeIt->second.data()).clearText();
+        }
+    }
+}
+
+void PlaylistModel::requestTrackText(const PlaylistItem* item) const
+{
+    if(m_textRequested.contains(item->key())) {
+        return;
+    }
+
+    queueTrackText(item->key());
+
+    // Prefetch the surrounding rows so scrolling doesn't wait on the populator
+    const int pos = m_trackOrder.indexOf(item->key());
+    if(pos >= 0) {
+        const int first = std::max(0, pos - TrackTextPrefetch);
+        const int last  = std::min(m_trackOrder.size() - 1, pos + TrackTextPrefetch);
+        for(int i{first}; i <= last; ++i) {
+            queueTrackText(m_trackOrder.at(i));
+        }
+    }
+
+    m_textTimer.start();
+}
+
+void PlaylistModel::queueTrackText(const UId& key) const
+{
+    const auto nodeIt = m_nodes.find(key);
+    if(nodeIt == m_nodes.end() || nodeIt->second.type() != PlaylistItem::Track) {
+        return;
+    }
+
+    const auto& trackData = std::get<PlaylistTrackItem>(nodeIt->second.data());
+    if(trackData.textPending() && m_textRequested.emplace(key).second) {
+        m_textQueue.push_back(key);
+    }
+}
+
+void PlaylistModel::evaluateTrackText()
+{
+    if(m_textQueue.empty() || !m_currentPlaylist) {
+        return;
+    }
+
+    ItemList items;
+    items.reserve(m_textQueue.size());
+
+    for(const UId& key : m_textQueue) {
+        const auto nodeIt = m_nodes.find(key);
+        if(nodeIt != m_nodes.end()) {
+            items.push_back(nodeIt->second);
+            items.back().setIndex(playlistIndexOf(&nodeIt->second));
+        }
+        else {
+            m_textRequested.erase(key);
+        }
+    }
+    m_textQueue.clear();
+
+    const UId playlistId = m_currentPlaylist->id();
+    QMetaObject::invokeMethod(&m_populator,
+                              [this, playlistId, items] { m_populator.evaluateTracks(playlistId, items); });
+}
+
+void PlaylistModel::clearTrackText()
+{
+    m_textTimer.stop();
+    m_textRequested.clear();
+    m_textQueue.clear();
+    m_textEvaluated.clear();
+    m_textEvaluatedKeys.clear();
+}
+
 void PlaylistModel::mergeTrackParents(const TrackIdNodeMap& parents)
 {
     for(const auto& pair : parents) {
@@ -1324,7 +1704,13 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
     const Track& track   = trackItem.track().track;
 
     const bool singleColumnMode = m_columns.empty();
-    const bool isPlaying        = trackIsPlaying(track, item->index());
+    const bool isPlaying        = trackIsPlaying(item);
+
+    if(trackItem.textPending()
+       && (role == Qt::ToolTipRole || role == PlaylistItem::Role::Column || role == PlaylistItem::Role::Left
+           || role == PlaylistItem::Role::Right)) {
+        requestTrackText(item);
+    }
 
     auto getCover = [this, &index, column](const Track::Cover type) -> QVariant {
         if(std::cmp_greater_equal(column, m_columnSizes.size())) {
@@ -1356,7 +1742,7 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
             break;
         }
         case(PlaylistItem::Role::Index):
-            return item->index();
+            return playlistIndexOf(item);
         case(PlaylistItem::Role::Column): {
             if(singleColumnMode) {
                 break;
@@ -1396,8 +1782,11 @@ QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index,
             return QVariant::fromValue(trackItem.left().text);
         case(PlaylistItem::Role::Right):
             return QVariant::fromValue(trackItem.right().text);
-        case(PlaylistItem::Role::ItemData):
-            return QVariant::fromValue<PlaylistTrack>(trackItem.track());
+        case(PlaylistItem::Role::ItemData): {
+            PlaylistTrack playlistTrack{trackItem.track()};
+            playlistTrack.indexInPlaylist = playlistIndexOf(item);
+            return QVariant::fromValue<PlaylistTrack>(playlistTrack);
+        }
         case(Qt::BackgroundRole): {
             if(!track.isEnabled()) {
                 return m_disabledColour;
@@ -1759,7 +2148,8 @@ PlaylistModel::DropTargetResult PlaylistModel::canBeMerged(PlaylistItem*& currTa
 
 void PlaylistModel::handleTrackGroup(PendingData& data)
 {
-    updateTrackIndexes();
+    // Inserted tracks are positioned by their index in the playlist being edited
+    m_sparseIndexes = false;
 
     std::unordered_map<UId, size_t, UId::UIdHash> keyPositionMap;
     keyPositionMap.reserve(data.containerOrder.size());
@@ -1824,7 +2214,6 @@ void PlaylistModel::handleTrackGroup(PendingData& data)
             endInsertRows();
 
             rootItem()->resetChildren();
-            updateTrackIndexes();
         }
     }
 
@@ -1859,6 +2248,8 @@ int PlaylistModel::dropInsertRows(const PlaylistItemList& rows, const QModelInde
         return row;
     }
 
+    const int firstRow{row};
+
     for(Fooyin::PlaylistItem* childItem : rows) {
         childItem->resetRow();
         auto* newChild = &m_nodes.emplace(childItem->key(), *childItem).first->second;
@@ -1869,6 +2260,8 @@ int PlaylistModel::dropInsertRows(const PlaylistItemList& rows, const QModelInde
     }
     targetParent->resetChildren();
 
+    indexTracks(targetParent, firstRow, row - 1);
+
     return row;
 }
 
@@ -1881,6 +2274,8 @@ int PlaylistModel::dropMoveRows(const QModelIndex& source, const PlaylistItemLis
         return currRow;
     }
 
+    unindexTracks(rows);
+
     auto* sourceParent = itemForIndex(source);
     for(Fooyin::PlaylistItem* childItem : rows) {
         childItem->resetRow();
@@ -1903,13 +2298,20 @@ int PlaylistModel::dropMoveRows(const QModelIndex& source, const PlaylistItemLis
     sourceParent->resetChildren();
     targetParent->resetChildren();
 
+    if(!rows.empty()) {
+        indexTracks(targetParent, rows.front()->row(), rows.back()->row());
+    }
+
     return currRow;
 }
 
 int PlaylistModel::dropCopyRows(const QModelIndex& source, const PlaylistItemList& rows, const QModelIndex& target,
                                 int row)
 {
-    return dropCopyRowsRecursive(source, rows, target, row);
+    const int lastRow = dropCopyRowsRecursive(source, rows, target, row);
+    indexTracks(itemForIndex(target), row, lastRow - 1);
+
+    return lastRow;
 }
 
 int PlaylistModel::dropCopyRowsRecursive(const QModelIndex& source, const PlaylistItemList& rows,
@@ -1956,11 +2358,11 @@ bool PlaylistModel::insertPlaylistRows(const QModelIndex& target, int firstRow,
     auto* parent = itemForIndex(target);
 
     beginInsertRows(target, firstRow, lastRow);
-    for(PlaylistItem* child : children) {
-        parent->insertChild(firstRow, child);
+    for(int row{firstRow}; PlaylistItem* child : children) {
+        parent->insertChild(row++, child);
         child->setPending(false);
-        firstRow += 1;
     }
+    indexTracks(parent, firstRow, lastRow);
     endInsertRows();
 
     return true;
@@ -2153,51 +2555,112 @@ void PlaylistModel::updateHeaders()
     QMetaObject::invokeMethod(&m_populator, [this, updatedHeaders]() { m_populator.updateHeaders(updatedHeaders); });
 }
 
-void PlaylistModel::updateTrackIndexes(bool updateItems)
+void PlaylistModel::deleteNodes(PlaylistItem* node)
 {
-    std::stack<PlaylistItem*> trackNodes;
-    trackNodes.push(rootItem());
-    int index{0};
+    if(!node) {
+        return;
+    }
 
-    m_trackIndexes.clear();
+    const auto children = node->children();
+    for(PlaylistItem* child : children) {
+        deleteNodes(child);
+    }
 
-    while(!trackNodes.empty()) {
-        PlaylistItem* node = trackNodes.top();
-        trackNodes.pop();
+    if(node->type() == PlaylistItem::Track && m_trackOrder.erase(node->key())) {
+        m_sparseIndexes = false;
+    }
 
-        if(!node) {
-            continue;
-        }
+    m_nodes.erase(node->key());
+}
 
-        if(node->type() == PlaylistItem::Track) {
-            if(updateItems || node->index() < 0) {
-                node->setIndex(index);
-                m_trackIndexes.emplace(index++, node->key());
-            }
-            else {
-                m_trackIndexes.emplace(node->index(), node->key());
-            }
+void PlaylistModel::indexTracks(PlaylistItem* parent, int firstRow, int lastRow)
+{
+    if(!parent) {
+        return;
+    }
+
+    // Tracks are numbered by position once the playlist has been edited
+    m_sparseIndexes = false;
+
+    std::vector<UId> keys;
+    for(int row{firstRow}; row <= lastRow; ++row) {
+        collectTrackKeys(parent->child(row), keys);
+    }
+
+    if(keys.empty()) {
+        return;
+    }
+
+    int pos{0};
+    if(const auto* prevTrack = previousTrack(parent, firstRow)) {
+        pos = m_trackOrder.indexOf(prevTrack->key()) + 1;
+    }
+
+    m_trackOrder.insert(pos, keys);
+}
+
+void PlaylistModel::unindexTracks(const PlaylistItemList& items)
+{
+    for(PlaylistItem* item : items) {
+        if(item->type() == PlaylistItem::Track) {
+            m_trackOrder.erase(item->key());
         }
+        else {
+            unindexTracks(item->children());
+        }
+    }
+}
+
+int PlaylistModel::playlistIndexOf(const PlaylistItem* item) const
+{
+    if(!item || item->type() != PlaylistItem::Track) {
+        return -1;
+    }
 
-        const auto children = node->children();
-        for(PlaylistItem* child : children | std::views::reverse) {
-            trackNodes.push(child);
+    if(!m_sparseIndexes) {
+        const int pos = m_trackOrder.indexOf(item->key());
+        if(pos >= 0) {
+            return pos;
         }
     }
+
+    return item->index();
 }
 
-void PlaylistModel::deleteNodes(PlaylistItem* node)
+PlaylistItem* PlaylistModel::itemAtPlaylistIndex(int index)
 {
-    if(!node) {
-        return;
+    if(index < 0 || m_trackOrder.empty()) {
+        return nullptr;
     }
 
-    const auto children = node->children();
-    for(PlaylistItem* child : children) {
-        deleteNodes(child);
+    int pos{index};
+
+    if(m_sparseIndexes) {
+        // Tracks are still in playlist order, so search their stored indexes
+        int first{0};
+        int last{m_trackOrder.size()};
+        while(first < last) {
+            const int mid = first + ((last - first) / 2);
+            if(m_nodes.at(m_trackOrder.at(mid)).index() < index) {
+                first = mid + 1;
+            }
+            else {
+                last = mid;
+            }
+        }
+        pos = first;
     }
 
-    m_nodes.erase(node->key());
+    if(pos >= m_trackOrder.size()) {
+        return nullptr;
+    }
+
+    auto nodeIt = m_nodes.find(m_trackOrder.at(pos));
+    if(nodeIt == m_nodes.end() || (m_sparseIndexes && nodeIt->second.index() != index)) {
+        return nullptr;
+    }
+
+    return &nodeIt->second;
 }
 
 std::vector<int> PlaylistModel::pixmapColumns() const
@@ -2243,11 +2706,15 @@ void PlaylistModel::coverUpdated(const Track& track)
     }
 }
 
-bool PlaylistModel::trackIsPlaying(const Track& track, int index) const
+bool PlaylistModel::trackIsPlaying(const PlaylistItem* item) const
 {
-    return m_currentPlayState != Player::PlayState::Stopped && m_currentPlaylist
-        && m_playingTrack.playlistId == m_currentPlaylist->id() && m_playingTrack.track.id() == track.id()
-        && m_playingTrack.indexInPlaylist == index;
+    if(m_currentPlayState == Player::PlayState::Stopped || !m_currentPlaylist
+       || m_playingTrack.playlistId != m_currentPlaylist->id()) {
+        return false;
+    }
+
+    const Track& track = std::get<PlaylistTrackItem>(item->data()).track().track;
+    return m_playingTrack.track.id() == track.id() && m_playingTrack.indexInPlaylist == playlistIndexOf(item);
 }
 
 ParentChildRangesList PlaylistModel::determineRowGroups(const QModelIndexList& indexes)
@@ -2314,11 +2781,8 @@ PlaylistModel::MoveOperationMap PlaylistModel::determineMoveOperationGroups(cons
 
 PlaylistModel::TrackItemResult PlaylistModel::itemForTrackIndex(int index)
 {
-    if(m_trackIndexes.contains(index)) {
-        const auto& key = m_trackIndexes.at(index);
-        if(m_nodes.contains(key)) {
-            return {&m_nodes.at(key), false};
-        }
+    if(PlaylistItem* item = itemAtPlaylistIndex(index)) {
+        return {item, false};
     }
 
     // End of playlist - return last track item
@@ -21,15 +21,21 @@
 
 #include "playlistcolumn.h"
 #include "playlistitem.h"
+#include "playlistmodelcache.h"
 #include "playlistpopulator.h"
 #include "playlistpreset.h"
 
 #include <core/player/playerdefs.h>
 #include <core/playlist/playlist.h>
+#include <utils/indexedsequence.h>
 #include <utils/treemodel.h>
 
 #include <QPixmap>
 #include <QThread>
+#include <QTimer>
+
+#include <deque>
+#include <unordered_set>
 
 namespace Fooyin {
 class CoverProvider;
@@ -157,8 +163,21 @@ private:
     void populateTrackGroup(PendingData& data);
     void updateModel(ItemKeyMap& data);
     void updateTracks(const ItemList& tracks);
+    void updateTrackText(const ItemList& tracks);
     void mergeTrackParents(const TrackIdNodeMap& parents);
 
+    void markTreeForCache(Playlist* nextPlaylist);
+    bool restoreCachedPlaylist(const PlaylistModelCacheKey& key, Playlist* playlist);
+    void releaseTree();
+    void invalidateCachedPlaylist(Playlist* playlist);
+    void invalidateCachedTracks(const TrackList& tracks);
+    void clearCache();
+
+    void requestTrackText(const PlaylistItem* item) const;
+    void queueTrackText(const UId& key) const;
+    void evaluateTrackText();
+    void clearTrackText();
+
     QVariant trackData(PlaylistItem* item, const QModelIndex& index, int role) const;
     QVariant headerData(PlaylistItem* item, int column, int role) const;
     QVariant subheaderData(PlaylistItem* item, int column, int role) const;
@@ -204,12 +223,16 @@ private:
     void removeEmptyHeaders();
     void mergeHeaders();
     void updateHeaders();
-    void updateTrackIndexes(bool updateItems = true);
     void deleteNodes(PlaylistItem* node);
 
+    void indexTracks(PlaylistItem* parent, int firstRow, int lastRow);
+    void unindexTracks(const PlaylistItemList& items);
+    int playlistIndexOf(const PlaylistItem* item) const;
+    PlaylistItem* itemAtPlaylistIndex(int index);
+
     std::vector<int> pixmapColumns() const;
     void coverUpdated(const Track& track);
-    bool trackIsPlaying(const Track& track, int index) const;
+    bool trackIsPlaying(const PlaylistItem* item) const;
 
     ParentChildRangesList determineRowGroups(const QModelIndexList& indexes);
 
@@ -249,7 +272,20 @@ private:
     bool m_playlistLoaded;
     ItemKeyMap m_nodes;
     TrackIdNodeMap m_trackParents;
-    std::map<int, UId> m_trackIndexes;
+    // Track keys in playlist order
+    IndexedSequence<UId, UId::UIdHash> m_trackOrder;
+    // True if tracks keep their own playlist indexes (e.g. a filtered view) rather than their position
+    bool m_sparseIndexes;
+
+    PlaylistModelCache m_cache;
+    std::optional<PlaylistModelCacheKey> m_treeKey;
+    std::optional<PlaylistModelCacheKey> m_releasedTreeKey;
+
+    mutable QTimer m_textTimer;
+    mutable std::unordered_set<UId, UId::UIdHash> m_textRequested;
+    mutable std::vector<UId> m_textQueue;
+    std::deque<UId> m_textEvaluated;
+    std::unordered_set<UId, UId::UIdHash> m_textEvaluatedKeys;
 
     PlaylistPreset m_currentPreset;
     PlaylistColumnList m_columns;
@@ -0,0 +1,163 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "playlistmodelcache.h"
+
+#include <algorithm>
+
+namespace {
+// Per-allocation overhead of a node in the standard associative containers
+constexpr size_t NodeOverhead = 4 * sizeof(void*);
+} // namespace
+
+namespace Fooyin {
+size_t PlaylistModelCacheEntry::cost() const
+{
+    size_t total{0};
+
+    for(const auto& [_, node] : nodes) {
+        total += sizeof(ItemKeyMap::value_type) + NodeOverhead;
+        total += static_cast<size_t>(node.childCount()) * sizeof(PlaylistItem*);
+
+        if(node.type() == PlaylistItem::Track) {
+            const auto& trackItem = std::get<PlaylistTrackItem>(node.data());
+            total += trackItem.columns().size() * (sizeof(RichScript) + sizeof(QSize));
+        }
+        else {
+            const auto& container = std::get<PlaylistContainerItem>(node.data());
+            total += static_cast<size_t>(container.trackCount()) * sizeof(Track);
+        }
+    }
+
+    for(const auto& [_, keys] : trackParents) {
+        total += sizeof(TrackIdNodeMap::value_type) + NodeOverhead + keys.size() * sizeof(UId);
+    }
+
+    total += static_cast<size_t>(trackOrder.size()) * (decltype(trackOrder)::valueCost() + NodeOverhead);
+
+    return total;
+}
+
+PlaylistModelCache::PlaylistModelCache()
+    : m_maxCost{0}
+    , m_totalCost{0}
+{ }
+
+size_t PlaylistModelCache::maxCost() const
+{
+    return m_maxCost;
+}
+
+size_t PlaylistModelCache::totalCost() const
+{
+    return m_totalCost;
+}
+
+int PlaylistModelCache::count() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+void PlaylistModelCache::setMaxCost(size_t bytes)
+{
+    m_maxCost = bytes;
+    trim();
+}
+
+void PlaylistModelCache::insert(PlaylistModelCacheEntry entry)
+{
+    remove(entry.key.playlistId);
+
+    const size_t cost = entry.cost();
+    if(cost > m_maxCost) {
+        return;
+    }
+
+    m_entries.push_front({std::move(entry), cost});
+    m_totalCost += cost;
+
+    trim();
+}
+
+std::optional<PlaylistModelCacheEntry> PlaylistModelCache::take(const PlaylistModelCacheKey& key)
+{
+    auto it = std::ranges::find_if(
+        m_entries, [&key](const CachedTree& tree) { return tree.entry.key.playlistId == key.playlistId; });
+    if(it == m_entries.end()) {
+        return {};
+    }
+
+    if(it->entry.key != key) {
+        // Preset or columns have changed since this tree was built
+        erase(it);
+        return {};
+    }
+
+    PlaylistModelCacheEntry entry = std::move(it->entry);
+    erase(it);
+
+    return entry;
+}
+
+void PlaylistModelCache::remove(const UId& playlistId)
+{
+    auto it = std::ranges::find_if(
+        m_entries, [&playlistId](const CachedTree& tree) { return tree.entry.key.playlistId == playlistId; });
+    if(it != m_entries.end()) {
+        erase(it);
+    }
+}
+
+void PlaylistModelCache::removeTracks(const TrackList& tracks)
+{
+    for(auto it = m_entries.begin(); it != m_entries.end();) {
+        const auto& parents = it->entry.trackParents;
+        const bool containsTrack
+            = std::ranges::any_of(tracks, [&parents](const Track& track) { return parents.contains(track.id()); });
+
+        if(containsTrack) {
+            auto next = std::next(it);
+            erase(it);
+            it = next;
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void PlaylistModelCache::clear()
+{
+    m_entries.clear();
+    m_totalCost = 0;
+}
+
+void PlaylistModelCache::erase(CachedTreeList::iterator it)
+{
+    m_totalCost -= it->cost;
+    m_entries.erase(it);
+}
+
+void PlaylistModelCache::trim()
+{
+    while(m_totalCost > m_maxCost && !m_entries.empty()) {
+        erase(std::prev(m_entries.end()));
+    }
+}
+} // namespace Fooyin
@@ -0,0 +1,106 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "playlistcolumn.h"
+#include "playlistitem.h"
+#include "playlistpopulator.h"
+#include "playlistpreset.h"
+
+#include <utils/id.h>
+#include <utils/indexedsequence.h>
+
+#include <list>
+#include <optional>
+
+namespace Fooyin {
+/*!
+ * Identifies what a populated tree was built from.
+ * A cached tree can only be reused for the same playlist, preset and columns.
+ */
+struct PlaylistModelCacheKey
+{
+    UId playlistId;
+    PlaylistPreset preset;
+    PlaylistColumnList columns;
+
+    bool operator==(const PlaylistModelCacheKey& other) const
+    {
+        return std::tie(playlistId, preset, columns) == std::tie(other.playlistId, other.preset, other.columns);
+    }
+};
+
+struct PlaylistModelCacheEntry
+{
+    PlaylistModelCacheKey key;
+
+    std::unique_ptr<PlaylistItem> root;
+    ItemKeyMap nodes;
+    TrackIdNodeMap trackParents;
+    IndexedSequence<UId, UId::UIdHash> trackOrder;
+    bool sparseIndexes{false};
+
+    /** Returns an estimate of the memory held by the tree in bytes. */
+    [[nodiscard]] size_t cost() const;
+};
+
+/*!
+ * Least-recently-used cache of populated playlist trees, bounded by an estimated memory budget.
+ * Used by PlaylistModel so that switching back to a recently viewed playlist doesn't repopulate it.
+ */
+class PlaylistModelCache
+{
+public:
+    PlaylistModelCache();
+
+    [[nodiscard]] size_t maxCost() const;
+    [[nodiscard]] size_t totalCost() const;
+    [[nodiscard]] int count() const;
+
+    void setMaxCost(size_t bytes);
+
+    void insert(PlaylistModelCacheEntry entry);
+    /*!
+     * Removes and returns the entry matching @p key.
+     * An entry for the same playlist built with a different preset or columns is dropped.
+     */
+    std::optional<PlaylistModelCacheEntry> take(const PlaylistModelCacheKey& key);
+
+    void remove(const UId& playlistId);
+    /** Removes all entries containing any of @p tracks. */
+    void removeTracks(const TrackList& tracks);
+    void clear();
+
+private:
+    struct CachedTree
+    {
+        PlaylistModelCacheEntry entry;
+        size_t cost;
+    };
+    using CachedTreeList = std::list<CachedTree>;
+
+    void erase(CachedTreeList::iterator it);
+    void trim();
+
+    CachedTreeList m_entries; // Most recently used first
+    size_t m_maxCost;
+    size_t m_totalCost;
+};
+} // namespace Fooyin
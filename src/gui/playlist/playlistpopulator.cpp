@@ -49,9 +49,12 @@ public:
 
     void updateContainers();
 
+    QString evaluateScript(const QString& script, const Track& track);
+
     void iterateHeader(const Track& track, PlaylistItem*& parent, int index);
     void iterateSubheaders(const Track& track, PlaylistItem*& parent, int index);
     void evaluateTrackScript(RichScript& script, const Track& track);
+    void evaluateTrackText(PlaylistTrackItem& trackItem);
     PlaylistItem* iterateTrack(const PlaylistTrack& track, int index);
 
     void runBatch(int size, int index);
@@ -66,6 +69,7 @@ public:
     PlaylistScriptRegistry* m_registry;
     ScriptParser m_parser;
     ScriptFormatter m_formatter;
+    std::unordered_map<QString, CompiledScript> m_compiledScripts;
 
     int m_trackDepth{0};
     Md5Hash m_prevBaseHeaderKey;
@@ -85,6 +89,7 @@ public:
 
 void PlaylistPopulatorPrivate::reset()
 {
+    m_compiledScripts.clear();
     m_data.clear();
     m_headers.clear();
     m_trackDepth = 0;
@@ -120,6 +125,15 @@ void PlaylistPopulatorPrivate::updateContainers()
     }
 }
 
+QString PlaylistPopulatorPrivate::evaluateScript(const QString& script, const Track& track)
+{
+    auto compiled = m_compiledScripts.find(script);
+    if(compiled == m_compiledScripts.end()) {
+        compiled = m_compiledScripts.emplace(script, m_parser.compile(script)).first;
+    }
+    return m_parser.evaluate(compiled->second, track);
+}
+
 void PlaylistPopulatorPrivate::iterateHeader(const Track& track, PlaylistItem*& parent, int index)
 {
     HeaderRow row{m_currentPreset.header};
@@ -129,7 +143,7 @@ void PlaylistPopulatorPrivate::iterateHeader(const Track& track, PlaylistItem*&
 
     auto evaluateBlocks = [this, track](RichScript& script) -> QString {
         script.text.clear();
-        const auto evalScript = m_parser.evaluate(script.script, track);
+        const auto evalScript = evaluateScript(script.script, track);
         if(!evalScript.isEmpty()) {
             script.text = m_formatter.evaluate(evalScript);
         }
@@ -174,9 +188,9 @@ void PlaylistPopulatorPrivate::iterateHeader(const Track& track, PlaylistItem*&
 void PlaylistPopulatorPrivate::iterateSubheaders(const Track& track, PlaylistItem*& parent, int index)
 {
     for(auto& subheader : m_currentPreset.subHeaders) {
-        const auto leftScript    = m_parser.evaluate(subheader.leftText.script, track);
+        const auto leftScript    = evaluateScript(subheader.leftText.script, track);
         subheader.leftText.text  = m_formatter.evaluate(leftScript);
-        const auto rightScript   = m_parser.evaluate(subheader.rightText.script, track);
+        const auto rightScript   = evaluateScript(subheader.rightText.script, track);
         subheader.rightText.text = m_formatter.evaluate(rightScript);
 
         PlaylistContainerItem currentContainer{false};
@@ -241,12 +255,37 @@ void PlaylistPopulatorPrivate::iterateSubheaders(const Track& track, PlaylistIte
 void PlaylistPopulatorPrivate::evaluateTrackScript(RichScript& script, const Track& track)
 {
     script.text.clear();
-    const auto evalScript = m_parser.evaluate(script.script, track);
+    const auto evalScript = evaluateScript(script.script, track);
     if(!evalScript.isEmpty()) {
         script.text = m_formatter.evaluate(evalScript);
     }
 }
 
+void PlaylistPopulatorPrivate::evaluateTrackText(PlaylistTrackItem& trackItem)
+{
+    const PlaylistTrack playlistTrack = trackItem.track();
+    m_registry->setTrackProperties(playlistTrack.indexInPlaylist, trackItem.depth());
+
+    auto columns = trackItem.columns();
+    if(!columns.empty()) {
+        for(auto& column : columns) {
+            evaluateTrackScript(column, playlistTrack.track);
+        }
+        trackItem.setColumns(columns);
+    }
+    else {
+        RichScript trackLeft{trackItem.left()};
+        RichScript trackRight{trackItem.right()};
+
+        evaluateTrackScript(trackLeft, playlistTrack.track);
+        evaluateTrackScript(trackRight, playlistTrack.track);
+
+        trackItem.setLeftRight(trackLeft, trackRight);
+    }
+
+    trackItem.calculateSize();
+}
+
 PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track, int index)
 {
     PlaylistItem* parent = &m_root;
@@ -258,25 +297,24 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
         return nullptr;
     }
 
-    m_registry->setTrackProperties(index, m_trackDepth);
-
     TrackRow trackRow{m_currentPreset.track};
     PlaylistTrackItem playlistTrack;
 
+    // Text is evaluated on demand once the row is displayed (see evaluateTracks)
     if(!m_columns.empty()) {
         for(const auto& column : m_columns) {
-            const auto evalScript = m_parser.evaluate(column.field, track.track);
-            trackRow.columns.emplace_back(column.field, m_formatter.evaluate(evalScript));
+            trackRow.columns.emplace_back(column.field, RichText{});
         }
         playlistTrack = {trackRow.columns, track};
     }
     else {
-        evaluateTrackScript(trackRow.leftText, track.track);
-        evaluateTrackScript(trackRow.rightText, track.track);
+        trackRow.leftText.text.clear();
+        trackRow.rightText.text.clear();
 
         playlistTrack = {trackRow.leftText, trackRow.rightText, track};
     }
 
+    playlistTrack.setTextPending(true);
     playlistTrack.setRowHeight(trackRow.rowHeight);
     playlistTrack.setDepth(m_trackDepth);
     playlistTrack.calculateSize();
@@ -287,6 +325,7 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
 
     auto* trackItem = getOrInsertItem(key, PlaylistItem::Track, playlistTrack, parent, baseKey);
     m_data.trackParents[track.track.id()].push_back(key);
+    m_data.trackOrder.push_back(key);
 
     m_trackDepth = 0;
     m_prevIndex  = index;
@@ -322,6 +361,7 @@ void PlaylistPopulatorPrivate::runBatch(int size, int index)
     m_pendingTracks = std::move(tempTracks);
 
     m_data.nodes.clear();
+    m_data.trackOrder.clear();
 
     const auto remaining = static_cast<int>(m_pendingTracks.size());
     runBatch(remaining, index);
@@ -429,7 +469,7 @@ void PlaylistPopulator::updateTracks(const UId& playlistId, const PlaylistPreset
         if(!columns.empty()) {
             std::vector<RichScript> trackColumns;
             for(const auto& column : columns) {
-                const auto evalScript = p->m_parser.evaluate(column.field, track.track);
+                const auto evalScript = p->evaluateScript(column.field, track.track);
                 trackColumns.emplace_back(column.field, p->m_formatter.evaluate(evalScript));
             }
             trackData.setColumns(trackColumns);
@@ -452,6 +492,29 @@ void PlaylistPopulator::updateTracks(const UId& playlistId, const PlaylistPreset
     setState(Idle);
 }
 
+void PlaylistPopulator::evaluateTracks(const UId& playlistId, const ItemList& tracks)
+{
+    setState(Running);
+
+    p->m_registry->setup(playlistId, p->m_playerController->playbackQueue());
+
+    ItemList evaluatedTracks;
+    evaluatedTracks.reserve(tracks.size());
+
+    for(const PlaylistItem& item : tracks) {
+        if(!mayRun()) {
+            break;
+        }
+        PlaylistTrackItem& trackData = std::get<0>(item.data());
+        p->evaluateTrackText(trackData);
+        evaluatedTracks.push_back(item);
+    }
+
+    emit tracksEvaluated(evaluatedTracks);
+
+    setState(Idle);
+}
+
 void PlaylistPopulator::updateHeaders(const ItemList& headers)
 {
     setState(Running);
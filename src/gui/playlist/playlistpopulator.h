@@ -45,6 +45,7 @@ struct PendingData
     ItemKeyMap items;
     NodeKeyMap nodes;
     std::vector<UId> containerOrder;
+    std::vector<UId> trackOrder;
     TrackIdNodeMap trackParents;
 
     QString parent;
@@ -58,6 +59,7 @@ struct PendingData
         items.clear();
         nodes.clear();
         containerOrder.clear();
+        trackOrder.clear();
         trackParents.clear();
         row = -1;
         indexNodes.clear();
@@ -81,12 +83,14 @@ public:
                    const std::map<int, PlaylistTrackList>& tracks);
     void updateTracks(const UId& playlistId, const PlaylistPreset& preset, const PlaylistColumnList& columns,
                       const TrackItemMap& tracks);
+    void evaluateTracks(const UId& playlistId, const ItemList& tracks);
     void updateHeaders(const ItemList& headers);
 
 signals:
     void populated(Fooyin::PendingData data);
     void populatedTrackGroup(Fooyin::PendingData data);
     void tracksUpdated(Fooyin::ItemList tracks);
+    void tracksEvaluated(Fooyin::ItemList tracks);
     void headersUpdated(Fooyin::ItemKeyMap headers);
 
 private:
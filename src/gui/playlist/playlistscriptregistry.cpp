@@ -149,6 +149,27 @@ ScriptResult PlaylistScriptRegistry::value(const QString& var, const Track& trac
     return ScriptRegistry::value(var, track);
 }
 
+ScriptRegistry::VariableFunc PlaylistScriptRegistry::bindVariable(const QString& var) const
+{
+    if(isListVariable(var)) {
+        return [](const Track& /*track*/) {
+            return ScriptResult{.value = QStringLiteral("|Loading|"), .cond = true};
+        };
+    }
+
+    if(const auto it = p->m_vars.find(var); it != p->m_vars.cend()) {
+        const auto* func = &it->second;
+        return [func](const Track& /*track*/) {
+            ScriptResult result;
+            result.value = (*func)();
+            result.cond  = !result.value.isEmpty();
+            return result;
+        };
+    }
+
+    return ScriptRegistry::bindVariable(var);
+}
+
 ScriptResult PlaylistScriptRegistry::calculateResult(FuncRet funcRet) const
 {
     ScriptResult result = ScriptRegistry::calculateResult(funcRet);
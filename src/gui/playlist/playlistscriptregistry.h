@@ -42,6 +42,7 @@ public:
 
     [[nodiscard]] bool isVariable(const QString& var, const Track& track) const override;
     [[nodiscard]] ScriptResult value(const QString& var, const Track& track) const override;
+    [[nodiscard]] VariableFunc bindVariable(const QString& var) const override;
 
 protected:
     [[nodiscard]] ScriptResult calculateResult(FuncRet funcRet) const override;
@@ -611,8 +611,13 @@ void PlaylistWidgetPrivate::resetModel() const
     switch(m_mode) {
         case(PlaylistWidget::Mode::Playlist):
             if(currentPlaylist) {
-                m_model->reset(m_currentPreset, m_singleMode ? PlaylistColumnList{} : m_columns, currentPlaylist,
-                               !m_search.isEmpty() ? m_filteredTracks : currentPlaylist->playlistTracks());
+                if(m_search.isEmpty()) {
+                    m_model->reset(m_currentPreset, m_singleMode ? PlaylistColumnList{} : m_columns, currentPlaylist);
+                }
+                else {
+                    m_model->reset(m_currentPreset, m_singleMode ? PlaylistColumnList{} : m_columns, currentPlaylist,
+                                   m_filteredTracks);
+                }
             }
             break;
         case(PlaylistWidget::Mode::DetachedPlaylist):
@@ -27,12 +27,10 @@
 #include <core/coresettings.h>
 #include <core/library/musiclibrary.h>
 #include <core/playlist/playlisthandler.h>
-#include <core/scripting/scriptparser.h>
 #include <gui/guiconstants.h>
 #include <gui/guisettings.h>
 #include <gui/widgets/popuplineedit.h>
 #include <utils/actions/actioncontainer.h>
-#include <utils/async.h>
 #include <utils/settings/settingsmanager.h>
 #include <utils/utils.h>
 
@@ -55,6 +53,7 @@ SearchWidget::SearchWidget(SearchController* controller, PlaylistController* pla
     , m_playlistHandler{m_playlistController->playlistHandler()}
     , m_library{library}
     , m_settings{settings}
+    , m_search{this}
     , m_searchBox{new QLineEdit(this)}
     , m_defaultPlaceholder{tr("Search library…")}
     , m_mode{SearchMode::Library}
@@ -76,6 +75,21 @@ SearchWidget::SearchWidget(SearchController* controller, PlaylistController* pla
 
     loadColours();
 
+    m_search.setSearchIndex(m_library->searchIndex());
+
+    // Previous results can't be refined once the tracks being searched have changed
+    const auto invalidateSearch = [this]() { m_search.invalidate(); };
+    QObject::connect(m_library, &MusicLibrary::tracksAdded, this, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksMetadataChanged, this, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksUpdated, this, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksDeleted, this, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksSorted, this, invalidateSearch);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksAdded, this, invalidateSearch);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksChanged, this, invalidateSearch);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::tracksRemoved, this, invalidateSearch);
+    QObject::connect(m_playlistHandler, &PlaylistHandler::playlistRemoved, this, invalidateSearch);
+    QObject::connect(m_playlistController, &PlaylistController::currentPlaylistChanged, this, invalidateSearch);
+
     QObject::connect(m_searchBox, &QLineEdit::textChanged, this, [this]() {
         if(m_autoSearch) {
             m_searchTimer.start((m_settings->value<Settings::Gui::SearchAutoDelay>() + 1) * 30, this);
@@ -451,19 +465,22 @@ void SearchWidget::searchChanged(bool enterKey)
 
     const auto mode = m_forceMode ? std::exchange(m_forceMode, {}).value() : m_mode; // NOLINT
 
-    Utils::asyncExec([search = m_searchBox->text(), tracks = getTracksToSearch(mode)]() {
-        ScriptParser parser;
-        return parser.filter(search, tracks);
-    }).then(this, [this, mode, enterKey](const PlaylistTrackList& filteredTracks) {
-        if(handleFilteredTracks(mode, filteredTracks) && enterKey) {
-            if(isQuickSearch() && m_settings->value<Settings::Gui::SearchSuccessClose>()) {
-                close();
-            }
-            else if(m_settings->value<Settings::Gui::SearchSuccessClear>()) {
-                m_searchBox->clear();
+    if(std::exchange(m_lastSearchMode, mode) != mode) {
+        m_search.invalidate();
+    }
+
+    m_search.search(
+        m_searchBox->text(), [this, mode]() { return getTracksToSearch(mode); },
+        [this, mode, enterKey](const PlaylistTrackList& filteredTracks) {
+            if(handleFilteredTracks(mode, filteredTracks) && enterKey) {
+                if(isQuickSearch() && m_settings->value<Settings::Gui::SearchSuccessClose>()) {
+                    close();
+                }
+                else if(m_settings->value<Settings::Gui::SearchSuccessClear>()) {
+                    m_searchBox->clear();
+                }
             }
-        }
-    });
+        });
 }
 
 void SearchWidget::changePlaceholderText()
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <core/playlist/playlist.h>
+#include <core/scripting/incrementalsearch.h>
 #include <core/track.h>
 #include <gui/fywidget.h>
 
@@ -100,6 +101,8 @@ private:
     SettingsManager* m_settings;
 
     QBasicTimer m_searchTimer;
+    IncrementalSearch<PlaylistTrackList> m_search;
+    std::optional<SearchMode> m_lastSearchMode;
     QLineEdit* m_searchBox;
     QString m_defaultPlaceholder;
     SearchMode m_mode;
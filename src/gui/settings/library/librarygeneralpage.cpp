@@ -40,6 +40,7 @@
 #include <QLabel>
 #include <QMenu>
 #include <QPushButton>
+#include <QSpinBox>
 
 namespace Fooyin {
 class LibraryTableView : public ExtendableTableView
@@ -103,6 +104,7 @@ private:
 
     QLineEdit* m_restrictTypes;
     QLineEdit* m_excludeTypes;
+    QSpinBox* m_scanThreads;
 
     QCheckBox* m_autoRefresh;
     QCheckBox* m_monitorLibraries;
@@ -122,6 +124,7 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     , m_model{new LibraryModel(m_libraryManager, this)}
     , m_restrictTypes{new QLineEdit(this)}
     , m_excludeTypes{new QLineEdit(this)}
+    , m_scanThreads{new QSpinBox(this)}
     , m_autoRefresh{new QCheckBox(tr("Auto refresh on startup"), this)}
     , m_monitorLibraries{new QCheckBox(tr("Monitor libraries"), this)}
     , m_markUnavailable{new QCheckBox(tr("Mark unavailable tracks on playback"), this)}
@@ -153,11 +156,17 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     fileTypesLayout->addWidget(new QLabel(QStringLiteral("🛈 e.g. \"mp3;m4a\""), this), row++, 1);
     fileTypesLayout->setColumnStretch(1, 1);
 
+    m_scanThreads->setRange(0, 64);
+    m_scanThreads->setSpecialValueText(tr("Auto"));
+    m_scanThreads->setToolTip(tr("Number of files to read in parallel when scanning"));
+
     auto* mainLayout = new QGridLayout(this);
 
     row = 0;
     mainLayout->addWidget(m_libraryView, row++, 0, 1, 2);
     mainLayout->addWidget(fileTypesGroup, row++, 0, 1, 2);
+    mainLayout->addWidget(new QLabel(tr("Scan threads") + u":", this), row, 0);
+    mainLayout->addWidget(m_scanThreads, row++, 1, Qt::AlignLeft);
     mainLayout->addWidget(m_autoRefresh, row++, 0, 1, 2);
     mainLayout->addWidget(m_monitorLibraries, row++, 0, 1, 2);
     mainLayout->addWidget(m_markUnavailable, row++, 0, 1, 2);
@@ -184,6 +193,7 @@ void LibraryGeneralPageWidget::load()
 
     m_restrictTypes->setText(restrictExtensions.join(u';'));
     m_excludeTypes->setText(excludeExtensions.join(u';'));
+    m_scanThreads->setValue(m_settings->fileValue(Settings::Core::Internal::LibraryScanThreads, 0).toInt());
 
     m_autoRefresh->setChecked(m_settings->value<Settings::Core::AutoRefresh>());
     m_monitorLibraries->setChecked(m_settings->value<Settings::Core::Internal::MonitorLibraries>());
@@ -203,6 +213,7 @@ void LibraryGeneralPageWidget::apply()
                         m_restrictTypes->text().split(u';', Qt::SkipEmptyParts));
     m_settings->fileSet(Settings::Core::Internal::LibraryExcludeTypes,
                         m_excludeTypes->text().split(u';', Qt::SkipEmptyParts));
+    m_settings->fileSet(Settings::Core::Internal::LibraryScanThreads, m_scanThreads->value());
 
     m_settings->set<Settings::Core::AutoRefresh>(m_autoRefresh->isChecked());
     m_settings->set<Settings::Core::Internal::MonitorLibraries>(m_monitorLibraries->isChecked());
@@ -217,6 +228,7 @@ void LibraryGeneralPageWidget::reset()
 {
     m_settings->fileRemove(Settings::Core::Internal::LibraryRestrictTypes);
     m_settings->fileRemove(Settings::Core::Internal::LibraryExcludeTypes);
+    m_settings->fileRemove(Settings::Core::Internal::LibraryScanThreads);
 
     m_settings->reset<Settings::Core::AutoRefresh>();
     m_settings->reset<Settings::Core::Internal::MonitorLibraries>();
@@ -36,6 +36,7 @@
 #include <QFileDialog>
 #include <QGridLayout>
 #include <QGroupBox>
+#include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
 #include <QSpinBox>
@@ -69,6 +70,7 @@ private:
     QCheckBox* m_tabsClearButton;
     QCheckBox* m_tabsCloseButton;
     QCheckBox* m_tabsMiddleClose;
+    QSpinBox* m_modelCacheSize;
 
     QSpinBox* m_imagePadding;
     QSpinBox* m_imagePaddingTop;
@@ -92,6 +94,7 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     , m_tabsClearButton{new QCheckBox(tr("Show clear button"), this)}
     , m_tabsCloseButton{new QCheckBox(tr("Show delete button on tabs"), this)}
     , m_tabsMiddleClose{new QCheckBox(tr("Delete playlists on middle click"), this)}
+    , m_modelCacheSize{new QSpinBox(this)}
     , m_imagePadding{new QSpinBox(this)}
     , m_imagePaddingTop{new QSpinBox(this)}
     , m_autoExporting{new QGroupBox(tr("Auto-export"), this)}
@@ -117,6 +120,11 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     m_imagePaddingTop->setMaximum(100);
     m_imagePaddingTop->setSuffix(QStringLiteral("px"));
 
+    m_modelCacheSize->setMinimum(0);
+    m_modelCacheSize->setMaximum(1024);
+    m_modelCacheSize->setSuffix(QStringLiteral(" MB"));
+    m_modelCacheSize->setToolTip(tr("Memory used to keep recently viewed playlists loaded for faster switching"));
+
     auto* saving       = new QGroupBox(tr("Saving"), this);
     auto* savingLayout = new QGridLayout(saving);
 
@@ -178,6 +186,12 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     tabsGroupLayout->addWidget(m_tabsCloseButton, row++, 0);
     tabsGroupLayout->addWidget(m_tabsMiddleClose, row++, 0);
 
+    auto* cacheSizeLayout = new QHBoxLayout();
+    cacheSizeLayout->addWidget(new QLabel(tr("Playlist cache size") + u":", this));
+    cacheSizeLayout->addWidget(m_modelCacheSize);
+    cacheSizeLayout->addStretch();
+    tabsGroupLayout->addLayout(cacheSizeLayout, row++, 0);
+
     auto* mainLayout = new QGridLayout(this);
 
     row = 0;
@@ -237,6 +251,7 @@ void PlaylistGeneralPageWidget::load()
     m_tabsClearButton->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistTabsClearButton>());
     m_tabsCloseButton->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistTabsCloseButton>());
     m_tabsMiddleClose->setChecked(m_settings->value<Settings::Gui::Internal::PlaylistTabsMiddleClose>());
+    m_modelCacheSize->setValue(m_settings->value<Settings::Gui::Internal::PlaylistModelCacheSize>());
 
     m_imagePadding->setValue(m_settings->value<Settings::Gui::Internal::PlaylistImagePadding>());
     m_imagePaddingTop->setValue(m_settings->value<Settings::Gui::Internal::PlaylistImagePaddingTop>());
@@ -262,6 +277,7 @@ void PlaylistGeneralPageWidget::apply()
     m_settings->set<Settings::Gui::Internal::PlaylistTabsClearButton>(m_tabsClearButton->isChecked());
     m_settings->set<Settings::Gui::Internal::PlaylistTabsCloseButton>(m_tabsCloseButton->isChecked());
     m_settings->set<Settings::Gui::Internal::PlaylistTabsMiddleClose>(m_tabsMiddleClose->isChecked());
+    m_settings->set<Settings::Gui::Internal::PlaylistModelCacheSize>(m_modelCacheSize->value());
 
     m_settings->set<Settings::Gui::Internal::PlaylistImagePadding>(m_imagePadding->value());
     m_settings->set<Settings::Gui::Internal::PlaylistImagePaddingTop>(m_imagePaddingTop->value());
@@ -287,6 +303,7 @@ void PlaylistGeneralPageWidget::reset()
     m_settings->reset<Settings::Gui::Internal::PlaylistTabsClearButton>();
     m_settings->reset<Settings::Gui::Internal::PlaylistTabsCloseButton>();
     m_settings->reset<Settings::Gui::Internal::PlaylistTabsMiddleClose>();
+    m_settings->reset<Settings::Gui::Internal::PlaylistModelCacheSize>();
 
     m_settings->reset<Settings::Gui::Internal::PlaylistImagePadding>();
     m_settings->reset<Settings::Gui::Internal::PlaylistImagePaddingTop>();
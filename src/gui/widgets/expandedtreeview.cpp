@@ -19,6 +19,7 @@
 
 #include <gui/widgets/expandedtreeview.h>
 
+#include <utils/fenwicktree.h>
 #include <utils/utils.h>
 
 #include <QDrag>
@@ -605,16 +606,23 @@ public:
 private:
     [[nodiscard]] int indexRowSizeHint(const QModelIndex& index) const;
     [[nodiscard]] int indexSizeHint(const QModelIndex& index, bool span = false) const;
+    [[nodiscard]] const FenwickTree& rowOffsets() const;
+    void updateRowOffset(int item) const;
     void recalculatePadding();
     void drawAndClipSpans(QPainter* painter, const QStyleOptionViewItem& option, int firstVisibleItem,
                           int firstVisibleItemOffset) const;
     void adjustViewOptionsForIndex(QStyleOptionViewItem* option, const QModelIndex& currentIndex) const;
+
+    // Height + padding of each item, used to map between items and offsets when rows aren't uniform
+    mutable FenwickTree m_rowOffsets;
+    mutable bool m_rowOffsetsDirty{true};
 };
 
 void TreeView::invalidate()
 {
     m_uniformRowHeight = 0;
     m_p->m_uniformRoleHeights.clear();
+    m_rowOffsetsDirty = true;
 }
 
 void TreeView::drawView(QPainter* painter, const QRegion& region) const
@@ -783,6 +791,7 @@ void TreeView::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottom
             const int oldHeight = itemHeight(topViewIndex);
             m_p->invalidateHeightCache(topViewIndex);
             sizeChanged |= (oldHeight != itemHeight(topViewIndex));
+            updateRowOffset(topViewIndex);
             if(topLeft.column() == 0) {
                 viewItem(topViewIndex).hasChildren = m_p->hasVisibleChildren(topLeft);
             }
@@ -793,6 +802,7 @@ void TreeView::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottom
                 const int oldHeight = itemHeight(i);
                 m_p->invalidateHeightCache(i);
                 sizeChanged |= (oldHeight != itemHeight(i));
+                updateRowOffset(i);
                 if(topLeft.column() == 0) {
                     viewItem(i).hasChildren = m_p->hasVisibleChildren(viewItem(i).index);
                 }
@@ -919,18 +929,17 @@ int TreeView::firstVisibleItem(int* offset) const
         return value / m_uniformRowHeight;
     }
 
-    int y{0};
-    for(int i{0}; i < count; ++i) {
-        const int height = itemHeight(i) + itemPadding(i);
-        y += height;
-        if(y > value) {
-            if(offset) {
-                *offset = y - value - height;
-            }
-            return i;
-        }
+    const FenwickTree& offsets = rowOffsets();
+
+    const int item = offsets.indexAt(value);
+    if(item >= count) {
+        return -1;
     }
-    return -1;
+
+    if(offset) {
+        *offset = offsets.prefixSum(item) - value;
+    }
+    return item;
 }
 
 int TreeView::lastVisibleItem(int firstVisual, int offset) const
@@ -964,12 +973,8 @@ QPoint TreeView::coordinateForItem(int item) const
         if(m_p->m_uniformRowHeights) {
             return {0, (item * m_uniformRowHeight) - vertScrollValue};
         }
-        const auto& items = viewItems();
-        for(int index{0}, y{0}; const auto& viewItem : items) {
-            if(index == item) {
-                return {0, y - vertScrollValue};
-            }
-            y += itemHeight(index++) + viewItem.padding;
+        if(item >= 0 && item < itemCount()) {
+            return {0, rowOffsets().prefixSum(item) - vertScrollValue};
         }
     }
     else {
@@ -1025,19 +1030,18 @@ int TreeView::itemAtCoordinate(QPoint coordinate, bool includePadding) const
 
         const int contentsCoord = coordinate.y() + vertScrollValue;
 
-        int itemCoord{0};
-        for(int index{0}; index < count; ++index) {
-            const int height  = itemHeight(index);
-            const int padding = itemPadding(index);
-            itemCoord += height + padding;
+        const FenwickTree& offsets = rowOffsets();
 
-            if(itemCoord > contentsCoord) {
-                if(includePadding && (itemCoord - padding) < contentsCoord) {
-                    return -1;
-                }
-                return index >= count ? -1 : index;
-            }
+        const int index = offsets.indexAt(contentsCoord);
+        if(index >= count) {
+            return -1;
         }
+
+        const int itemCoord = offsets.prefixSum(index + 1);
+        if(includePadding && (itemCoord - itemPadding(index)) < contentsCoord) {
+            return -1;
+        }
+        return index;
     }
     else {
         const int topViewItemIndex{vertScrollValue};
@@ -1229,10 +1233,7 @@ void TreeView::updateScrollBars()
         verticalBar->setSingleStep(1);
     }
     else {
-        int contentsHeight{0};
-        for(int i{0}; i < count; ++i) {
-            contentsHeight += itemHeight(i) + itemPadding(i);
-        }
+        const int contentsHeight = rowOffsets().total();
 
         const int vMax = contentsHeight - viewportHeight;
         if(verticalBar->isVisible() && vMax <= 0) {
@@ -1587,8 +1588,33 @@ int TreeView::indexSizeHint(const QModelIndex& index, bool span) const
     return height;
 }
 
+const FenwickTree& TreeView::rowOffsets() const
+{
+    const int count = itemCount();
+
+    if(m_rowOffsetsDirty || m_rowOffsets.size() != count) {
+        std::vector<int> heights(count);
+        for(int i{0}; i < count; ++i) {
+            heights[i] = itemHeight(i) + itemPadding(i);
+        }
+        m_rowOffsets.assign(std::move(heights));
+        m_rowOffsetsDirty = false;
+    }
+
+    return m_rowOffsets;
+}
+
+void TreeView::updateRowOffset(int item) const
+{
+    if(!m_rowOffsetsDirty && item >= 0 && item < m_rowOffsets.size()) {
+        m_rowOffsets.set(item, itemHeight(item) + itemPadding(item));
+    }
+}
+
 void TreeView::recalculatePadding()
 {
+    m_rowOffsetsDirty = true;
+
     if(empty()) {
         return;
     }
@@ -3119,7 +3145,9 @@ bool ExpandedTreeView::uniformRowHeights() const
 
 void ExpandedTreeView::setUniformRowHeights(bool enabled)
 {
-    p->m_uniformRowHeights = enabled;
+    if(std::exchange(p->m_uniformRowHeights, enabled) != enabled && p->m_view) {
+        p->m_view->invalidate();
+    }
 }
 
 int ExpandedTreeView::uniformHeightRole() const
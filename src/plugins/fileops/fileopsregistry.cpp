@@ -30,6 +30,15 @@ ScriptResult FileOpsRegistry::value(const QString& var, const Track& track) cons
     return result;
 }
 
+ScriptRegistry::VariableFunc FileOpsRegistry::bindVariable(const QString& var) const
+{
+    return [func = ScriptRegistry::bindVariable(var)](const Track& track) {
+        ScriptResult result = func(track);
+        result.value        = replaceSeparators(result.value);
+        return result;
+    };
+}
+
 QString FileOpsRegistry::replaceSeparators(const QString& input)
 {
     static const QRegularExpression regex{QStringLiteral(R"([/\\])")};
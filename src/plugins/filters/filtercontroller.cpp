@@ -28,6 +28,7 @@
 #include <core/library/musiclibrary.h>
 #include <core/library/tracksort.h>
 #include <core/plugins/coreplugincontext.h>
+#include <core/scripting/incrementalsearch.h>
 #include <core/scripting/scriptparser.h>
 #include <gui/coverprovider.h>
 #include <gui/editablelayout.h>
@@ -93,7 +94,8 @@ public:
     void removeLibraryTracks(int libraryId);
     void handleTracksAddedUpdated(const TrackList& tracks, bool updated = false);
     void refreshFilters(const Id& groupId);
-    void searchChanged(FilterWidget* filter, const QString& search) const;
+    void searchChanged(FilterWidget* filter, const QString& search);
+    void invalidateSearches();
 
     FilterController* m_self;
 
@@ -111,6 +113,7 @@ public:
     Id m_defaultId{"Default"};
     FilterGroups m_groups;
     std::unordered_map<Id, FilterWidget*, Id::IdHash> m_ungrouped;
+    std::unordered_map<Id, std::unique_ptr<IncrementalSearch<TrackList>>, Id::IdHash> m_searches;
 
     TrackAction m_doubleClickAction;
     TrackAction m_middleClickAction;
@@ -416,8 +419,9 @@ void FilterControllerPrivate::handleTracksAddedUpdated(const TrackList& tracks,
             }
 
             if(!filterWidget->searchFilter().isEmpty()) {
-                Utils::asyncExec([search = filterWidget->searchFilter(), tracks]() {
+                Utils::asyncExec([search = filterWidget->searchFilter(), tracks, index = m_library->searchIndex()]() {
                     ScriptParser parser;
+                    parser.setSearchIndex(index);
                     return parser.filter(search, tracks);
                 }).then(m_self, [filterWidget, updated](const TrackList& filteredTracks) {
                     if(updated) {
@@ -480,7 +484,7 @@ void FilterControllerPrivate::refreshFilters(const Id& groupId)
     }
 }
 
-void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString& search) const
+void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString& search)
 {
     const Id groupId = filter->group();
 
@@ -488,16 +492,29 @@ void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString&
         return;
     }
 
+    auto& filterSearch = m_searches[filter->id()];
+    if(!filterSearch) {
+        filterSearch = std::make_unique<IncrementalSearch<TrackList>>(m_self);
+        filterSearch->setSearchIndex(m_library->searchIndex());
+    }
+
     if(search.length() < 1) {
+        filterSearch->cancel();
+        filterSearch->invalidate();
         filter->reset(m_library->tracks());
         return;
     }
 
-    const TrackList tracksToFilter = m_library->tracks();
-    Utils::asyncExec([search, tracksToFilter]() {
-        ScriptParser parser;
-        return parser.filter(search, tracksToFilter);
-    }).then(m_self, [filter](const TrackList& filteredTracks) { filter->reset(filteredTracks); });
+    filterSearch->search(
+        search, [this]() { return m_library->tracks(); },
+        [filter](const TrackList& filteredTracks) { filter->reset(filteredTracks); });
+}
+
+void FilterControllerPrivate::invalidateSearches()
+{
+    for(auto& filterSearch : m_searches | std::views::values) {
+        filterSearch->invalidate();
+    }
 }
 
 FilterController::FilterController(const CorePluginContext& core, TrackSelectionController* trackSelection,
@@ -515,6 +532,15 @@ FilterController::FilterController(const CorePluginContext& core, TrackSelection
     QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, &FilterController::tracksRemoved);
     QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, [this]() { p->resetAll(); });
     QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this, [this]() { p->resetAll(); });
+
+    // Previous search results can't be refined once the library has changed
+    const auto invalidateSearches = [this]() { p->invalidateSearches(); };
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this, invalidateSearches);
 }
 
 FilterController::~FilterController() = default;
@@ -606,6 +632,8 @@ void FilterController::addFilterToGroup(FilterWidget* widget, const Id& groupId)
 
 bool FilterController::removeFilter(FilterWidget* widget)
 {
+    p->m_searches.erase(widget->id());
+
     const Id groupId = widget->group();
 
     if(!groupId.isValid() && p->m_ungrouped.contains(widget->id())) {
@@ -57,7 +57,7 @@ void FilterPopulator::run(const QStringList& columns, const TrackList& tracks, b
 
 FilterItem* FilterPopulator::getOrInsertItem(const QStringList& columns)
 {
-    const auto key = Utils::generateMd5Hash(columns.join(QString{}));
+    const auto key = Utils::generateKeyHash(columns);
     if(!m_data.items.contains(key)) {
         m_data.items.emplace(key, FilterItem{key, columns, &m_root});
     }
@@ -100,7 +100,7 @@ void FilterPopulator::iterateTrack(const Track& track)
     }
 }
 
-bool FilterPopulator::runBatch(const TrackList& tracks)
+bool FilterPopulator::runBatch(std::span<const Track> tracks)
 {
     for(const Track& track : tracks) {
         if(!mayRun()) {
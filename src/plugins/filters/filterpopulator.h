@@ -25,6 +25,8 @@
 #include <core/track.h>
 #include <utils/worker.h>
 
+#include <span>
+
 namespace Fooyin::Filters {
 using ItemKeyMap     = std::map<Md5Hash, FilterItem>;
 using TrackIdNodeMap = std::unordered_map<int, std::vector<Md5Hash>>;
@@ -58,7 +60,7 @@ private:
     std::vector<FilterItem*> getOrInsertItems(const QList<QStringList>& columnSet);
     void addTrackToNode(const Track& track, FilterItem* node);
     void iterateTrack(const Track& track);
-    bool runBatch(const TrackList& tracks);
+    bool runBatch(std::span<const Track> tracks);
 
     ScriptParser m_parser;
 
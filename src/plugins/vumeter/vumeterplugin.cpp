@@ -47,9 +47,7 @@ void VuMeterPlugin::initialise(const GuiPluginContext& context)
     m_widgetProvider->registerWidget(
         QStringLiteral("VUMeter"),
         [this]() {
-            auto* meter = new VuMeterWidget(VuMeterWidget::Type::Rms, m_playerController, m_settings);
-            QObject::connect(m_engine, &EngineController::bufferPlayed, meter, &VuMeterWidget::renderBuffer);
-            return meter;
+            return new VuMeterWidget(VuMeterWidget::Type::Rms, m_engine->analysis(), m_playerController, m_settings);
         },
         QStringLiteral("VU Meter"));
     m_widgetProvider->setSubMenus(QStringLiteral("VUMeter"), {tr("Visualisations")});
@@ -57,9 +55,7 @@ void VuMeterPlugin::initialise(const GuiPluginContext& context)
     m_widgetProvider->registerWidget(
         QStringLiteral("PeakMeter"),
         [this]() {
-            auto* meter = new VuMeterWidget(VuMeterWidget::Type::Peak, m_playerController, m_settings);
-            QObject::connect(m_engine, &EngineController::bufferPlayed, meter, &VuMeterWidget::renderBuffer);
-            return meter;
+            return new VuMeterWidget(VuMeterWidget::Type::Peak, m_engine->analysis(), m_playerController, m_settings);
         },
         QStringLiteral("Peak Meter"));
     m_widgetProvider->setSubMenus(QStringLiteral("PeakMeter"), {tr("Visualisations")});
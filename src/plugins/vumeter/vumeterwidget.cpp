@@ -22,11 +22,9 @@
 #include "vumetercolours.h"
 #include "vumetersettings.h"
 
-#include <core/engine/audiobuffer.h>
-#include <core/engine/audioconverter.h>
+#include <core/engine/audioanalysis.h>
 #include <core/player/playercontroller.h>
 #include <gui/guisettings.h>
-#include <utils/async.h>
 #include <utils/settings/settingsdialogcontroller.h>
 #include <utils/settings/settingsmanager.h>
 
@@ -38,7 +36,7 @@
 #include <QPainter>
 #include <QTimerEvent>
 
-constexpr auto MaxChannels    = 20;
+constexpr auto MaxChannels    = Fooyin::AudioAnalysis::MaxChannels;
 constexpr auto UpdateInterval = 25;
 constexpr auto MinDb          = -60.0F;
 constexpr auto MaxDb          = 3.0F;
@@ -89,11 +87,13 @@ namespace Fooyin::VuMeter {
 class VuMeterWidgetPrivate
 {
 public:
-    explicit VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type, PlayerController* playerController,
-                                  SettingsManager* settings);
+    explicit VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type, AudioAnalysis* analysis,
+                                  PlayerController* playerController, SettingsManager* settings);
+    ~VuMeterWidgetPrivate();
 
     void reset();
     void updateSize();
+    void readLevels();
     void calculatePeak();
     void updateChannelLevels(int channel, qint64 elapsedTime, qint64 peakTime, float falloff, bool& zeroLevel);
     QRect calculateUpdateRect(int channel);
@@ -118,9 +118,11 @@ public:
     void playStateChanged(Player::PlayState state);
 
     VuMeterWidget* m_self;
+    AudioAnalysis* m_analysis;
     PlayerController* m_playerController;
     SettingsManager* m_settings;
 
+    int m_analysisUser{-1};
     AudioFormat m_format;
     std::array<float, MaxChannels> m_channelDbLevels;
     std::array<float, MaxChannels> m_channelPeaks;
@@ -153,9 +155,10 @@ public:
     std::array<float, MaxChannels> m_previousChannelPeaks{0.0F};
 };
 
-VuMeterWidgetPrivate::VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type,
+VuMeterWidgetPrivate::VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::Type type, AudioAnalysis* analysis,
                                            PlayerController* playerController, SettingsManager* settings)
     : m_self{self}
+    , m_analysis{analysis}
     , m_playerController{playerController}
     , m_settings{settings}
     , m_type{type}
@@ -166,7 +169,7 @@ VuMeterWidgetPrivate::VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::T
     , m_sectionSpacing{static_cast<float>(m_settings->value<Settings::VuMeter::SectionSpacing>())}
     , m_colours{m_settings->value<Settings::VuMeter::MeterColours>().value<Colours>()}
 {
-    m_format.setSampleFormat(SampleFormat::F32);
+    m_analysisUser = m_analysis->addUser();
 
     playStateChanged(m_playerController->playState());
 
@@ -179,6 +182,11 @@ VuMeterWidgetPrivate::VuMeterWidgetPrivate(VuMeterWidget* self, VuMeterWidget::T
     updateSize();
 }
 
+VuMeterWidgetPrivate::~VuMeterWidgetPrivate()
+{
+    m_analysis->removeUser(m_analysisUser);
+}
+
 void VuMeterWidgetPrivate::reset()
 {
     std::ranges::fill(m_channelDbLevels, MinDb);
@@ -222,8 +230,41 @@ void VuMeterWidgetPrivate::updateSize()
     createGradient();
 }
 
+void VuMeterWidgetPrivate::readLevels()
+{
+    // Levels are held at their maximum since the last read, so buffers rendered between repaints aren't missed.
+    // Nothing rendered since then reads as silence, which leaves the current levels to fall off.
+    const AudioAnalysis::Levels levels = m_analysis->takeLevels(m_analysisUser);
+    if(levels.sequence == 0) {
+        return;
+    }
+
+    const int channels = levels.channels;
+    m_format.setChannelCount(channels);
+    m_lastPeakTimers.resize(channels);
+
+    const auto& channelLevels = m_type == VuMeterWidget::Type::Peak ? levels.peak : levels.rms;
+
+    for(int i{0}; i < channels; ++i) {
+        const float bufferDb = dbOnRange(20 * std::log10(channelLevels.at(i)));
+
+        float& channelLevel = m_channelDbLevels.at(i);
+        float& channelPeak  = m_channelPeaks.at(i);
+
+        if(bufferDb > channelLevel) {
+            channelLevel = bufferDb;
+        }
+        if(bufferDb > channelPeak) {
+            channelPeak = bufferDb;
+            m_lastPeakTimers.at(i).start();
+        }
+    }
+}
+
 void VuMeterWidgetPrivate::calculatePeak()
 {
+    readLevels();
+
     const qint64 elapsedTime = m_elapsedTimer.restart();
     const auto peakTime      = static_cast<qint64>(m_settings->value<Settings::VuMeter::PeakHoldTime>() * 1000);
     const auto falloff       = static_cast<float>(m_settings->value<Settings::VuMeter::FalloffTime>() / 1000.0);
@@ -597,9 +638,10 @@ void VuMeterWidgetPrivate::playStateChanged(Player::PlayState state)
     }
 }
 
-VuMeterWidget::VuMeterWidget(Type type, PlayerController* playerController, SettingsManager* settings, QWidget* parent)
+VuMeterWidget::VuMeterWidget(Type type, AudioAnalysis* analysis, PlayerController* playerController,
+                             SettingsManager* settings, QWidget* parent)
     : FyWidget{parent}
-    , p{std::make_unique<VuMeterWidgetPrivate>(this, type, playerController, settings)}
+    , p{std::make_unique<VuMeterWidgetPrivate>(this, type, analysis, playerController, settings)}
 {
     setObjectName(VuMeterWidget::name());
 
@@ -651,68 +693,6 @@ void VuMeterWidget::loadLayoutData(const QJsonObject& layout)
     }
 }
 
-void VuMeterWidget::renderBuffer(const AudioBuffer& buffer)
-{
-    p->m_format.setSampleRate(buffer.format().sampleRate());
-    const int channels = buffer.format().channelCount();
-    p->m_format.setChannelCount(channels);
-
-    const AudioBuffer normalisedBuffer = Audio::convert(buffer, p->m_format);
-
-    p->m_lastPeakTimers.resize(channels);
-
-    auto calculatePeaks = Utils::asyncExec([this, normalisedBuffer, channels]() {
-        const int totalSamples = normalisedBuffer.sampleCount();
-        const int bps          = normalisedBuffer.format().bytesPerSample();
-
-        std::array<float, MaxChannels> peaks{0.0F};
-        std::array<int, MaxChannels> sampleCounts{0};
-
-        for(int i{0}; i < totalSamples; ++i) {
-            const int sampleIndex  = i / channels;
-            const int channelIndex = i % channels;
-
-            float sample;
-            const auto offset = (sampleIndex * channels + channelIndex) * bps;
-            std::memcpy(&sample, normalisedBuffer.data() + offset, bps);
-
-            if(p->m_type == Type::Peak) {
-                peaks.at(channelIndex) = std::max(peaks.at(channelIndex), std::abs(sample));
-            }
-            else {
-                peaks.at(channelIndex) += sample * sample;
-                sampleCounts.at(channelIndex)++;
-            }
-        }
-
-        if(p->m_type == Type::Rms) {
-            for(int i{0}; i < channels; ++i) {
-                peaks.at(i) = std::sqrt(peaks.at(i) / static_cast<float>(sampleCounts.at(i)));
-            }
-        }
-
-        return peaks;
-    });
-
-    calculatePeaks.then(this, [this, channels](const std::array<float, MaxChannels>& peaks) {
-        for(int i{0}; i < channels; ++i) {
-            const float bufferRMS = peaks.at(i);
-            const float bufferDb  = dbOnRange(20 * std::log10(bufferRMS));
-
-            float& channelLevel = p->m_channelDbLevels.at(i);
-            float& channelPeak  = p->m_channelPeaks.at(i);
-
-            if(bufferDb > channelLevel) {
-                channelLevel = bufferDb;
-            }
-            if(bufferDb > channelPeak) {
-                channelPeak = bufferDb;
-                p->m_lastPeakTimers.at(i).start();
-            }
-        }
-    });
-}
-
 void VuMeterWidget::setOrientation(Qt::Orientation orientation)
 {
     p->m_orientation = orientation;
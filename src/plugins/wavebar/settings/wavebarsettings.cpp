@@ -42,5 +42,7 @@ WaveBarSettings::WaveBarSettings(SettingsManager* settingsManager)
     m_settings->createSetting<CentreGap>(0, QStringLiteral("WaveBar/CentreGap"));
     m_settings->createSetting<ChannelScale>(0.9, QStringLiteral("WaveBar/ChannelScale"));
     m_settings->createSetting<NumSamples>(2048, QStringLiteral("WaveBar/NumSamples"));
+    m_settings->createSetting<PregenerateCount>(3, QStringLiteral("WaveBar/PregenerateCount"));
+    m_settings->createSetting<PregenerateLibrary>(false, QStringLiteral("WaveBar/PregenerateLibrary"));
 }
 } // namespace Fooyin::WaveBar
@@ -74,6 +74,8 @@ private:
 
     QLabel* m_cacheSizeLabel;
     QComboBox* m_numSamples;
+    QSpinBox* m_pregenerateCount;
+    QCheckBox* m_pregenerateLibrary;
 };
 
 WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
@@ -93,6 +95,8 @@ WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
     , m_centreGap{new QSpinBox(this)}
     , m_cacheSizeLabel{new QLabel(this)}
     , m_numSamples{new QComboBox(this)}
+    , m_pregenerateCount{new QSpinBox(this)}
+    , m_pregenerateLibrary{new QCheckBox(tr("Generate for entire library when idle"), this)}
 {
     auto* layout = new QGridLayout(this);
 
@@ -197,10 +201,26 @@ WaveBarSettingsPageWidget::WaveBarSettingsPageWidget(SettingsManager* settings)
     numSamplesLabel->setToolTip(numSamplesTip);
     m_numSamples->setToolTip(numSamplesTip);
 
-    generalGroupLayout->addWidget(numSamplesLabel, 0, 0);
-    generalGroupLayout->addWidget(m_numSamples, 0, 1);
-    generalGroupLayout->addWidget(m_cacheSizeLabel, 1, 0);
-    generalGroupLayout->addWidget(clearCacheButton, 1, 1);
+    auto* pregenerateLabel = new QLabel(tr("Generate ahead") + QStringLiteral(":"), this);
+    const QString pregenerateTip{tr("Number of upcoming tracks in the playing \n"
+                                    "playlist to generate waveform data for \n"
+                                    "in the background.")};
+
+    m_pregenerateCount->setMinimum(0);
+    m_pregenerateCount->setMaximum(50);
+    m_pregenerateCount->setSuffix(QStringLiteral(" ") + tr("tracks"));
+
+    pregenerateLabel->setToolTip(pregenerateTip);
+    m_pregenerateCount->setToolTip(pregenerateTip);
+
+    row = 0;
+    generalGroupLayout->addWidget(numSamplesLabel, row, 0);
+    generalGroupLayout->addWidget(m_numSamples, row++, 1);
+    generalGroupLayout->addWidget(pregenerateLabel, row, 0);
+    generalGroupLayout->addWidget(m_pregenerateCount, row++, 1);
+    generalGroupLayout->addWidget(m_pregenerateLibrary, row++, 0, 1, 2);
+    generalGroupLayout->addWidget(m_cacheSizeLabel, row, 0);
+    generalGroupLayout->addWidget(clearCacheButton, row++, 1);
     generalGroupLayout->setColumnStretch(2, 1);
 
     row = 0;
@@ -242,6 +262,8 @@ void WaveBarSettingsPageWidget::load()
     updateCacheSize();
     const int samples = m_settings->value<Settings::WaveBar::NumSamples>();
     m_numSamples->setCurrentIndex(samples == 2048 ? 0 : 1);
+    m_pregenerateCount->setValue(m_settings->value<Settings::WaveBar::PregenerateCount>());
+    m_pregenerateLibrary->setChecked(m_settings->value<Settings::WaveBar::PregenerateLibrary>());
 }
 
 void WaveBarSettingsPageWidget::apply()
@@ -277,6 +299,8 @@ void WaveBarSettingsPageWidget::apply()
         mode |= WaveMode::Silence;
     }
     m_settings->set<Settings::WaveBar::Mode>(static_cast<int>(mode));
+    m_settings->set<Settings::WaveBar::PregenerateCount>(m_pregenerateCount->value());
+    m_settings->set<Settings::WaveBar::PregenerateLibrary>(m_pregenerateLibrary->isChecked());
 
     if(m_settings->set<Settings::WaveBar::NumSamples>(m_numSamples->currentIndex() == 0 ? 2048 : 4096)) {
         emit clearCache();
@@ -296,6 +320,8 @@ void WaveBarSettingsPageWidget::reset()
     m_settings->reset<Settings::WaveBar::ChannelScale>();
     m_settings->reset<Settings::WaveBar::Mode>();
     m_settings->reset<Settings::WaveBar::NumSamples>();
+    m_settings->reset<Settings::WaveBar::PregenerateCount>();
+    m_settings->reset<Settings::WaveBar::PregenerateLibrary>();
 }
 
 void WaveBarSettingsPageWidget::updateCacheSize()
@@ -67,6 +67,11 @@ QByteArray serialiseData(const WaveformData<int16_t>& data)
 
     stream << data.channelData;
 
+    stream << static_cast<quint32>(data.levels.size());
+    for(const auto& level : data.levels) {
+        stream << level;
+    }
+
     out = qCompress(out, 9);
 
     return out;
@@ -79,6 +84,29 @@ void deserialiseData(const QByteArray& cacheData, WaveformData<int16_t>& data)
     stream.setVersion(QDataStream::Qt_6_0);
 
     stream >> data.channelData;
+
+    // Data cached before levels were stored ends here
+    if(stream.atEnd()) {
+        return;
+    }
+
+    quint32 levelCount;
+    stream >> levelCount;
+
+    // Each level halves the samples, so anything more can only come from corrupt data
+    if(stream.status() != QDataStream::Ok || levelCount > 32) {
+        return;
+    }
+
+    data.levels.resize(levelCount);
+    for(auto& level : data.levels) {
+        stream >> level;
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        // Levels are rebuilt from the channel data instead
+        data.levels.clear();
+    }
 }
 } // namespace
 
@@ -25,9 +25,12 @@
 #include "wavebarconstants.h"
 #include "wavebarwidget.h"
 #include "waveformbuilder.h"
+#include "waveformpregenerator.h"
 
 #include <core/engine/enginecontroller.h>
+#include <core/library/musiclibrary.h>
 #include <core/player/playercontroller.h>
+#include <core/playlist/playlisthandler.h>
 #include <gui/guiconstants.h>
 #include <gui/trackselectioncontroller.h>
 #include <gui/widgetprovider.h>
@@ -61,6 +64,7 @@ WaveBarPlugin::WaveBarPlugin()
 
 WaveBarPlugin::~WaveBarPlugin()
 {
+    m_pregenerator.reset();
     m_waveBuilder.reset();
 }
 
@@ -68,6 +72,8 @@ void WaveBarPlugin::initialise(const CorePluginContext& context)
 {
     m_playerController = context.playerController;
     m_engine           = context.engine;
+    m_playlistHandler  = context.playlistHandler;
+    m_library          = context.library;
     m_audioLoader      = context.audioLoader;
     m_settings         = context.settingsManager;
 
@@ -92,6 +98,24 @@ void WaveBarPlugin::initialise(const GuiPluginContext& context)
 
     QObject::connect(m_waveBarSettingsPage.get(), &WaveBarSettingsPage::clearCache, this, &WaveBarPlugin::clearCache);
 
+    m_pregenerator = std::make_unique<WaveformPregenerator>(m_audioLoader, m_dbPool, m_settings);
+
+    QObject::connect(m_playerController, &PlayerController::currentTrackChanged, this,
+                     &WaveBarPlugin::queueUpcomingTracks);
+    QObject::connect(m_playerController, &PlayerController::playModeChanged, this,
+                     &WaveBarPlugin::queueUpcomingTracks);
+    QObject::connect(m_playerController, &PlayerController::tracksQueued, this, &WaveBarPlugin::queueUpcomingTracks);
+    QObject::connect(m_library, &MusicLibrary::tracksLoaded, this, &WaveBarPlugin::queueLibraryTracks);
+    QObject::connect(m_library, &MusicLibrary::tracksAdded, this, [this](const TrackList& tracks) {
+        if(m_settings->value<Settings::WaveBar::PregenerateLibrary>()) {
+            m_pregenerator->appendToQueue(WaveformPregenerator::Priority::Library, tracks);
+        }
+    });
+    m_settings->subscribe<Settings::WaveBar::PregenerateCount>(this, &WaveBarPlugin::queueUpcomingTracks);
+    m_settings->subscribe<Settings::WaveBar::PregenerateLibrary>(this, &WaveBarPlugin::queueLibraryTracks);
+
+    queueLibraryTracks();
+
     m_widgetProvider->registerWidget(
         QStringLiteral("WaveBar"), [this]() { return createWavebar(); }, tr("Waveform Seekbar"));
     m_widgetProvider->setSubMenus(QStringLiteral("WaveBar"), {tr("Controls")});
@@ -212,6 +236,10 @@ void WaveBarPlugin::removeSelection()
 
 void WaveBarPlugin::clearCache() const
 {
+    if(m_pregenerator) {
+        m_pregenerator->cancel();
+    }
+
     const DbConnectionHandler handler{m_dbPool};
     WaveBarDatabase waveDb;
     waveDb.initialise(DbConnectionProvider{m_dbPool});
@@ -220,6 +248,63 @@ void WaveBarPlugin::clearCache() const
         qCWarning(WAVEBAR) << "Unable to clear waveform cache";
     }
 }
+
+void WaveBarPlugin::queueUpcomingTracks()
+{
+    const int count = m_settings->value<Settings::WaveBar::PregenerateCount>();
+    if(count <= 0) {
+        m_pregenerator->replaceQueue(WaveformPregenerator::Priority::Upcoming, {});
+        return;
+    }
+
+    TrackList upcoming;
+
+    const auto queuedTracks = m_playerController->playbackQueue().tracks();
+    for(const PlaylistTrack& queuedTrack : queuedTracks) {
+        if(std::cmp_greater_equal(upcoming.size(), count)) {
+            break;
+        }
+        upcoming.push_back(queuedTrack.track);
+    }
+
+    // Only sequential playback has a predictable order; Playlist::nextIndex can't be used here as
+    // it consumes any scheduled index and picks a random track in the random modes.
+    const Playlist::PlayModes mode          = m_playerController->playMode();
+    const Playlist::PlayModes unpredictable = Playlist::RepeatTrack | Playlist::ShuffleAlbums
+                                            | Playlist::ShuffleTracks | Playlist::Random;
+    const PlaylistTrack current             = m_playerController->currentPlaylistTrack();
+
+    if(Playlist* playlist = m_playlistHandler->playlistById(current.playlistId);
+       playlist && current.indexInPlaylist >= 0 && !(mode & unpredictable)) {
+        const int trackCount = playlist->trackCount();
+        const bool repeat    = mode.testFlag(Playlist::RepeatPlaylist);
+
+        for(int delta{1}; delta < trackCount && std::cmp_less(upcoming.size(), count); ++delta) {
+            int index = current.indexInPlaylist + delta;
+            if(index >= trackCount) {
+                if(!repeat) {
+                    break;
+                }
+                index %= trackCount;
+            }
+            if(const auto track = playlist->track(index)) {
+                upcoming.push_back(track.value());
+            }
+        }
+    }
+
+    m_pregenerator->replaceQueue(WaveformPregenerator::Priority::Upcoming, upcoming);
+}
+
+void WaveBarPlugin::queueLibraryTracks()
+{
+    if(m_settings->value<Settings::WaveBar::PregenerateLibrary>()) {
+        m_pregenerator->replaceQueue(WaveformPregenerator::Priority::Library, m_library->tracks());
+    }
+    else {
+        m_pregenerator->replaceQueue(WaveformPregenerator::Priority::Library, {});
+    }
+}
 } // namespace Fooyin::WaveBar
 
 #include "moc_wavebarplugin.cpp"
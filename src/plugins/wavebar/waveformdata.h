@@ -21,7 +21,10 @@
 
 #include <core/engine/audioformat.h>
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace Fooyin::WaveBar {
@@ -58,6 +61,12 @@ struct WaveformData
         }
     };
     std::vector<ChannelData> channelData;
+    // Pre-reduced copies of channelData, each with half the samples of the level before it.
+    // These are derived from channelData, so they aren't compared.
+    std::vector<std::vector<ChannelData>> levels;
+
+    // Levels aren't reduced below this many samples
+    static constexpr int MinLevelSamples = 64;
 
     bool operator==(const WaveformData<T>& other) const noexcept
     {
@@ -84,5 +93,67 @@ struct WaveformData
 
         return static_cast<int>(channelData.front().max.size());
     }
+
+    /*!
+     * Rebuilds the levels from channelData, halving the number of samples each time
+     * until a level would have fewer than @c MinLevelSamples.
+     */
+    void buildLevels()
+    {
+        levels.clear();
+
+        const std::vector<ChannelData>* previous = &channelData;
+
+        while(!previous->empty() && previous->front().max.size() / 2 >= MinLevelSamples) {
+            std::vector<ChannelData> level;
+            level.reserve(previous->size());
+
+            for(const ChannelData& channel : *previous) {
+                level.emplace_back(halveChannel(channel));
+            }
+
+            previous = &levels.emplace_back(std::move(level));
+        }
+    }
+
+    /*!
+     * Returns the coarsest level with at least @p samples samples per channel.
+     * Falls back to channelData if no level is large enough.
+     */
+    [[nodiscard]] const std::vector<ChannelData>& levelFor(int samples) const
+    {
+        const auto level = std::find_if(levels.crbegin(), levels.crend(), [samples](const auto& channels) {
+            return !channels.empty() && std::cmp_greater_equal(channels.front().max.size(), samples);
+        });
+
+        return level != levels.crend() ? *level : channelData;
+    }
+
+private:
+    static ChannelData halveChannel(const ChannelData& channel)
+    {
+        const size_t count = std::min({channel.max.size(), channel.min.size(), channel.rms.size()});
+        const size_t half  = (count + 1) / 2;
+
+        ChannelData out;
+        out.max.resize(half);
+        out.min.resize(half);
+        out.rms.resize(half);
+
+        for(size_t i{0}; i < half; ++i) {
+            // A trailing odd sample is carried over on its own
+            const size_t first  = i * 2;
+            const size_t second = std::min(first + 1, count - 1);
+
+            const auto firstRms  = static_cast<double>(channel.rms[first]);
+            const auto secondRms = static_cast<double>(channel.rms[second]);
+
+            out.max[i] = std::max(channel.max[first], channel.max[second]);
+            out.min[i] = std::min(channel.min[first], channel.min[second]);
+            out.rms[i] = static_cast<T>(std::sqrt((firstRms * firstRms + secondRms * secondRms) / 2.0));
+        }
+
+        return out;
+    }
 };
 } // namespace Fooyin::WaveBar
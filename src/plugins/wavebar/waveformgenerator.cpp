@@ -28,6 +28,7 @@
 #include <QFile>
 
 #include <cfenv>
+#include <cstring>
 #include <utility>
 
 Q_LOGGING_CATEGORY(WAVEBAR, "fy.wavebar")
@@ -55,45 +56,48 @@ int16_t convertSampleToInt16(const float inSample)
 }
 
 template <typename OutputType, typename InputType>
-Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::WaveformData<InputType>& cacheData)
+void convertSamples(const std::vector<InputType>& input, std::vector<OutputType>& output)
 {
-    Fooyin::WaveBar::WaveformData<OutputType> data;
-    const size_t channels = cacheData.channelData.size();
-    data.channelData.resize(channels);
-
-    for(size_t channel{0}; channel < channels; ++channel) {
-        auto& inChannelData  = cacheData.channelData[channel];
-        auto& outChannelData = data.channelData[channel];
+    output.reserve(input.size());
 
-        outChannelData.max.reserve(inChannelData.max.size());
-        outChannelData.min.reserve(inChannelData.min.size());
-        outChannelData.rms.reserve(inChannelData.rms.size());
-
-        for(const auto& sample : inChannelData.max) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.max.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.max.emplace_back(convertSampleToInt16(sample));
-            }
-        }
-        for(const auto& sample : inChannelData.min) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.min.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.min.emplace_back(convertSampleToInt16(sample));
-            }
+    for(const auto& sample : input) {
+        if constexpr(std::is_same_v<InputType, int16_t>) {
+            output.emplace_back(convertSampleToFloat(sample));
         }
-        for(const auto& sample : inChannelData.rms) {
-            if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.rms.emplace_back(convertSampleToFloat(sample));
-            }
-            else {
-                outChannelData.rms.emplace_back(convertSampleToInt16(sample));
-            }
+        else {
+            output.emplace_back(convertSampleToInt16(sample));
         }
     }
+}
+
+template <typename OutputType, typename InputType>
+std::vector<typename Fooyin::WaveBar::WaveformData<OutputType>::ChannelData>
+convertChannels(const std::vector<typename Fooyin::WaveBar::WaveformData<InputType>::ChannelData>& inChannels)
+{
+    std::vector<typename Fooyin::WaveBar::WaveformData<OutputType>::ChannelData> outChannels(inChannels.size());
+
+    for(size_t channel{0}; channel < inChannels.size(); ++channel) {
+        const auto& inChannelData = inChannels[channel];
+        auto& outChannelData      = outChannels[channel];
+
+        convertSamples(inChannelData.max, outChannelData.max);
+        convertSamples(inChannelData.min, outChannelData.min);
+        convertSamples(inChannelData.rms, outChannelData.rms);
+    }
+
+    return outChannels;
+}
+
+template <typename OutputType, typename InputType>
+Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::WaveformData<InputType>& cacheData)
+{
+    Fooyin::WaveBar::WaveformData<OutputType> data;
+    data.channelData = convertChannels<OutputType, InputType>(cacheData.channelData);
+
+    data.levels.reserve(cacheData.levels.size());
+    for(const auto& level : cacheData.levels) {
+        data.levels.emplace_back(convertChannels<OutputType, InputType>(level));
+    }
 
     return data;
 }
@@ -125,32 +129,31 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
         return;
     }
 
+    if(!update && track.isValid() && track.channels() > 0) {
+        // Cached tracks don't need a decoder, so check using the channel count from the metadata first
+        m_data                   = {};
+        m_track                  = track;
+        m_data.format            = AudioFormat{SampleFormat::F32, track.sampleRate(), track.channels()};
+        m_data.duration          = track.duration();
+        m_data.channels          = track.channels();
+        m_data.samplesPerChannel = samplesPerChannel;
+
+        if(loadFromCache(track, WaveBarDatabase::cacheKey(track), render)) {
+            return;
+        }
+    }
+
     const QString trackKey = setup(track, samplesPerChannel);
     if(trackKey.isEmpty()) {
         return;
     }
 
-    setState(Running);
-
-    if(!update && m_waveDb.existsInCache(trackKey)) {
-        if(render) {
-            WaveformData<int16_t> data;
-            if(m_waveDb.loadCachedData(trackKey, data)) {
-                const auto floatData = convertCache<float>(data);
-                m_data.channelData   = floatData.channelData;
-                m_data.complete      = true;
-
-                setState(Idle);
-                emit waveformGenerated(track, m_data);
-            }
-        }
-        else {
-            setState(Idle);
-            emit waveformGenerated(track, {});
-        }
+    if(!update && loadFromCache(track, trackKey, render)) {
         return;
     }
 
+    setState(Running);
+
     emit generatingWaveform();
 
     const int bps               = m_format.bytesPerFrame();
@@ -193,7 +196,6 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
         }
 
         processedBytes += buffer.byteCount();
-        buffer = Audio::convert(buffer, m_requiredFormat);
         processBuffer(buffer);
 
         if(render && processedCount++ == updateThreshold) {
@@ -204,6 +206,8 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
 
     m_decoder->stop();
 
+    m_data.buildLevels();
+
     if(!m_waveDb.storeInCache(trackKey, convertCache<int16_t>(m_data))) {
         qCWarning(WAVEBAR) << "Unable to store waveform for track:" << m_track.filepath();
     }
@@ -215,6 +219,39 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
     emit waveformGenerated(track, m_data);
 }
 
+bool WaveformGenerator::loadFromCache(const Track& track, const QString& key, bool render)
+{
+    if(!m_waveDb.existsInCache(key)) {
+        return false;
+    }
+
+    setState(Running);
+
+    if(render) {
+        WaveformData<int16_t> data;
+        if(m_waveDb.loadCachedData(key, data)) {
+            auto floatData     = convertCache<float>(data);
+            m_data.channelData = std::move(floatData.channelData);
+            m_data.levels      = std::move(floatData.levels);
+            m_data.complete    = true;
+
+            if(m_data.levels.empty()) {
+                // Cached before levels were stored
+                m_data.buildLevels();
+            }
+
+            setState(Idle);
+            emit waveformGenerated(track, m_data);
+        }
+    }
+    else {
+        setState(Idle);
+        emit waveformGenerated(track, {});
+    }
+
+    return true;
+}
+
 QString WaveformGenerator::setup(const Track& track, int samplesPerChannel)
 {
     if(m_decoder) {
@@ -261,41 +298,31 @@ QString WaveformGenerator::setup(const Track& track, int samplesPerChannel)
     m_data.channels = m_format.channelCount();
     m_data.channelData.resize(m_data.channels);
     m_data.samplesPerChannel = samplesPerChannel;
+    m_reducer.setChannels(m_data.channels);
 
     return WaveBarDatabase::cacheKey(m_track, m_data.channels);
 }
 
 void WaveformGenerator::processBuffer(const AudioBuffer& buffer)
 {
-    const int bps         = buffer.format().bytesPerSample();
-    const int sampleCount = buffer.frameCount();
-    const auto* samples   = buffer.data();
-
-    for(int ch{0}; ch < m_data.channels; ++ch) {
-        if(!mayRun()) {
-            return;
-        }
+    const int frameCount = buffer.frameCount();
 
-        float max{-1.0};
-        float min{1.0};
-        float rms{0.0};
+    // Samples are converted into a buffer reused for the whole track
+    m_samples.resize(static_cast<size_t>(frameCount) * m_data.channels);
+    auto* samples = reinterpret_cast<std::byte*>(m_samples.data());
 
-        for(int i{0}; i < sampleCount; ++i) {
-            if(!mayRun()) {
-                return;
-            }
-
-            const int offset = (i * m_data.channels + ch) * bps;
-            float sample;
-            std::memcpy(&sample, samples + offset, bps);
+    if(buffer.format().sampleFormat() == SampleFormat::F32 && buffer.format().channelCount() == m_data.channels) {
+        std::memcpy(samples, buffer.data(), m_samples.size() * sizeof(float));
+    }
+    else if(!Audio::convert(buffer.format(), buffer.data(), m_requiredFormat, samples, frameCount)) {
+        return;
+    }
 
-            max = std::max(max, sample);
-            min = std::min(min, sample);
-            rms += sample * sample;
-        }
+    m_reducer.reset();
+    m_reducer.addSamples(m_samples.data(), frameCount);
 
-        rms /= static_cast<float>(sampleCount);
-        rms = std::sqrt(rms);
+    for(int ch{0}; ch < m_data.channels; ++ch) {
+        const auto [max, min, rms] = m_reducer.result(ch);
 
         auto& [cMax, cMin, cRms] = m_data.channelData.at(ch);
         cMax.emplace_back(max);
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "wavebardatabase.h"
+#include "waveformreducer.h"
 
 #include <core/engine/audioinput.h>
 #include <core/track.h>
@@ -53,6 +54,8 @@ public slots:
     void generate(const Fooyin::Track& track, int samplesPerChannel, bool render, bool update = false);
 
 private:
+    /** Emits the waveform stored under @p key if cached. Returns false if it isn't. */
+    bool loadFromCache(const Track& track, const QString& key, bool render);
     QString setup(const Track& track, int samplesPerChannel);
     void processBuffer(const AudioBuffer& buffer);
 
@@ -68,6 +71,8 @@ private:
     AudioFormat m_requiredFormat;
     int m_samplesPerChannel;
     WaveformData<float> m_data;
+    WaveformReducer m_reducer;
+    std::vector<float> m_samples;
 };
 } // namespace WaveBar
 } // namespace Fooyin
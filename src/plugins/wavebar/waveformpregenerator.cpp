@@ -0,0 +1,165 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformpregenerator.h"
+
+#include "settings/wavebarsettings.h"
+#include "waveformgenerator.h"
+
+#include <utils/settings/settingsmanager.h>
+
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+// Upper bound on the number of tracks generated at once
+constexpr auto MaxGeneratorThreads = 4;
+
+namespace Fooyin::WaveBar {
+struct WaveformPregenerator::GeneratorThread
+{
+    GeneratorThread(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool)
+        : generator{std::move(audioLoader), std::move(dbPool)}
+    {
+        generator.moveToThread(&thread);
+    }
+
+    QThread thread;
+    WaveformGenerator generator;
+    QString key;
+    bool busy{false};
+};
+
+WaveformPregenerator::WaveformPregenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                                           SettingsManager* settings, QObject* parent)
+    : QObject{parent}
+    , m_audioLoader{std::move(audioLoader)}
+    , m_dbPool{std::move(dbPool)}
+    , m_settings{settings}
+    , m_completed{0}
+    , m_total{0}
+{
+    const int threadCount = std::clamp(QThread::idealThreadCount() / 2, 1, MaxGeneratorThreads);
+
+    for(int i{0}; i < threadCount; ++i) {
+        auto& worker = m_workers.emplace_back(std::make_unique<GeneratorThread>(m_audioLoader, m_dbPool));
+        worker->thread.start(QThread::IdlePriority);
+        QMetaObject::invokeMethod(&worker->generator, &Worker::initialiseThread);
+    }
+}
+
+WaveformPregenerator::~WaveformPregenerator()
+{
+    for(auto& worker : m_workers) {
+        worker->generator.closeThread();
+    }
+    for(auto& worker : m_workers) {
+        worker->thread.quit();
+        worker->thread.wait();
+    }
+}
+
+void WaveformPregenerator::replaceQueue(Priority priority, const TrackList& tracks)
+{
+    clearQueue(priority);
+    appendToQueue(priority, tracks);
+}
+
+void WaveformPregenerator::appendToQueue(Priority priority, const TrackList& tracks)
+{
+    for(const Track& track : tracks) {
+        if(track.isValid() && m_queue.append(priority, track, WaveBarDatabase::cacheKey(track))) {
+            ++m_total;
+        }
+    }
+
+    dispatch();
+}
+
+void WaveformPregenerator::cancel()
+{
+    clearQueue(Priority::Upcoming);
+    clearQueue(Priority::Library);
+
+    for(auto& worker : m_workers) {
+        if(worker->busy) {
+            worker->generator.stopThread();
+        }
+    }
+}
+
+int WaveformPregenerator::pendingCount() const
+{
+    return m_queue.pendingCount();
+}
+
+void WaveformPregenerator::clearQueue(Priority priority)
+{
+    m_total -= m_queue.clear(priority);
+}
+
+void WaveformPregenerator::dispatch()
+{
+    for(auto& worker : m_workers) {
+        if(worker->busy) {
+            continue;
+        }
+
+        auto next = m_queue.takeNext();
+        if(!next) {
+            break;
+        }
+
+        const Track track = next->track;
+        worker->busy      = true;
+        worker->key       = next->key;
+
+        worker->thread.setPriority(next->priority == Priority::Upcoming ? QThread::LowPriority : QThread::IdlePriority);
+
+        const int samplesPerChannel = m_settings->value<Settings::WaveBar::NumSamples>();
+
+        QMetaObject::invokeMethod(&worker->generator, [this, worker = worker.get(), track, samplesPerChannel]() {
+            worker->generator.generate(track, samplesPerChannel, false);
+            // Generation runs to completion on this thread, so the result can be handled once it returns
+            QMetaObject::invokeMethod(this, [this, worker]() { trackFinished(worker); });
+        });
+    }
+}
+
+void WaveformPregenerator::trackFinished(GeneratorThread* worker)
+{
+    worker->busy = false;
+    m_queue.finish(std::exchange(worker->key, {}));
+
+    ++m_completed;
+    emit progressChanged(m_completed, std::max(m_total, m_completed));
+
+    if(m_queue.pendingCount() == 0) {
+        m_completed = 0;
+        m_total     = 0;
+        emit finished();
+        return;
+    }
+
+    dispatch();
+}
+} // namespace Fooyin::WaveBar
+
+#include "moc_waveformpregenerator.cpp"
@@ -0,0 +1,90 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "waveformqueue.h"
+
+#include <core/track.h>
+#include <utils/database/dbconnectionpool.h>
+
+#include <QObject>
+
+namespace Fooyin {
+class AudioLoader;
+class SettingsManager;
+
+namespace WaveBar {
+class WaveformGenerator;
+
+/*!
+ * Generates and caches waveforms in the background so they're ready before a track is played.
+ * Tracks are generated on a bounded pool of threads, each with its own generator (and so its own
+ * decoders). Tracks with a waveform already in the cache are skipped.
+ */
+class WaveformPregenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Priority = WaveformQueue::Priority;
+
+    explicit WaveformPregenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                                  SettingsManager* settings, QObject* parent = nullptr);
+    ~WaveformPregenerator() override;
+
+    /** Replaces any queued tracks of @p priority with @p tracks. */
+    void replaceQueue(Priority priority, const TrackList& tracks);
+    /*!
+     * Adds @p tracks to the end of the queue of @p priority.
+     * Upcoming tracks already queued for the library are moved to the upcoming queue.
+     */
+    void appendToQueue(Priority priority, const TrackList& tracks);
+
+    /** Clears all queued tracks and stops any being generated. */
+    void cancel();
+
+    /** Returns the number of tracks queued or being generated. */
+    [[nodiscard]] int pendingCount() const;
+
+signals:
+    /** Emitted after each track is processed. @p total is the number of tracks queued since the queue was empty. */
+    void progressChanged(int completed, int total);
+    /** Emitted once all queued tracks have been processed. */
+    void finished();
+
+private:
+    struct GeneratorThread;
+
+    void clearQueue(Priority priority);
+    void dispatch();
+    void trackFinished(GeneratorThread* worker);
+
+    std::shared_ptr<AudioLoader> m_audioLoader;
+    DbConnectionPoolPtr m_dbPool;
+    SettingsManager* m_settings;
+
+    std::vector<std::unique_ptr<GeneratorThread>> m_workers;
+    WaveformQueue m_queue;
+
+    int m_completed;
+    int m_total;
+};
+} // namespace WaveBar
+} // namespace Fooyin
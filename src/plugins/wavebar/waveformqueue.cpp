@@ -0,0 +1,114 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformqueue.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace Fooyin::WaveBar {
+bool WaveformQueue::append(Priority priority, const Track& track, const QString& key)
+{
+    if(m_pending.emplace(key).second) {
+        queue(priority).emplace_back(track, key);
+        return true;
+    }
+
+    if(priority == Priority::Upcoming) {
+        auto libraryIt = std::ranges::find(m_library, key, &QueuedTrack::key);
+        if(libraryIt != m_library.end()) {
+            m_upcoming.emplace_back(std::move(libraryIt->track), key, true);
+            m_library.erase(libraryIt);
+        }
+    }
+
+    return false;
+}
+
+int WaveformQueue::clear(Priority priority)
+{
+    Queue& tracksQueue = queue(priority);
+
+    if(priority == Priority::Library) {
+        // The library no longer wants promoted tracks back once they've been generated as upcoming
+        for(auto& queued : m_upcoming) {
+            queued.fromLibrary = false;
+        }
+    }
+
+    int removed{0};
+    // Reversed so returned tracks keep their order at the front of the library queue
+    for(auto& queued : tracksQueue | std::views::reverse) {
+        if(queued.fromLibrary) {
+            m_library.emplace_front(std::move(queued.track), queued.key);
+        }
+        else {
+            m_pending.erase(queued.key);
+            ++removed;
+        }
+    }
+
+    tracksQueue.clear();
+    return removed;
+}
+
+std::optional<WaveformQueue::Entry> WaveformQueue::takeNext()
+{
+    const Priority priority = !m_upcoming.empty() ? Priority::Upcoming : Priority::Library;
+    Queue& tracksQueue      = queue(priority);
+    if(tracksQueue.empty()) {
+        return {};
+    }
+
+    Entry entry{std::move(tracksQueue.front().track), std::move(tracksQueue.front().key), priority};
+    tracksQueue.pop_front();
+
+    return entry;
+}
+
+void WaveformQueue::finish(const QString& key)
+{
+    m_pending.erase(key);
+}
+
+bool WaveformQueue::isPending(const QString& key) const
+{
+    return m_pending.contains(key);
+}
+
+int WaveformQueue::pendingCount() const
+{
+    return static_cast<int>(m_pending.size());
+}
+
+int WaveformQueue::queuedCount(Priority priority) const
+{
+    return static_cast<int>(queue(priority).size());
+}
+
+WaveformQueue::Queue& WaveformQueue::queue(Priority priority)
+{
+    return priority == Priority::Upcoming ? m_upcoming : m_library;
+}
+
+const WaveformQueue::Queue& WaveformQueue::queue(Priority priority) const
+{
+    return priority == Priority::Upcoming ? m_upcoming : m_library;
+}
+} // namespace Fooyin::WaveBar
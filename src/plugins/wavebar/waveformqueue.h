@@ -0,0 +1,93 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/track.h>
+
+#include <QString>
+
+#include <deque>
+#include <optional>
+#include <unordered_set>
+
+namespace Fooyin::WaveBar {
+/*!
+ * Queues of tracks waiting for their waveforms to be pre-generated, keyed by waveform cache key.
+ * A key is pending from when it's queued until @fn finish is called, and is only ever queued once.
+ */
+class WaveformQueue
+{
+public:
+    enum class Priority : uint8_t
+    {
+        // Tracks about to be played, generated first at low thread priority
+        Upcoming = 0,
+        // Any other tracks, generated only when no upcoming tracks are queued at idle thread priority
+        Library,
+    };
+
+    struct Entry
+    {
+        Track track;
+        QString key;
+        Priority priority{Priority::Library};
+    };
+
+    /*!
+     * Queues @p track under @p key.
+     * An upcoming track already queued for the library is moved to the upcoming queue rather than ignored.
+     * @returns true if @p key wasn't already pending.
+     */
+    bool append(Priority priority, const Track& track, const QString& key);
+    /*!
+     * Removes all queued tracks of @p priority.
+     * Library tracks moved to the upcoming queue are returned to the library queue.
+     * @returns the number of keys which are no longer pending.
+     */
+    int clear(Priority priority);
+
+    /** Removes and returns the next track to generate. Its key remains pending until @fn finish is called. */
+    std::optional<Entry> takeNext();
+    void finish(const QString& key);
+
+    [[nodiscard]] bool isPending(const QString& key) const;
+    /** Returns the number of tracks queued or being generated. */
+    [[nodiscard]] int pendingCount() const;
+    [[nodiscard]] int queuedCount(Priority priority) const;
+
+private:
+    struct QueuedTrack
+    {
+        Track track;
+        QString key;
+        // Set for library tracks moved to the upcoming queue
+        bool fromLibrary{false};
+    };
+    using Queue = std::deque<QueuedTrack>;
+
+    Queue& queue(Priority priority);
+    [[nodiscard]] const Queue& queue(Priority priority) const;
+
+    Queue m_upcoming;
+    Queue m_library;
+    // Keys of queued tracks and those being generated
+    std::unordered_set<QString> m_pending;
+};
+} // namespace Fooyin::WaveBar
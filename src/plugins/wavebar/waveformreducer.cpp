@@ -0,0 +1,173 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "waveformreducer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+// Frames reduced together in each iteration of the inner loop
+constexpr auto LaneFrames = 8;
+
+namespace {
+// Each lane always holds the same channel, as a block is a whole number of frames
+void reduceBlock(const float* block, int count, float* max, float* min, float* sumSquares)
+{
+    for(int i{0}; i < count; ++i) {
+        const float sample = block[i];
+        max[i]             = sample > max[i] ? sample : max[i];
+        min[i]             = sample < min[i] ? sample : min[i];
+        sumSquares[i] += sample * sample;
+    }
+}
+
+// Reduces whole blocks into local lanes of a size known at compile time, which can be kept in vector registers
+template <int Channels>
+void reduceBlocks(const float* samples, int blockCount, float* max, float* min, float* sumSquares)
+{
+    constexpr int BlockSize = Channels * LaneFrames;
+
+    std::array<float, BlockSize> blockMax;
+    std::array<float, BlockSize> blockMin;
+    std::array<float, BlockSize> blockSumSquares;
+
+    std::copy_n(max, BlockSize, blockMax.begin());
+    std::copy_n(min, BlockSize, blockMin.begin());
+    std::copy_n(sumSquares, BlockSize, blockSumSquares.begin());
+
+    for(int block{0}; block < blockCount; ++block) {
+        const float* samplesBlock = samples + static_cast<std::ptrdiff_t>(block) * BlockSize;
+        for(int i{0}; i < BlockSize; ++i) {
+            const float sample = samplesBlock[i];
+            blockMax[i]        = sample > blockMax[i] ? sample : blockMax[i];
+            blockMin[i]        = sample < blockMin[i] ? sample : blockMin[i];
+            blockSumSquares[i] += sample * sample;
+        }
+    }
+
+    std::ranges::copy(blockMax, max);
+    std::ranges::copy(blockMin, min);
+    std::ranges::copy(blockSumSquares, sumSquares);
+}
+} // namespace
+
+namespace Fooyin::WaveBar {
+WaveformReducer::WaveformReducer(int channels)
+    : m_channels{0}
+    , m_frameCount{0}
+{
+    setChannels(channels);
+}
+
+int WaveformReducer::channels() const
+{
+    return m_channels;
+}
+
+void WaveformReducer::setChannels(int channels)
+{
+    m_channels = std::max(channels, 0);
+
+    const auto laneCount = static_cast<size_t>(m_channels * LaneFrames);
+    m_max.resize(laneCount);
+    m_min.resize(laneCount);
+    m_sumSquares.resize(laneCount);
+
+    reset();
+}
+
+void WaveformReducer::reset()
+{
+    const WaveformSample initial;
+
+    std::ranges::fill(m_max, initial.max);
+    std::ranges::fill(m_min, initial.min);
+    std::ranges::fill(m_sumSquares, 0.0F);
+    m_frameCount = 0;
+}
+
+void WaveformReducer::addSamples(const float* samples, int frameCount)
+{
+    if(!samples || frameCount <= 0 || m_channels <= 0) {
+        return;
+    }
+
+    float* max        = m_max.data();
+    float* min        = m_min.data();
+    float* sumSquares = m_sumSquares.data();
+
+    const int blockSize  = m_channels * LaneFrames;
+    const int blockCount = frameCount / LaneFrames;
+
+    switch(m_channels) {
+        case(1):
+            reduceBlocks<1>(samples, blockCount, max, min, sumSquares);
+            break;
+        case(2):
+            reduceBlocks<2>(samples, blockCount, max, min, sumSquares);
+            break;
+        case(4):
+            reduceBlocks<4>(samples, blockCount, max, min, sumSquares);
+            break;
+        case(6):
+            reduceBlocks<6>(samples, blockCount, max, min, sumSquares);
+            break;
+        case(8):
+            reduceBlocks<8>(samples, blockCount, max, min, sumSquares);
+            break;
+        default:
+            for(int block{0}; block < blockCount; ++block) {
+                reduceBlock(samples + static_cast<std::ptrdiff_t>(block) * blockSize, blockSize, max, min, sumSquares);
+            }
+            break;
+    }
+
+    const int remainingFrames = frameCount - (blockCount * LaneFrames);
+    reduceBlock(samples + static_cast<std::ptrdiff_t>(blockCount) * blockSize, remainingFrames * m_channels, max, min,
+                sumSquares);
+
+    m_frameCount += frameCount;
+}
+
+WaveformSample WaveformReducer::result(int channel) const
+{
+    WaveformSample sample;
+
+    if(channel < 0 || channel >= m_channels) {
+        return sample;
+    }
+
+    float sumSquares{0.0};
+
+    for(int lane{channel}; std::cmp_less(lane, m_max.size()); lane += m_channels) {
+        sample.max = std::max(sample.max, m_max[lane]);
+        sample.min = std::min(sample.min, m_min[lane]);
+        sumSquares += m_sumSquares[lane];
+    }
+
+    if(m_frameCount > 0) {
+        sample.rms = std::sqrt(sumSquares / static_cast<float>(m_frameCount));
+    }
+
+    return sample;
+}
+} // namespace Fooyin::WaveBar
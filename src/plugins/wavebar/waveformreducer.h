@@ -0,0 +1,57 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "waveformdata.h"
+
+#include <vector>
+
+namespace Fooyin::WaveBar {
+/*!
+ * Reduces interleaved float samples to the peak and RMS values of each channel.
+ * All channels are handled in a single pass over the samples, with the running values
+ * kept for several frames at once so the inner loop can be vectorised by the compiler.
+ */
+class WaveformReducer
+{
+public:
+    explicit WaveformReducer(int channels = 0);
+
+    [[nodiscard]] int channels() const;
+    void setChannels(int channels);
+
+    /** Clears the values accumulated so far. */
+    void reset();
+    /** Adds @p frameCount frames of interleaved samples. */
+    void addSamples(const float* samples, int frameCount);
+
+    /** Returns the peak and RMS values of @p channel for all samples added since the last reset. */
+    [[nodiscard]] WaveformSample result(int channel) const;
+
+private:
+    int m_channels;
+    int m_frameCount;
+
+    // Running values for each sample in a block of LaneFrames frames
+    std::vector<float> m_max;
+    std::vector<float> m_min;
+    std::vector<float> m_sumSquares;
+};
+} // namespace Fooyin::WaveBar
@@ -22,12 +22,13 @@
 #include <utils/settings/settingsmanager.h>
 
 namespace {
-int buildSample(Fooyin::WaveBar::WaveformSample& sample, Fooyin::WaveBar::WaveformData<float>& data, int channel,
-                double start, double end)
+using ChannelData = Fooyin::WaveBar::WaveformData<float>::ChannelData;
+
+int buildSample(Fooyin::WaveBar::WaveformSample& sample, const ChannelData& channel, double start, double end)
 {
     int sampleCount{0};
 
-    auto& [inMax, inMin, inRms] = data.channelData.at(channel);
+    const auto& [inMax, inMin, inRms] = channel;
 
     const int lastIndex = std::floor(end);
 
@@ -69,6 +70,7 @@ void WaveformRescaler::rescale()
 
     WaveformData<float> data{m_data};
     data.channelData.clear();
+    data.levels.clear();
 
     if(m_downMix == DownmixOption::Stereo && data.channels > 2) {
         data.channels = 2;
@@ -79,8 +81,14 @@ void WaveformRescaler::rescale()
 
     data.channelData.resize(data.channels);
 
+    // Complete waveforms have pre-reduced levels, so only the coarsest level
+    // which still has a sample for every bar needs to be scanned
+    const int barCount    = std::max(1, m_width / std::max(1, m_sampleWidth));
+    const auto& samples   = m_data.complete ? m_data.levelFor(barCount) : m_data.channelData;
+    const auto levelCount = samples.empty() ? 0 : static_cast<int>(samples.front().max.size());
+
     const double sampleSize
-        = static_cast<double>(m_data.complete ? m_data.sampleCount() : m_data.samplesPerChannel) * m_sampleWidth;
+        = static_cast<double>(m_data.complete ? levelCount : m_data.samplesPerChannel) * m_sampleWidth;
     const auto samplesPerPixel = sampleSize / m_width;
 
     for(int ch{0}; ch < data.channels; ++ch) {
@@ -100,11 +108,11 @@ void WaveformRescaler::rescale()
 
             if(m_downMix == DownmixOption::Mono || (m_downMix == DownmixOption::Stereo && m_data.channels > 2)) {
                 for(int mixCh{0}; mixCh < m_data.channels; ++mixCh) {
-                    sampleCount += buildSample(sample, m_data, mixCh, start, end);
+                    sampleCount += buildSample(sample, samples.at(mixCh), start, end);
                 }
             }
             else {
-                sampleCount += buildSample(sample, m_data, ch, start, end);
+                sampleCount += buildSample(sample, samples.at(ch), start, end);
             }
 
             if(sampleCount > 0) {
@@ -102,6 +102,11 @@ void DbQuery::bindValue(const QString& placeholder, const QVariant& value)
     m_query.bindValue(placeholder, value);
 }
 
+void DbQuery::bindValue(int pos, const QVariant& value)
+{
+    m_query.bindValue(pos, value);
+}
+
 QString DbQuery::executedQuery() const
 {
     return m_query.executedQuery();
@@ -138,4 +143,9 @@ QVariant DbQuery::value(int index) const
 {
     return m_query.value(index);
 }
+
+void DbQuery::finish()
+{
+    m_query.finish();
+}
 } // namespace Fooyin
@@ -0,0 +1,128 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/engine/audioanalysis.h>
+#include <core/engine/audiobuffer.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <tuple>
+
+namespace Fooyin::Testing {
+namespace {
+template <typename T, size_t N>
+AudioBuffer makeBuffer(const std::array<T, N>& samples, SampleFormat format)
+{
+    const AudioFormat audioFormat{format, 44100, 2};
+    return {reinterpret_cast<const uint8_t*>(samples.data()), sizeof(samples), audioFormat, 0};
+}
+} // namespace
+
+TEST(AudioAnalysisTest, InactiveWithoutUsers)
+{
+    AudioAnalysis analysis;
+    analysis.analyse(makeBuffer(std::array<float, 4>{0.5F, 0.5F, 0.5F, 0.5F}, SampleFormat::F32));
+
+    EXPECT_EQ(0, analysis.levels().sequence);
+}
+
+TEST(AudioAnalysisTest, PeakAndRms)
+{
+    AudioAnalysis analysis;
+    const int user = analysis.addUser();
+
+    // Interleaved stereo: left alternates 0.5/-0.5, right is 1.0 then silence
+    analysis.analyse(makeBuffer(std::array<float, 4>{0.5F, 1.0F, -0.5F, 0.0F}, SampleFormat::F32));
+
+    const auto levels = analysis.levels();
+    EXPECT_EQ(1, levels.sequence);
+    EXPECT_EQ(2, levels.channels);
+    EXPECT_FLOAT_EQ(0.5F, levels.peak.at(0));
+    EXPECT_FLOAT_EQ(1.0F, levels.peak.at(1));
+    EXPECT_FLOAT_EQ(0.5F, levels.rms.at(0));
+    EXPECT_FLOAT_EQ(std::sqrt(0.5F), levels.rms.at(1));
+
+    analysis.removeUser(user);
+    EXPECT_FALSE(analysis.isActive());
+}
+
+TEST(AudioAnalysisTest, ConvertsIntegerSamples)
+{
+    AudioAnalysis analysis;
+    std::ignore = analysis.addUser();
+
+    analysis.analyse(makeBuffer(std::array<int16_t, 4>{16384, -32768, 0, 0}, SampleFormat::S16));
+
+    const auto levels = analysis.levels();
+    EXPECT_EQ(1, levels.sequence);
+    EXPECT_NEAR(0.5F, levels.peak.at(0), 0.001F);
+    EXPECT_NEAR(1.0F, levels.peak.at(1), 0.001F);
+}
+
+TEST(AudioAnalysisTest, HoldsMaxUntilTaken)
+{
+    AudioAnalysis analysis;
+    const int first  = analysis.addUser();
+    const int second = analysis.addUser();
+    ASSERT_NE(first, second);
+
+    // The loud buffer is no longer the latest snapshot, but each user still sees it
+    analysis.analyse(makeBuffer(std::array<float, 4>{0.25F, 0.25F, 0.25F, 0.25F}, SampleFormat::F32));
+    analysis.analyse(makeBuffer(std::array<float, 4>{1.0F, 0.5F, 1.0F, 0.5F}, SampleFormat::F32));
+    analysis.analyse(makeBuffer(std::array<float, 4>{0.1F, 0.1F, 0.1F, 0.1F}, SampleFormat::F32));
+
+    EXPECT_FLOAT_EQ(0.1F, analysis.levels().peak.at(0));
+
+    auto levels = analysis.takeLevels(first);
+    EXPECT_EQ(3, levels.sequence);
+    EXPECT_EQ(2, levels.channels);
+    EXPECT_FLOAT_EQ(1.0F, levels.peak.at(0));
+    EXPECT_FLOAT_EQ(0.5F, levels.peak.at(1));
+    EXPECT_FLOAT_EQ(1.0F, levels.rms.at(0));
+    EXPECT_FLOAT_EQ(0.5F, levels.rms.at(1));
+
+    // Taking resets only that user's max-hold
+    levels = analysis.takeLevels(first);
+    EXPECT_FLOAT_EQ(0.0F, levels.peak.at(0));
+    EXPECT_FLOAT_EQ(1.0F, analysis.takeLevels(second).peak.at(0));
+
+    analysis.analyse(makeBuffer(std::array<float, 4>{0.25F, 0.25F, 0.25F, 0.25F}, SampleFormat::F32));
+    EXPECT_FLOAT_EQ(0.25F, analysis.takeLevels(first).peak.at(0));
+
+    analysis.removeUser(first);
+    analysis.removeUser(second);
+}
+
+TEST(AudioAnalysisTest, ReusesRemovedUsers)
+{
+    AudioAnalysis analysis;
+    const int user = analysis.addUser();
+
+    analysis.analyse(makeBuffer(std::array<float, 4>{1.0F, 1.0F, 1.0F, 1.0F}, SampleFormat::F32));
+    analysis.removeUser(user);
+
+    // A new user doesn't inherit the previous user's levels
+    const int next = analysis.addUser();
+    EXPECT_EQ(user, next);
+    EXPECT_FLOAT_EQ(0.0F, analysis.takeLevels(next).peak.at(0));
+    analysis.removeUser(next);
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,254 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksort.h>
+#include <core/playlist/playlist.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace {
+Fooyin::Track makeTrack(int id, const char* sort, const char* title, const char* genre)
+{
+    Fooyin::Track track{QStringLiteral("/music/%1.flac").arg(id)};
+    track.setId(id);
+    track.setSort(QString::fromLatin1(sort));
+    track.setTitle(QString::fromLatin1(title));
+    track.setGenres({QString::fromLatin1(genre)});
+    // Tracks compare equal by path and hash, so changes must be reflected in the hash
+    track.generateHash();
+    return track;
+}
+
+QStringList describeTracks(const Fooyin::TrackList& tracks)
+{
+    QStringList descriptions;
+    for(const auto& track : tracks) {
+        descriptions.push_back(QStringLiteral("%1:%2").arg(track.id()).arg(track.title()));
+    }
+    return descriptions;
+}
+} // namespace
+
+namespace Fooyin::Testing {
+class AutoPlaylistTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_library = {makeTrack(1, "a", "Alpha", "Rock"), makeTrack(2, "b", "Bravo", "Jazz"),
+                     makeTrack(3, "c", "Charlie", "Rock"), makeTrack(4, "d", "Delta", "Rock"),
+                     makeTrack(5, "e", "Echo", "Pop"),     makeTrack(6, "f", "Foxtrot", "Rock")};
+    }
+
+    [[nodiscard]] std::unique_ptr<Playlist> createPlaylist(const QString& query) const
+    {
+        auto playlist = Playlist::createAuto(-1, QStringLiteral("Auto"), 0, query, nullptr);
+        playlist->regenerateTracks(m_library);
+        return playlist;
+    }
+
+    // Applies the changes to the library, which is kept in library sort order
+    void changeLibrary(const TrackList& changedTracks, const TrackList& removedTracks = {})
+    {
+        for(const Track& track : changedTracks) {
+            const auto trackIt = std::ranges::find(m_library, track.id(), &Track::id);
+            if(trackIt != m_library.end()) {
+                *trackIt = track;
+            }
+            else {
+                m_library.push_back(track);
+            }
+        }
+        std::erase_if(m_library, [&removedTracks](const Track& track) {
+            return std::ranges::find(removedTracks, track.id(), &Track::id) != removedTracks.cend();
+        });
+        m_library = TrackSorter::sortTracks(m_library);
+    }
+
+    // Updates the playlist as PlaylistHandler does, regenerating it if it can't be updated incrementally
+    bool updatePlaylist(Playlist& playlist, const TrackList& changedTracks, const TrackList& removedTracks = {}) const
+    {
+        if(const auto changed = playlist.updateAutoTracks(changedTracks, removedTracks)) {
+            return changed.value();
+        }
+        return playlist.regenerateTracks(m_library);
+    }
+
+    // The incrementally updated playlist must match a full re-query of the library
+    void expectMatchesRequery(const Playlist& playlist) const
+    {
+        const auto requeried = createPlaylist(playlist.query());
+        EXPECT_EQ(describeTracks(playlist.tracks()), describeTracks(requeried->tracks()));
+    }
+
+    TrackList m_library;
+};
+
+TEST_F(AutoPlaylistTest, AddTracks)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+    ASSERT_TRUE(playlist->supportsIncrementalUpdate());
+
+    const TrackList added{makeTrack(7, "0", "Golf", "Rock"), makeTrack(8, "cc", "Hotel", "Rock"),
+                          makeTrack(9, "d", "India", "Jazz")};
+    changeLibrary(added);
+
+    EXPECT_EQ(playlist->updateAutoTracks(added, {}), true);
+    expectMatchesRequery(*playlist);
+    EXPECT_EQ(playlist->trackCount(), 6);
+}
+
+TEST_F(AutoPlaylistTest, UpdateIntoMatch)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList updated{makeTrack(2, "b", "Bravo", "Rock"), makeTrack(5, "e", "Echo", "Rock")};
+    changeLibrary(updated);
+
+    EXPECT_EQ(playlist->updateAutoTracks(updated, {}), true);
+    expectMatchesRequery(*playlist);
+    EXPECT_EQ(playlist->trackCount(), 6);
+}
+
+TEST_F(AutoPlaylistTest, UpdateOutOfMatch)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList updated{makeTrack(1, "a", "Alpha", "Jazz"), makeTrack(4, "d", "Delta", "Pop")};
+    changeLibrary(updated);
+
+    EXPECT_EQ(playlist->updateAutoTracks(updated, {}), true);
+    expectMatchesRequery(*playlist);
+    EXPECT_EQ(playlist->trackCount(), 2);
+}
+
+TEST_F(AutoPlaylistTest, UpdateInPlace)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList updated{makeTrack(3, "c", "Charlie Updated", "Rock")};
+    changeLibrary(updated);
+
+    EXPECT_EQ(playlist->updateAutoTracks(updated, {}), true);
+    expectMatchesRequery(*playlist);
+    EXPECT_EQ(playlist->track(1)->title(), QStringLiteral("Charlie Updated"));
+}
+
+TEST_F(AutoPlaylistTest, UpdateMovesTrack)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList updated{makeTrack(1, "e", "Alpha", "Rock"), makeTrack(6, "0", "Foxtrot", "Rock")};
+    changeLibrary(updated);
+
+    EXPECT_EQ(playlist->updateAutoTracks(updated, {}), true);
+    expectMatchesRequery(*playlist);
+}
+
+TEST_F(AutoPlaylistTest, UnrelatedUpdate)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList updated{makeTrack(2, "b", "Bravo Updated", "Jazz")};
+    changeLibrary(updated);
+
+    EXPECT_EQ(playlist->updateAutoTracks(updated, {}), false);
+    expectMatchesRequery(*playlist);
+}
+
+TEST_F(AutoPlaylistTest, RemoveTracks)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    const TrackList removed{makeTrack(1, "a", "Alpha", "Rock"), makeTrack(2, "b", "Bravo", "Jazz"),
+                            makeTrack(6, "f", "Foxtrot", "Rock")};
+    changeLibrary({}, removed);
+
+    EXPECT_EQ(playlist->updateAutoTracks({}, removed), true);
+    expectMatchesRequery(*playlist);
+    EXPECT_EQ(playlist->trackCount(), 2);
+}
+
+TEST_F(AutoPlaylistTest, SortedQuery)
+{
+    for(const auto& query :
+        {QStringLiteral("genre:rock SORT BY %title%"), QStringLiteral("genre:rock SORT DESCENDING BY %title%")}) {
+        SetUp();
+        auto playlist = createPlaylist(query);
+        ASSERT_TRUE(playlist->supportsIncrementalUpdate());
+
+        // Insert between existing tracks
+        const TrackList added{makeTrack(7, "0", "Bingo", "Rock")};
+        changeLibrary(added);
+        EXPECT_EQ(playlist->updateAutoTracks(added, {}), true);
+        expectMatchesRequery(*playlist);
+
+        // Changing the title repositions the track, changing only the library sort doesn't
+        const TrackList updated{makeTrack(1, "a", "Zulu", "Rock"), makeTrack(4, "z", "Delta", "Rock")};
+        changeLibrary(updated);
+        EXPECT_EQ(playlist->updateAutoTracks(updated, {}), true);
+        expectMatchesRequery(*playlist);
+
+        // Into and out of the query
+        const TrackList swapped{makeTrack(2, "b", "Bravo", "Rock"), makeTrack(3, "c", "Charlie", "Pop")};
+        changeLibrary(swapped);
+        EXPECT_EQ(playlist->updateAutoTracks(swapped, {}), true);
+        expectMatchesRequery(*playlist);
+
+        const TrackList removed{makeTrack(6, "f", "Foxtrot", "Rock")};
+        changeLibrary({}, removed);
+        EXPECT_EQ(playlist->updateAutoTracks({}, removed), true);
+        expectMatchesRequery(*playlist);
+    }
+}
+TEST_F(AutoPlaylistTest, TiedSortKeys)
+{
+    // Every matching track has the same sort fields, so a full query keeps them in library order
+    auto playlist = createPlaylist(QStringLiteral("genre:rock SORT BY %genre%"));
+    ASSERT_TRUE(playlist->supportsIncrementalUpdate());
+
+    const TrackList added{makeTrack(7, "0", "Golf", "Rock")};
+    changeLibrary(added);
+    EXPECT_FALSE(playlist->updateAutoTracks(added, {}).has_value());
+    EXPECT_TRUE(updatePlaylist(*playlist, added));
+    expectMatchesRequery(*playlist);
+
+    // Moves within the library without changing the sort fields of the query
+    const TrackList updated{makeTrack(3, "z", "Charlie", "Rock")};
+    changeLibrary(updated);
+    EXPECT_FALSE(playlist->updateAutoTracks(updated, {}).has_value());
+    EXPECT_TRUE(updatePlaylist(*playlist, updated));
+    expectMatchesRequery(*playlist);
+}
+
+TEST_F(AutoPlaylistTest, TiedLibrarySortKeys)
+{
+    auto playlist = createPlaylist(QStringLiteral("genre:rock"));
+
+    // Same library sort fields as an existing track
+    const TrackList added{makeTrack(7, "c", "Golf", "Rock")};
+    changeLibrary(added);
+    EXPECT_FALSE(playlist->updateAutoTracks(added, {}).has_value());
+    EXPECT_TRUE(updatePlaylist(*playlist, added));
+    expectMatchesRequery(*playlist);
+}
+} // namespace Fooyin::Testing
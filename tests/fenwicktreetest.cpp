@@ -0,0 +1,139 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/fenwicktree.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace {
+int naiveIndexAt(const std::vector<int>& values, int offset)
+{
+    int sum{0};
+    for(int i{0}; i < static_cast<int>(values.size()); ++i) {
+        sum += values.at(i);
+        if(sum > offset) {
+            return i;
+        }
+    }
+    return static_cast<int>(values.size());
+}
+
+void checkMatches(const Fooyin::FenwickTree& tree, const std::vector<int>& expected)
+{
+    ASSERT_EQ(static_cast<int>(expected.size()), tree.size());
+
+    int sum{0};
+    for(int i{0}; i < tree.size(); ++i) {
+        ASSERT_EQ(sum, tree.prefixSum(i));
+        ASSERT_EQ(expected.at(i), tree.value(i));
+        sum += expected.at(i);
+    }
+    ASSERT_EQ(sum, tree.prefixSum(tree.size()));
+    ASSERT_EQ(sum, tree.total());
+
+    for(int offset{0}; offset <= sum + 1; ++offset) {
+        ASSERT_EQ(naiveIndexAt(expected, offset), tree.indexAt(offset));
+    }
+}
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(FenwickTreeTest, PrefixSums)
+{
+    FenwickTree tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(0, tree.total());
+    EXPECT_EQ(0, tree.indexAt(0));
+
+    tree.assign({3, 0, 5, 2});
+
+    EXPECT_EQ(0, tree.prefixSum(0));
+    EXPECT_EQ(3, tree.prefixSum(1));
+    EXPECT_EQ(3, tree.prefixSum(2));
+    EXPECT_EQ(8, tree.prefixSum(3));
+    EXPECT_EQ(10, tree.prefixSum(4));
+    // Counts past the end are clamped
+    EXPECT_EQ(10, tree.prefixSum(10));
+}
+
+TEST(FenwickTreeTest, IndexAt)
+{
+    FenwickTree tree;
+    tree.assign({3, 0, 5, 2});
+
+    EXPECT_EQ(0, tree.indexAt(0));
+    EXPECT_EQ(0, tree.indexAt(2));
+    // Zero values are skipped
+    EXPECT_EQ(2, tree.indexAt(3));
+    EXPECT_EQ(2, tree.indexAt(7));
+    EXPECT_EQ(3, tree.indexAt(8));
+    EXPECT_EQ(3, tree.indexAt(9));
+    EXPECT_EQ(4, tree.indexAt(10));
+    EXPECT_EQ(4, tree.indexAt(100));
+}
+
+TEST(FenwickTreeTest, Resize)
+{
+    std::mt19937 gen{7};
+    FenwickTree tree;
+
+    for(const int count : {1, 2, 3, 8, 17, 5, 64, 0, 100, 1}) {
+        std::vector<int> values(count);
+        std::ranges::generate(values, [&gen]() { return std::uniform_int_distribution<int>{0, 20}(gen); });
+
+        tree.assign(values);
+        checkMatches(tree, values);
+    }
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(0, tree.total());
+    EXPECT_EQ(0, tree.indexAt(5));
+}
+
+TEST(FenwickTreeTest, MatchesVector)
+{
+    std::mt19937 gen{42};
+    std::vector<int> expected(37);
+    std::ranges::generate(expected, [&gen]() { return std::uniform_int_distribution<int>{0, 30}(gen); });
+
+    FenwickTree tree;
+    tree.assign(expected);
+
+    for(int step{0}; step < 2000; ++step) {
+        const int index = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size()) - 1}(gen);
+        const int value = std::uniform_int_distribution<int>{0, 30}(gen);
+        expected[index] = value;
+        tree.set(index, value);
+
+        const int count = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size())}(gen);
+        ASSERT_EQ(std::accumulate(expected.cbegin(), expected.cbegin() + count, 0), tree.prefixSum(count));
+
+        const int total  = std::accumulate(expected.cbegin(), expected.cend(), 0);
+        const int offset = std::uniform_int_distribution<int>{0, total}(gen);
+        ASSERT_EQ(naiveIndexAt(expected, offset), tree.indexAt(offset));
+    }
+
+    checkMatches(tree, expected);
+}
+} // namespace Fooyin::Testing
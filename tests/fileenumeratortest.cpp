@@ -0,0 +1,135 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/fileenumerator.h>
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+const QStringList NameFilters{QStringLiteral("flac"), QStringLiteral("mp3")};
+
+void writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file{path};
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(data);
+}
+
+QStringList enumerateFiles(Fooyin::FileEnumerator& enumerator)
+{
+    enumerator.start();
+
+    QStringList paths;
+    QFileInfoList files;
+    while(enumerator.next(files)) {
+        for(const QFileInfo& file : files) {
+            paths.push_back(file.absoluteFilePath());
+        }
+    }
+    return paths;
+}
+} // namespace
+
+namespace Fooyin::Testing {
+class FileEnumeratorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        ASSERT_TRUE(QDir{m_dir.path()}.mkdir(QStringLiteral("album")));
+
+        m_album = m_dir.filePath(QStringLiteral("album"));
+        writeFile(m_dir.filePath(QStringLiteral("root.mp3")), "data");
+        writeFile(m_album + u"/a.flac", "data");
+        writeFile(m_album + u"/b.flac", "data");
+        writeFile(m_album + u"/cover.jpg", "data");
+        writeFile(m_album + u"/empty.flac", {});
+    }
+
+    QTemporaryDir m_dir;
+    QString m_album;
+};
+
+TEST_F(FileEnumeratorTest, ListsDirectories)
+{
+    FileEnumerator enumerator{{m_dir.path()}, NameFilters, {}};
+    const QStringList files = enumerateFiles(enumerator);
+
+    const QStringList expected{m_dir.filePath(QStringLiteral("root.mp3")), m_album + u"/a.flac", m_album + u"/b.flac"};
+    EXPECT_EQ(files, expected);
+    EXPECT_EQ(enumerator.enumeratedFiles(), 3U);
+    EXPECT_TRUE(enumerator.snapshots().contains(m_album));
+}
+
+TEST_F(FileEnumeratorTest, ChecksKnownFilesOfUnchangedDirectories)
+{
+    const QString editedFile = m_album + u"/a.flac";
+    const QDateTime scannedTime{QFileInfo{editedFile}.lastModified()};
+    const DirectorySnapshot snapshot = FileEnumerator::directorySnapshot(QFileInfo{m_album});
+
+    // Edit the tags in place, as a tagger would
+    {
+        QFile file{editedFile};
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        file.write("tags");
+        file.flush();
+        ASSERT_TRUE(file.setFileTime(scannedTime.addSecs(60), QFileDevice::FileModificationTime));
+    }
+    ASSERT_EQ(FileEnumerator::directorySnapshot(QFileInfo{m_album}), snapshot);
+
+    // b.flac isn't in the library, so the directory isn't listed for it
+    KnownDirectories unchangedDirs;
+    unchangedDirs[m_album] = {.snapshot = snapshot, .subdirs = {}, .files = {editedFile, editedFile}};
+
+    FileEnumerator enumerator{{m_dir.path()}, NameFilters, unchangedDirs};
+    const QStringList files = enumerateFiles(enumerator);
+
+    EXPECT_EQ(files, (QStringList{m_dir.filePath(QStringLiteral("root.mp3")), editedFile}));
+    EXPECT_GT(QFileInfo{editedFile}.lastModified(), scannedTime);
+
+    DirectorySnapshot expected{snapshot};
+    expected.nameFilters = FileEnumerator::nameFiltersKey(NameFilters);
+    EXPECT_EQ(enumerator.snapshots().at(m_album), expected);
+}
+
+TEST_F(FileEnumeratorTest, SnapshotsRecordNameFilters)
+{
+    EXPECT_EQ(FileEnumerator::nameFiltersKey({QStringLiteral("MP3"), QStringLiteral("flac"), QStringLiteral("mp3")}),
+              FileEnumerator::nameFiltersKey(NameFilters));
+
+    FileEnumerator enumerator{{m_dir.path()}, NameFilters, {}};
+    enumerateFiles(enumerator);
+    const DirectorySnapshot snapshot = enumerator.snapshots().at(m_album);
+    EXPECT_EQ(snapshot.nameFilters, FileEnumerator::nameFiltersKey(NameFilters));
+
+    // Listing with another file type gives a different snapshot, so the directory won't be skipped
+    const QStringList otherFilters{NameFilters + QStringList{QStringLiteral("jpg")}};
+    FileEnumerator otherEnumerator{{m_dir.path()}, otherFilters, {}};
+    const QStringList files = enumerateFiles(otherEnumerator);
+
+    EXPECT_NE(otherEnumerator.snapshots().at(m_album), snapshot);
+    EXPECT_TRUE(files.contains(m_album + u"/cover.jpg"));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,41 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/helpers.h>
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+TEST(HelpersTest, RemovalIndexMap)
+{
+    EXPECT_EQ((std::vector<int>{0, -1, 1, -1, 2}), Utils::removalIndexMap(5, {3, 1}));
+    EXPECT_EQ((std::vector<int>{0, 1, 2}), Utils::removalIndexMap(3, {}));
+    EXPECT_EQ((std::vector<int>{-1, 0}), Utils::removalIndexMap(2, {0, 0, -4, 7}));
+}
+
+TEST(HelpersTest, RemoveByIndexMap)
+{
+    std::vector<QString> values{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d")};
+
+    const std::vector<int> indexMap = Utils::removalIndexMap(values.size(), {0, 2});
+    Utils::removeByIndexMap(values, indexMap);
+
+    EXPECT_EQ((std::vector<QString>{QStringLiteral("b"), QStringLiteral("d")}), values);
+}
+} // namespace Fooyin::Testing
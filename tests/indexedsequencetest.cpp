@@ -0,0 +1,111 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/indexedsequence.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+namespace Fooyin::Testing {
+TEST(IndexedSequenceTest, InsertAndLookup)
+{
+    IndexedSequence<int> sequence;
+    sequence.append(std::vector<int>{10, 20, 30});
+    sequence.insert(1, 15);
+    sequence.insert(0, std::vector<int>{1, 2});
+    // Duplicates are ignored
+    sequence.append(20);
+
+    ASSERT_EQ(6, sequence.size());
+
+    const std::vector<int> expected{1, 2, 10, 15, 20, 30};
+    for(int i{0}; i < sequence.size(); ++i) {
+        EXPECT_EQ(expected.at(i), sequence.at(i));
+        EXPECT_EQ(i, sequence.indexOf(expected.at(i)));
+    }
+
+    EXPECT_EQ(-1, sequence.indexOf(99));
+}
+
+TEST(IndexedSequenceTest, Erase)
+{
+    IndexedSequence<int> sequence;
+    sequence.append(std::vector<int>{1, 2, 3, 4});
+
+    EXPECT_TRUE(sequence.erase(2));
+    EXPECT_FALSE(sequence.erase(2));
+    EXPECT_FALSE(sequence.contains(2));
+
+    ASSERT_EQ(3, sequence.size());
+    EXPECT_EQ(3, sequence.at(1));
+    EXPECT_EQ(2, sequence.indexOf(4));
+
+    sequence.clear();
+    EXPECT_TRUE(sequence.empty());
+}
+
+TEST(IndexedSequenceTest, MatchesVector)
+{
+    std::mt19937 gen{42};
+    std::vector<int> expected;
+    IndexedSequence<int> sequence;
+    int nextValue{0};
+
+    for(int step{0}; step < 5000; ++step) {
+        const int op = std::uniform_int_distribution<int>{0, 3}(gen);
+
+        if(op < 2 || expected.empty()) {
+            const int pos = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size())}(gen);
+            std::vector<int> values(std::uniform_int_distribution<int>{1, 4}(gen));
+            std::ranges::generate(values, [&nextValue]() { return nextValue++; });
+            expected.insert(expected.begin() + pos, values.cbegin(), values.cend());
+            sequence.insert(pos, values);
+        }
+        else if(op == 2) {
+            const int pos = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size()) - 1}(gen);
+            ASSERT_TRUE(sequence.erase(expected.at(pos)));
+            expected.erase(expected.begin() + pos);
+        }
+        else {
+            // Move a value to a new position
+            const int from  = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size()) - 1}(gen);
+            const int value = expected.at(from);
+            expected.erase(expected.begin() + from);
+            sequence.erase(value);
+            const int to = std::uniform_int_distribution<int>{0, static_cast<int>(expected.size())}(gen);
+            expected.insert(expected.begin() + to, value);
+            sequence.insert(to, value);
+        }
+
+        ASSERT_EQ(static_cast<int>(expected.size()), sequence.size());
+    }
+
+    for(int i{0}; i < sequence.size(); ++i) {
+        EXPECT_EQ(expected.at(i), sequence.at(i));
+        EXPECT_EQ(i, sequence.indexOf(expected.at(i)));
+    }
+
+    IndexedSequence<int> moved{std::move(sequence)};
+    EXPECT_TRUE(sequence.empty());
+    EXPECT_EQ(static_cast<int>(expected.size()), moved.size());
+    EXPECT_EQ(expected.front(), moved.at(0));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,120 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/database/database.h>
+#include <core/database/trackdatabase.h>
+#include <core/library/librarytracks.h>
+#include <core/library/tracksort.h>
+#include <core/track.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/paths.h>
+
+#include <gtest/gtest.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStandardPaths>
+
+#include <random>
+
+namespace Fooyin::Testing {
+namespace {
+// The default library sort script
+const auto SortScript
+    = QStringLiteral("%albumartist% - %year% - %album% - $num(%disc%,5) - $num(%track%,5) - %title%");
+
+TrackList makeTracks(int first, int count)
+{
+    std::mt19937 gen{static_cast<unsigned>(first)};
+    std::uniform_int_distribution<int> artist{0, 500};
+    std::uniform_int_distribution<int> year{1960, 2024};
+    std::uniform_int_distribution<int> number{1, 20};
+
+    TrackList tracks;
+    tracks.reserve(count);
+
+    for(int i{first}; i < first + count; ++i) {
+        const QString artistName = QStringLiteral("Artist %1").arg(artist(gen));
+
+        Track track{QStringLiteral("/music/%1/%2.flac").arg(artistName).arg(i)};
+        track.setTitle(QStringLiteral("Title %1").arg(i));
+        track.setArtists({artistName});
+        track.setAlbumArtists({artistName});
+        track.setAlbum(QStringLiteral("Album %1").arg(i / 12));
+        track.setYear(year(gen));
+        track.setTrackNumber(QString::number(number(gen)));
+        track.setGenres({QStringLiteral("Rock")});
+        track.setDuration(240000);
+        track.setFileSize(30000000);
+        track.generateHash();
+        tracks.push_back(track);
+    }
+
+    return tracks;
+}
+} // namespace
+
+// Measures the time from reading the library from the database to it being sorted and indexed,
+// as done by UnifiedMusicLibrary on startup
+TEST(LibraryLoadBenchmark, LoadLibrary)
+{
+    // Keeps the benchmark database apart from the user's own
+    QStandardPaths::setTestModeEnabled(true);
+    const QString dbPath = Utils::sharePath() + u"/fooyin.db";
+    QFile::remove(dbPath);
+
+    {
+        const Database database;
+        ASSERT_EQ(database.status(), Database::Status::Ok);
+
+        TrackDatabase trackDatabase;
+        trackDatabase.initialise(DbConnectionProvider{database.connectionPool()});
+
+        TrackSorter sorter;
+        int stored{0};
+
+        for(const int count : {10000, 50000, 100000}) {
+            TrackList tracks = makeTracks(stored, count - stored);
+            ASSERT_TRUE(trackDatabase.storeTracks(tracks));
+            stored = count;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            const TrackList loadedTracks = trackDatabase.getAllTracks();
+            const auto loadMs            = timer.restart();
+
+            const TrackList sortedTracks = sorter.calcSortTracks(SortScript, loadedTracks);
+            const auto sortMs            = timer.restart();
+
+            LibraryTracks library;
+            library.reset(sortedTracks);
+            const auto indexMs = timer.elapsed();
+
+            ASSERT_EQ(library.size(), static_cast<size_t>(count));
+
+            qInfo() << "Load" << count << "tracks:" << loadMs + sortMs + indexMs << "ms (database" << loadMs
+                    << "ms, sort" << sortMs << "ms, index" << indexMs << "ms)";
+        }
+    }
+
+    QFile::remove(dbPath);
+}
+} // namespace Fooyin::Testing
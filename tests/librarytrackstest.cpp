@@ -0,0 +1,143 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/librarytracks.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace {
+Fooyin::Track makeTrack(int id, const char* sort, const char* hash)
+{
+    Fooyin::Track track;
+    track.setId(id);
+    track.setSort(QString::fromLatin1(sort));
+    track.setHash(QString::fromLatin1(hash));
+    return track;
+}
+
+// The single character sort keys of all tracks, in library order
+QString sortKeys(const Fooyin::LibraryTracks& library)
+{
+    QString keys;
+    for(const auto& track : library.tracks()) {
+        keys.append(track.sort());
+    }
+    return keys;
+}
+
+// Every track must be found by its id and its hash
+void expectIndexed(const Fooyin::LibraryTracks& library)
+{
+    for(const auto& track : library.tracks()) {
+        const Fooyin::Track* found = library.track(track.id());
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found, &track);
+
+        const Fooyin::TrackIds ids = library.idsForHash(track.hash());
+        EXPECT_NE(std::ranges::find(ids, track.id()), ids.cend());
+    }
+}
+} // namespace
+
+namespace Fooyin::Testing {
+class LibraryTracksTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_library.reset({makeTrack(1, "b", "hash1"), makeTrack(2, "d", "hash2"),
+                         makeTrack(3, "f", "hash3"), makeTrack(4, "h", "hash1")});
+    }
+
+    LibraryTracks m_library;
+};
+
+TEST_F(LibraryTracksTest, Reset)
+{
+    EXPECT_EQ(m_library.size(), 4U);
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.idsForHash(QStringLiteral("hash1")), (TrackIds{1, 4}));
+    EXPECT_EQ(m_library.track(5), nullptr);
+}
+
+TEST_F(LibraryTracksTest, InsertTracks)
+{
+    m_library.insertTracks({makeTrack(5, "a", "hash5"), makeTrack(6, "e", "hash2")});
+
+    EXPECT_EQ(sortKeys(m_library), QStringLiteral("abdefh"));
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.track(5)->sort(), QStringLiteral("a"));
+    EXPECT_EQ(m_library.idsForHash(QStringLiteral("hash2")), (TrackIds{2, 6}));
+}
+
+TEST_F(LibraryTracksTest, UpdateTrackInPlace)
+{
+    Track track = makeTrack(2, "d", "hash2");
+    track.setTitle(QStringLiteral("Updated"));
+    m_library.updateTracks({track});
+
+    EXPECT_EQ(sortKeys(m_library), QStringLiteral("bdfh"));
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.track(2)->title(), QStringLiteral("Updated"));
+}
+
+TEST_F(LibraryTracksTest, UpdateMovesTracks)
+{
+    m_library.updateTracks({makeTrack(4, "c", "hash1"), makeTrack(1, "g", "hash1")});
+
+    EXPECT_EQ(sortKeys(m_library), QStringLiteral("cdfg"));
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.track(1)->sort(), QStringLiteral("g"));
+    EXPECT_EQ(m_library.track(4)->sort(), QStringLiteral("c"));
+}
+
+TEST_F(LibraryTracksTest, UpdateHash)
+{
+    m_library.updateTracks({makeTrack(1, "b", "hash6"), makeTrack(2, "i", "hash7")});
+
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.idsForHash(QStringLiteral("hash1")), (TrackIds{4}));
+    EXPECT_EQ(m_library.idsForHash(QStringLiteral("hash6")), (TrackIds{1}));
+    EXPECT_TRUE(m_library.idsForHash(QStringLiteral("hash2")).empty());
+}
+
+TEST_F(LibraryTracksTest, UpdateIgnoresUnknownTracks)
+{
+    m_library.updateTracks({makeTrack(7, "a", "hash7")});
+
+    EXPECT_EQ(m_library.size(), 4U);
+    EXPECT_EQ(m_library.track(7), nullptr);
+    EXPECT_TRUE(m_library.idsForHash(QStringLiteral("hash7")).empty());
+}
+
+TEST_F(LibraryTracksTest, RemoveTracks)
+{
+    m_library.removeTracks({1, 3, 8});
+
+    EXPECT_EQ(sortKeys(m_library), QStringLiteral("dh"));
+    expectIndexed(m_library);
+    EXPECT_EQ(m_library.track(1), nullptr);
+    EXPECT_EQ(m_library.track(3), nullptr);
+    EXPECT_EQ(m_library.idsForHash(QStringLiteral("hash1")), (TrackIds{4}));
+    EXPECT_TRUE(m_library.idsForHash(QStringLiteral("hash3")).empty());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,113 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "librarytree/librarytreepopulator.h"
+
+#include <core/track.h>
+#include <utils/crypto.h>
+
+#include <gtest/gtest.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <unordered_set>
+
+constexpr auto TrackCount = 200000;
+
+namespace Fooyin::Testing {
+class LibraryTreePopulatorBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_tracks.reserve(TrackCount);
+
+        for(int i{0}; i < TrackCount; ++i) {
+            Track track;
+            track.setId(i);
+            track.setLibraryId(0);
+            track.setTitle(QStringLiteral("Title %1").arg(i));
+            track.setAlbum(QStringLiteral("Album %1").arg(i / 12));
+            track.setAlbumArtists({QStringLiteral("Album Artist %1").arg(i / 120)});
+            track.setTrackNumber(QString::number((i % 12) + 1));
+            track.setDate(QString::number(1970 + ((i / 12) % 50)));
+            m_tracks.push_back(track);
+        }
+    }
+
+    TrackList m_tracks;
+};
+
+TEST_F(LibraryTreePopulatorBenchmark, Populate)
+{
+    const QString grouping
+        = QStringLiteral("[%albumartist%]||[%album%][ (%year%)]||[%disc%.][$num(%track%,2). ]%title%");
+
+    LibraryTreePopulator populator{nullptr};
+
+    std::unordered_set<Md5Hash> keys;
+    int batches{0};
+    QObject::connect(&populator, &LibraryTreePopulator::populated, [&keys, &batches](const PendingTreeData& data) {
+        for(const auto& [key, _] : data.items) {
+            keys.emplace(key);
+        }
+        ++batches;
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    populator.run(grouping, m_tracks, false);
+    const auto elapsedNs = timer.nsecsElapsed();
+
+    // Album artists, albums and tracks
+    const int albumArtists = ((TrackCount - 1) / 120) + 1;
+    const int albums       = ((TrackCount - 1) / 12) + 1;
+    EXPECT_EQ(albumArtists + albums + TrackCount, static_cast<int>(keys.size()));
+
+    qInfo() << "Populate:" << TrackCount << "tracks in" << batches << "batches took" << elapsedNs / 1000000 << "ms,"
+            << static_cast<double>(elapsedNs) / TrackCount << "ns/track";
+}
+
+TEST_F(LibraryTreePopulatorBenchmark, NodeKeys)
+{
+    const Md5Hash parentKey = Utils::generateKeyHash(QStringLiteral("Album Artist"));
+
+    std::unordered_set<Md5Hash> md5Keys;
+    std::unordered_set<Md5Hash> keys;
+
+    QElapsedTimer timer;
+    timer.start();
+    for(const Track& track : m_tracks) {
+        md5Keys.emplace(Utils::generateMd5Hash(parentKey, track.title()));
+    }
+    const auto md5Ns = timer.nsecsElapsed();
+
+    timer.restart();
+    for(const Track& track : m_tracks) {
+        keys.emplace(Utils::generateKeyHash(parentKey, track.title()));
+    }
+    const auto keyNs = timer.nsecsElapsed();
+
+    EXPECT_EQ(md5Keys.size(), keys.size());
+
+    qInfo() << "Node keys: md5" << static_cast<double>(md5Ns) / TrackCount << "ns/key, 64-bit"
+            << static_cast<double>(keyNs) / TrackCount << "ns/key";
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,194 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/database/database.h>
+#include <core/database/playlistdatabase.h>
+#include <core/database/trackdatabase.h>
+#include <core/track.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/paths.h>
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QSqlQuery>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace Fooyin::Testing {
+class PlaylistDatabaseTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        // Keeps the test database apart from the user's own
+        QStandardPaths::setTestModeEnabled(true);
+        QFile::remove(dbPath());
+        s_database = std::make_unique<Database>();
+    }
+
+    static void TearDownTestSuite()
+    {
+        s_database.reset();
+        QFile::remove(dbPath());
+    }
+
+    void SetUp() override
+    {
+        ASSERT_EQ(s_database->status(), Database::Status::Ok);
+
+        const DbConnectionProvider dbProvider{s_database->connectionPool()};
+        m_trackDatabase.initialise(dbProvider);
+        m_playlistDatabase.initialise(dbProvider);
+
+        m_tracks = makeTracks(8);
+        m_playlistId = m_playlistDatabase.insertPlaylist(QStringLiteral("Playlist"), 0, false, {});
+        ASSERT_GE(m_playlistId, 0);
+    }
+
+    static QString dbPath()
+    {
+        return Utils::sharePath() + u"/fooyin.db";
+    }
+
+    TrackList makeTracks(int count)
+    {
+        static int trackNumber{0};
+
+        TrackList tracks;
+        for(int i{0}; i < count; ++i) {
+            Track track{QStringLiteral("/music/%1.flac").arg(trackNumber++)};
+            track.generateHash();
+            tracks.push_back(track);
+        }
+        EXPECT_TRUE(m_trackDatabase.storeTracks(tracks));
+
+        return tracks;
+    }
+
+    // Saves the tracks at @p positions of m_tracks to the playlist
+    bool save(const std::vector<int>& positions)
+    {
+        TrackList tracks;
+        for(const int position : positions) {
+            tracks.push_back(m_tracks.at(position));
+        }
+        return m_playlistDatabase.savePlaylistTracks(m_playlistId, tracks);
+    }
+
+    // Returns the positions in m_tracks of the stored playlist tracks, which must have contiguous indexes
+    std::vector<int> stored()
+    {
+        QSqlQuery query{m_playlistDatabase.db()};
+        query.prepare(QStringLiteral(
+            "SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID = :id ORDER BY TrackIndex;"));
+        query.bindValue(QStringLiteral(":id"), m_playlistId);
+        EXPECT_TRUE(query.exec());
+
+        std::vector<int> positions;
+        while(query.next()) {
+            EXPECT_EQ(query.value(1).toInt(), static_cast<int>(positions.size()));
+
+            const int trackId = query.value(0).toInt();
+            const auto trackIt
+                = std::ranges::find_if(m_tracks, [trackId](const Track& track) { return track.id() == trackId; });
+            positions.push_back(static_cast<int>(std::distance(m_tracks.begin(), trackIt)));
+        }
+        return positions;
+    }
+
+    [[nodiscard]] bool hasStoredTracks() const
+    {
+        return m_playlistDatabase.m_storedTrackIds.contains(m_playlistId);
+    }
+
+    static inline std::unique_ptr<Database> s_database;
+
+    TrackDatabase m_trackDatabase;
+    PlaylistDatabase m_playlistDatabase;
+    TrackList m_tracks;
+    int m_playlistId{-1};
+};
+
+TEST_F(PlaylistDatabaseTest, SaveChanges)
+{
+    struct Change
+    {
+        const char* name;
+        std::vector<int> before;
+        std::vector<int> after;
+    };
+
+    const std::vector<Change> changes{
+        {"InsertAtHead", {0, 1, 2, 3}, {4, 5, 0, 1, 2, 3}},
+        {"InsertAtTail", {0, 1, 2}, {0, 1, 2, 3, 4}},
+        {"InsertInMiddle", {0, 1, 2, 3}, {0, 1, 5, 6, 2, 3}},
+        {"RemoveAtHead", {0, 1, 2, 3, 4, 5}, {3, 4, 5}},
+        {"RemoveAtTail", {0, 1, 2, 3, 4, 5}, {0, 1, 2}},
+        {"RemoveInMiddle", {0, 1, 2, 3, 4, 5}, {0, 1, 4, 5}},
+        {"ReplaceInMiddle", {0, 1, 2, 3, 4}, {0, 6, 7, 4}},
+        {"Reorder", {0, 1, 2, 3}, {3, 1, 2, 0}},
+        {"Duplicates", {0, 0, 1, 1}, {0, 1, 1, 1, 0}},
+        {"FullReplace", {0, 1, 2}, {3, 4, 5, 6}},
+        {"Unchanged", {0, 1, 2}, {0, 1, 2}},
+        {"FromEmpty", {}, {0, 1, 2}},
+        {"ToEmpty", {0, 1, 2}, {}},
+    };
+
+    for(const auto& [name, before, after] : changes) {
+        SCOPED_TRACE(name);
+
+        m_playlistId = m_playlistDatabase.insertPlaylist(QString::fromLatin1(name), 0, false, {});
+        ASSERT_GE(m_playlistId, 0);
+
+        ASSERT_TRUE(save(before));
+        EXPECT_EQ(stored(), before);
+
+        // The second save only writes the changes
+        ASSERT_TRUE(hasStoredTracks());
+        ASSERT_TRUE(save(after));
+        EXPECT_EQ(stored(), after);
+    }
+}
+
+TEST_F(PlaylistDatabaseTest, DeletedTracks)
+{
+    ASSERT_TRUE(save({0, 1, 2, 3}));
+
+    // Removes the playlist entry along with the track
+    ASSERT_TRUE(m_trackDatabase.deleteTrack(m_tracks.at(1).id()));
+    m_playlistDatabase.invalidateStoredTracks();
+    EXPECT_FALSE(hasStoredTracks());
+
+    ASSERT_TRUE(save({0, 2, 3, 4}));
+    EXPECT_EQ(stored(), (std::vector<int>{0, 2, 3, 4}));
+    EXPECT_TRUE(hasStoredTracks());
+}
+
+TEST_F(PlaylistDatabaseTest, DeletedTracksWithoutInvalidation)
+{
+    ASSERT_TRUE(save({0, 1, 2, 3}));
+    ASSERT_TRUE(m_trackDatabase.deleteTrack(m_tracks.at(2).id()));
+
+    // The stored tracks no longer match the database, so are rewritten in full
+    ASSERT_TRUE(save({0, 1, 3, 5}));
+    EXPECT_EQ(stored(), (std::vector<int>{0, 1, 3, 5}));
+}
+} // namespace Fooyin::Testing
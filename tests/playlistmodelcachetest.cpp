@@ -0,0 +1,219 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "playlist/playlistmodelcache.h"
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+namespace {
+PlaylistModelCacheKey makeKey(const UId& playlistId = UId::create())
+{
+    PlaylistModelCacheKey key;
+    key.playlistId = playlistId;
+    key.preset.id  = 0;
+    key.columns    = {{.id = 0, .index = 0, .name = QStringLiteral("Title"), .field = QStringLiteral("%title%")}};
+    return key;
+}
+
+// Builds a flat tree of tracks with ids starting at @p firstTrackId
+PlaylistModelCacheEntry makeEntry(const PlaylistModelCacheKey& key, int firstTrackId = 0, int trackCount = 10)
+{
+    PlaylistModelCacheEntry entry;
+    entry.key  = key;
+    entry.root = std::make_unique<PlaylistItem>();
+
+    for(int i{0}; i < trackCount; ++i) {
+        Track track;
+        track.setId(firstTrackId + i);
+
+        PlaylistItem item{PlaylistItem::Track, PlaylistTrackItem{{}, PlaylistTrack{track, key.playlistId, i}}, nullptr};
+        const UId itemKey = UId::create();
+        item.setKey(itemKey);
+
+        entry.nodes.emplace(itemKey, item);
+        entry.trackParents[track.id()].push_back(itemKey);
+        entry.trackOrder.append(itemKey);
+    }
+
+    return entry;
+}
+
+// Cost of an entry built by makeEntry with the default track count
+size_t entryCost()
+{
+    return makeEntry(makeKey()).cost();
+}
+} // namespace
+
+TEST(PlaylistModelCacheTest, TakesMatchingEntry)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(entryCost());
+
+    const auto key = makeKey();
+    cache.insert(makeEntry(key));
+    EXPECT_EQ(1, cache.count());
+    EXPECT_EQ(entryCost(), cache.totalCost());
+
+    const auto entry = cache.take(key);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(key, entry->key);
+    EXPECT_EQ(10, entry->trackOrder.size());
+
+    // Taking removes the entry
+    EXPECT_EQ(0, cache.count());
+    EXPECT_EQ(0U, cache.totalCost());
+    EXPECT_FALSE(cache.take(key).has_value());
+}
+
+TEST(PlaylistModelCacheTest, EvictsLeastRecentlyUsed)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(2 * entryCost());
+
+    const auto first  = makeKey();
+    const auto second = makeKey();
+    const auto third  = makeKey();
+
+    cache.insert(makeEntry(first));
+    cache.insert(makeEntry(second));
+
+    // Reinserting the first entry makes the second the least recently used
+    auto entry = cache.take(first);
+    ASSERT_TRUE(entry.has_value());
+    cache.insert(std::move(entry.value()));
+
+    cache.insert(makeEntry(third));
+    EXPECT_EQ(2, cache.count());
+    EXPECT_EQ(2 * entryCost(), cache.totalCost());
+
+    EXPECT_FALSE(cache.take(second).has_value());
+    EXPECT_TRUE(cache.take(first).has_value());
+    EXPECT_TRUE(cache.take(third).has_value());
+}
+
+TEST(PlaylistModelCacheTest, ReplacesEntryForSamePlaylist)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(2 * entryCost());
+
+    const auto key = makeKey();
+    cache.insert(makeEntry(key));
+    cache.insert(makeEntry(key, 100));
+    EXPECT_EQ(1, cache.count());
+
+    const auto entry = cache.take(key);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_TRUE(entry->trackParents.contains(100));
+}
+
+TEST(PlaylistModelCacheTest, RejectsOversizedEntry)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(2 * entryCost());
+
+    const auto key = makeKey();
+    cache.insert(makeEntry(key));
+
+    // Too large to fit even in an empty cache; other playlists are kept
+    const auto largeKey = makeKey();
+    cache.insert(makeEntry(largeKey, 100, 30));
+    EXPECT_EQ(1, cache.count());
+    EXPECT_EQ(entryCost(), cache.totalCost());
+    EXPECT_FALSE(cache.take(largeKey).has_value());
+    EXPECT_TRUE(cache.take(key).has_value());
+
+    // Nothing is cached with no budget
+    cache.setMaxCost(0);
+    cache.insert(makeEntry(key));
+    EXPECT_EQ(0, cache.count());
+}
+
+TEST(PlaylistModelCacheTest, DropsEntryOnPresetMismatch)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(entryCost());
+
+    const auto key = makeKey();
+    cache.insert(makeEntry(key));
+
+    auto otherPreset      = key;
+    otherPreset.preset.id = 1;
+    EXPECT_FALSE(cache.take(otherPreset).has_value());
+
+    // The stale entry is dropped rather than kept for the old preset
+    EXPECT_EQ(0, cache.count());
+    EXPECT_EQ(0U, cache.totalCost());
+    EXPECT_FALSE(cache.take(key).has_value());
+}
+
+TEST(PlaylistModelCacheTest, DropsEntryOnColumnMismatch)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(entryCost());
+
+    const auto key = makeKey();
+    cache.insert(makeEntry(key));
+
+    auto otherColumns = key;
+    otherColumns.columns.push_back(
+        {.id = 1, .index = 1, .name = QStringLiteral("Artist"), .field = QStringLiteral("%artist%")});
+    EXPECT_FALSE(cache.take(otherColumns).has_value());
+
+    EXPECT_EQ(0, cache.count());
+    EXPECT_FALSE(cache.take(key).has_value());
+}
+
+TEST(PlaylistModelCacheTest, RemovesEntriesContainingTracks)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(2 * entryCost());
+
+    const auto first  = makeKey();
+    const auto second = makeKey();
+    cache.insert(makeEntry(first, 0));
+    cache.insert(makeEntry(second, 100));
+
+    Track track;
+    track.setId(105);
+    cache.removeTracks({track});
+
+    EXPECT_EQ(1, cache.count());
+    EXPECT_EQ(entryCost(), cache.totalCost());
+    EXPECT_FALSE(cache.take(second).has_value());
+    EXPECT_TRUE(cache.take(first).has_value());
+}
+
+TEST(PlaylistModelCacheTest, TrimsWhenBudgetShrinks)
+{
+    PlaylistModelCache cache;
+    cache.setMaxCost(2 * entryCost());
+
+    const auto first  = makeKey();
+    const auto second = makeKey();
+    cache.insert(makeEntry(first));
+    cache.insert(makeEntry(second));
+
+    cache.setMaxCost(entryCost());
+    EXPECT_EQ(1, cache.count());
+    EXPECT_FALSE(cache.take(first).has_value());
+    EXPECT_TRUE(cache.take(second).has_value());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,161 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/fenwicktree.h>
+
+#include <gtest/gtest.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <random>
+
+constexpr auto RowCount       = 100000;
+constexpr auto TrackHeight    = 22;
+constexpr auto HeaderHeight   = 64;
+constexpr auto ViewportHeight = 900;
+constexpr auto ScrollSteps    = 2000;
+
+namespace Fooyin::Testing {
+class RowOffsetsBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A grouped playlist: an album header and subheader followed by 10-14 tracks
+        std::mt19937 gen{42};
+        std::uniform_int_distribution<int> albumLength{10, 14};
+
+        m_heights.reserve(RowCount);
+        while(m_heights.size() < RowCount) {
+            m_heights.push_back(HeaderHeight);
+            m_heights.push_back(TrackHeight + 4);
+            const int tracks = albumLength(gen);
+            for(int i{0}; i < tracks && m_heights.size() < RowCount; ++i) {
+                m_heights.push_back(TrackHeight);
+            }
+        }
+
+        int total{0};
+        for(const int height : m_heights) {
+            total += height;
+        }
+
+        std::uniform_int_distribution<int> position{0, total - ViewportHeight};
+        m_positions.resize(ScrollSteps);
+        std::ranges::generate(m_positions, [&]() { return position(gen); });
+    }
+
+    template <typename Func>
+    static double nsPerStep(Func&& func)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        func();
+        return static_cast<double>(timer.nsecsElapsed()) / ScrollSteps;
+    }
+
+    std::vector<int> m_heights;
+    std::vector<int> m_positions;
+};
+
+// The linear walk previously used by TreeView::firstVisibleItem
+int firstVisibleLinear(const std::vector<int>& heights, int value, int& offset)
+{
+    int y{0};
+    const auto count = static_cast<int>(heights.size());
+    for(int i{0}; i < count; ++i) {
+        const int height = heights[i];
+        y += height;
+        if(y > value) {
+            offset = y - value - height;
+            return i;
+        }
+    }
+    return -1;
+}
+
+int firstVisibleIndexed(const FenwickTree& offsets, int value, int& offset)
+{
+    const int item = offsets.indexAt(value);
+    if(item >= offsets.size()) {
+        return -1;
+    }
+    offset = offsets.prefixSum(item) - value;
+    return item;
+}
+
+TEST_F(RowOffsetsBenchmark, Scroll)
+{
+    FenwickTree offsets;
+
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+    offsets.assign(m_heights);
+    const auto buildNs = buildTimer.nsecsElapsed();
+
+    std::vector<std::pair<int, int>> linearResults;
+    std::vector<std::pair<int, int>> indexedResults;
+    linearResults.reserve(ScrollSteps);
+    indexedResults.reserve(ScrollSteps);
+
+    const double linearNs = nsPerStep([&]() {
+        for(const int value : m_positions) {
+            int offset{0};
+            const int item = firstVisibleLinear(m_heights, value, offset);
+            linearResults.emplace_back(item, offset);
+        }
+    });
+    const double indexedNs = nsPerStep([&]() {
+        for(const int value : m_positions) {
+            int offset{0};
+            const int item = firstVisibleIndexed(offsets, value, offset);
+            indexedResults.emplace_back(item, offset);
+        }
+    });
+
+    EXPECT_EQ(linearResults, indexedResults);
+
+    qInfo() << "Scroll" << RowCount << "rows: linear" << linearNs << "ns/step, indexed" << indexedNs
+            << "ns/step, building the index took" << buildNs / 1000 << "us";
+}
+
+TEST_F(RowOffsetsBenchmark, HeightChange)
+{
+    FenwickTree offsets;
+    offsets.assign(m_heights);
+
+    std::vector<int> heights{m_heights};
+
+    for(int step{0}; step < ScrollSteps; ++step) {
+        const int row    = (step * 7919) % RowCount;
+        const int height = TrackHeight + (step % 5);
+
+        heights[row] = height;
+        offsets.set(row, height);
+
+        int linearOffset{0};
+        int indexedOffset{0};
+        const int value = m_positions.at(step);
+        ASSERT_EQ(firstVisibleLinear(heights, value, linearOffset), firstVisibleIndexed(offsets, value, indexedOffset));
+        ASSERT_EQ(linearOffset, indexedOffset);
+    }
+}
+} // namespace Fooyin::Testing
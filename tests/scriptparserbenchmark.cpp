@@ -0,0 +1,139 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksearchindex.h>
+#include <core/scripting/scriptparser.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+constexpr auto TrackCount = 150000;
+
+namespace Fooyin::Testing {
+class ScriptParserBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_tracks.reserve(TrackCount);
+
+        for(int i{0}; i < TrackCount; ++i) {
+            Track track;
+            track.setId(i);
+            track.setTitle(QStringLiteral("Title %1").arg(i));
+            track.setAlbum(QStringLiteral("Album %1").arg(i / 12));
+            track.setAlbumArtists({QStringLiteral("Album Artist %1").arg(i / 120)});
+            track.setArtists({QStringLiteral("Artist %1").arg(i / 60), QStringLiteral("Guest %1").arg(i % 7)});
+            track.setGenres({QStringLiteral("Genre %1").arg(i % 20)});
+            track.setTrackNumber(QString::number((i % 12) + 1));
+            track.setDiscNumber(QString::number((i % 24) / 12 + 1));
+            track.setDate(QString::number(1970 + (i % 50)));
+            track.setDuration(180000 + (i % 120) * 1000);
+            track.setPlayCount(i % 13);
+            m_tracks.push_back(track);
+        }
+    }
+
+    template <typename Func>
+    static double nsPerTrack(Func&& func)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        func();
+        return static_cast<double>(timer.nsecsElapsed()) / TrackCount;
+    }
+
+    ScriptParser m_parser;
+    TrackList m_tracks;
+};
+
+TEST_F(ScriptParserBenchmark, Evaluate)
+{
+    const QString script = QStringLiteral(
+        "%albumartist% - %date% - %album% - $num(%disc%,2).$num(%track%,3) - [%artist% - ]%title% [%genre%]");
+
+    const ParsedScript parsed     = m_parser.parse(script);
+    const CompiledScript compiled = m_parser.compile(parsed);
+
+    QStringList treeResults;
+    QStringList compiledResults;
+    treeResults.reserve(TrackCount);
+    compiledResults.reserve(TrackCount);
+
+    const double treeNs = nsPerTrack([&]() {
+        for(const Track& track : m_tracks) {
+            treeResults.append(m_parser.evaluate(parsed, track));
+        }
+    });
+    const double compiledNs = nsPerTrack([&]() {
+        for(const Track& track : m_tracks) {
+            compiledResults.append(m_parser.evaluate(compiled, track));
+        }
+    });
+
+    EXPECT_EQ(treeResults, compiledResults);
+
+    qInfo() << "Evaluate: tree walk" << treeNs << "ns/track, compiled" << compiledNs << "ns/track";
+}
+
+TEST_F(ScriptParserBenchmark, Filter)
+{
+    const ParsedScript query
+        = m_parser.parseQuery(QStringLiteral("(playcount>=3 AND genre:Genre 1) OR album:Album 12 OR date BEFORE 1980"));
+
+    TrackList treeResults;
+    TrackList compiledResults;
+
+    const CompiledScript compiled = m_parser.compile(query);
+
+    const double treeNs     = nsPerTrack([&]() { treeResults = m_parser.filter(query, m_tracks); });
+    const double compiledNs = nsPerTrack([&]() { compiledResults = m_parser.filter(compiled, m_tracks); });
+
+    EXPECT_EQ(treeResults.size(), compiledResults.size());
+
+    qInfo() << "Filter: compile + filter" << treeNs << "ns/track, precompiled" << compiledNs << "ns/track";
+}
+
+TEST_F(ScriptParserBenchmark, Search)
+{
+    auto index = std::make_shared<TrackSearchIndex>();
+
+    const double indexNs = nsPerTrack([&]() { index->reset(m_tracks); });
+
+    ScriptParser indexedParser;
+    indexedParser.setSearchIndex(index);
+
+    for(const QString& search : {QStringLiteral("artist 12"), QStringLiteral("\"guest 3\""), QStringLiteral("e")}) {
+        TrackList scanResults;
+        TrackList indexResults;
+
+        const double scanNs  = nsPerTrack([&]() { scanResults = m_parser.filter(search, m_tracks); });
+        const double indexed = nsPerTrack([&]() { indexResults = indexedParser.filter(search, m_tracks); });
+
+        EXPECT_EQ(scanResults.size(), indexResults.size());
+
+        qInfo() << "Search" << search << ": scan" << scanNs << "ns/track, indexed" << indexed << "ns/track";
+    }
+
+    qInfo() << "Search: building the index took" << indexNs << "ns/track";
+}
+} // namespace Fooyin::Testing
@@ -24,6 +24,8 @@
 
 #include <QDateTime>
 
+#include <algorithm>
+
 namespace Fooyin::Testing {
 class ScriptParserTest : public ::testing::Test
 {
@@ -154,6 +156,33 @@ TEST_F(ScriptParserTest, InfoTest)
     EXPECT_EQ(u"2", m_parser.evaluate(QStringLiteral("$info(channels)"), track));
 }
 
+TEST_F(ScriptParserTest, CompiledTest)
+{
+    Track track;
+    track.setTitle(QStringLiteral("A Test"));
+    track.setAlbum(QStringLiteral("A Test Album"));
+    track.setGenres({QStringLiteral("Pop"), QStringLiteral("Rock")});
+    track.setArtists({QStringLiteral("Me"), QStringLiteral("You")});
+    track.setTrackNumber(QStringLiteral("3"));
+    track.setChannels(2);
+
+    const QStringList scripts{QStringLiteral("%title%[ - %album%]"),
+                              QStringLiteral("%<genre>% - %<artist>%"),
+                              QStringLiteral("$num(%track%,2). %title%"),
+                              QStringLiteral("$if($stricmp(%album%,a test album),match,no match)"),
+                              QStringLiteral("[%disc% - %track%]"),
+                              QStringLiteral("$meta(artist) $info(channels) %channels%"),
+                              QStringLiteral("%unknowntag%")};
+
+    for(const QString& script : scripts) {
+        const CompiledScript compiled = m_parser.compile(script);
+        EXPECT_EQ(m_parser.evaluate(script, track), m_parser.evaluate(compiled, track));
+    }
+
+    EXPECT_FALSE(m_parser.compile(QString{}).isValid());
+    EXPECT_EQ(u"", m_parser.evaluate(CompiledScript{}, track));
+}
+
 TEST_F(ScriptParserTest, QueryTest)
 {
     TrackList tracks;
@@ -249,5 +278,62 @@ TEST_F(ScriptParserTest, QueryTest)
     EXPECT_EQ(1, m_parser.filter(query, tracks).size());
     query = QStringLiteral("((playcount>=1 AND bitrate>500) OR title:Celest) AND (duration_ms>180000)");
     EXPECT_EQ(2, m_parser.filter(query, tracks).size());
+
+    // Precompiled queries
+    const CompiledScript compiledQuery = m_parser.compile(m_parser.parseQuery(QStringLiteral("playcount>1")));
+    EXPECT_EQ(1, m_parser.filter(compiledQuery, tracks).size());
+    EXPECT_EQ(1, m_parser.filter(compiledQuery, tracks).size());
+}
+
+TEST_F(ScriptParserTest, LargeQueryTest)
+{
+    // Large enough to be filtered in parallel
+    TrackList tracks;
+    for(int i{0}; i < 20000; ++i) {
+        Track track;
+        track.setId(i);
+        track.setPlayCount(i % 10);
+        tracks.push_back(track);
+    }
+
+    const TrackList filtered = m_parser.filter(QStringLiteral("playcount=3"), tracks);
+    ASSERT_EQ(2000, filtered.size());
+    EXPECT_TRUE(std::ranges::is_sorted(filtered, {}, &Track::id));
+
+    const TrackList limited = m_parser.filter(QStringLiteral("playcount=3 LIMIT 5"), tracks);
+    ASSERT_EQ(5, limited.size());
+    for(int i{0}; i < 5; ++i) {
+        EXPECT_EQ(3 + (i * 10), limited.at(i).id());
+    }
+
+    const TrackList sorted = m_parser.filter(QStringLiteral("playcount>7 SORT DESCENDING BY %playcount%"), tracks);
+    ASSERT_EQ(4000, sorted.size());
+    EXPECT_EQ(9, sorted.front().playCount());
+    EXPECT_EQ(8, sorted.back().playCount());
+}
+
+TEST_F(ScriptParserTest, NarrowerQueryTest)
+{
+    EXPECT_TRUE(m_parser.isNarrowerQuery(QStringLiteral("beat"), QStringLiteral("beatl")));
+    EXPECT_TRUE(m_parser.isNarrowerQuery(QStringLiteral("beat"), QStringLiteral("beat le")));
+    EXPECT_TRUE(m_parser.isNarrowerQuery(QStringLiteral("eat"), QStringLiteral("BEATLE")));
+    EXPECT_TRUE(m_parser.isNarrowerQuery(QStringLiteral("beat le"), QStringLiteral("beatles let")));
+    EXPECT_TRUE(m_parser.isNarrowerQuery(QStringLiteral("beat"), QStringLiteral("\"the beat\"")));
+
+    EXPECT_FALSE(m_parser.isNarrowerQuery(QStringLiteral("beatl"), QStringLiteral("beat")));
+    EXPECT_FALSE(m_parser.isNarrowerQuery(QStringLiteral("beat le"), QStringLiteral("beat")));
+    EXPECT_FALSE(m_parser.isNarrowerQuery(QStringLiteral("\"the beat\""), QStringLiteral("the beatles")));
+    EXPECT_FALSE(m_parser.isNarrowerQuery({}, QStringLiteral("beat")));
+    EXPECT_FALSE(m_parser.isNarrowerQuery(QStringLiteral("title:beat"), QStringLiteral("title:beatl")));
+}
+
+TEST_F(ScriptParserTest, IncrementalQueryTest)
+{
+    EXPECT_TRUE(ScriptParser::isIncrementalQuery(QStringLiteral("playcount>5")));
+    EXPECT_TRUE(ScriptParser::isIncrementalQuery(QStringLiteral("genre:rock SORT BY %title%")));
+    EXPECT_TRUE(ScriptParser::isIncrementalQuery(QStringLiteral("lastplayed DURING 2024")));
+
+    EXPECT_FALSE(ScriptParser::isIncrementalQuery(QStringLiteral("playcount>5 LIMIT 25")));
+    EXPECT_FALSE(ScriptParser::isIncrementalQuery(QStringLiteral("lastplayed DURING LAST 2 WEEKS")));
 }
 } // namespace Fooyin::Testing
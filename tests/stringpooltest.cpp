@@ -0,0 +1,87 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/stringpool.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+TEST(StringPoolTest, EqualStringsShareStorage)
+{
+    auto& pool = StringPool::instance();
+
+    const QString first  = pool.intern(QString::fromLatin1("Pool Artist"));
+    const QString second = pool.intern(QStringLiteral("Pool") + QStringLiteral(" Artist"));
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.constData(), second.constData());
+    EXPECT_TRUE(pool.intern(QString{}).isEmpty());
+}
+
+TEST(StringPoolTest, InternTrack)
+{
+    Track first;
+    first.setArtists({QString::fromLatin1("Track Artist")});
+    first.setAlbum(QString::fromLatin1("Track Album"));
+    first.setCodec(QString::fromLatin1("FLAC"));
+
+    Track second;
+    second.setArtists({QString::fromLatin1("Track Artist")});
+    second.setAlbum(QString::fromLatin1("Track Album"));
+    second.setCodec(QString::fromLatin1("FLAC"));
+
+    auto& pool = StringPool::instance();
+    pool.internTrack(first);
+    pool.internTrack(second);
+
+    EXPECT_EQ(first.artists().front().constData(), second.artists().front().constData());
+    EXPECT_EQ(first.album().constData(), second.album().constData());
+    EXPECT_EQ(first.codec().constData(), second.codec().constData());
+}
+
+TEST(StringPoolTest, PruneStale)
+{
+    auto& pool = StringPool::instance();
+    // Drop everything interned by earlier tests
+    pool.prune();
+    pool.prune();
+
+    const size_t initialCount = pool.stats().strings;
+
+    const QString held = pool.intern(QString::fromLatin1("Pruned String"));
+    const QString copy = pool.intern(QString::fromLatin1("Pruned String"));
+    EXPECT_EQ(copy.constData(), held.constData());
+    EXPECT_EQ(pool.stats().strings, initialCount + 1);
+    EXPECT_GE(pool.stats().savedBytes, static_cast<size_t>(held.size()) * sizeof(QChar));
+
+    // Interned during this generation
+    pool.prune();
+    EXPECT_EQ(pool.stats().strings, initialCount + 1);
+
+    // Interning again keeps it for another generation
+    EXPECT_EQ(pool.intern(QString::fromLatin1("Pruned String")).constData(), held.constData());
+    pool.prune();
+    EXPECT_EQ(pool.stats().strings, initialCount + 1);
+
+    // Not interned since the last prune
+    pool.prune();
+    EXPECT_EQ(pool.stats().strings, initialCount);
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,145 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksearchindex.h>
+#include <core/scripting/scriptparser.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+Fooyin::Track makeTrack(int id, const QString& title, const QString& artist, const QString& path)
+{
+    Fooyin::Track track{path};
+    track.setId(id);
+    track.setTitle(title);
+    track.setArtists({artist});
+    return track;
+}
+
+Fooyin::TrackIds trackIds(const Fooyin::TrackList& tracks)
+{
+    Fooyin::TrackIds ids;
+    for(const auto& track : tracks) {
+        ids.push_back(track.id());
+    }
+    return ids;
+}
+} // namespace
+
+namespace Fooyin::Testing {
+class TrackSearchIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_tracks = {makeTrack(0, QStringLiteral("Hello World"), QStringLiteral("The Band"),
+                              QStringLiteral("/music/The Band/01 - Hello World.flac")),
+                    makeTrack(1, QStringLiteral("Goodbye"), QStringLiteral("Solo Artist"),
+                              QStringLiteral("/music/Solo Artist/02 - Goodbye.mp3")),
+                    makeTrack(2, QStringLiteral("Ça va"), QStringLiteral("AC/DC"),
+                              QStringLiteral("/music/ACDC/03 - Ca va.flac"))};
+
+        m_index = std::make_shared<TrackSearchIndex>();
+        m_index->reset(m_tracks);
+        m_indexedParser.setSearchIndex(m_index);
+    }
+
+    // Results must always be the same as matching each track directly
+    void expectSameResults(const QString& search)
+    {
+        const auto expected = trackIds(m_parser.filter(search, m_tracks));
+        const auto indexed  = trackIds(m_indexedParser.filter(search, m_tracks));
+        EXPECT_EQ(expected, indexed) << search.toStdString();
+    }
+
+    ScriptParser m_parser;
+    ScriptParser m_indexedParser;
+    std::shared_ptr<TrackSearchIndex> m_index;
+    TrackList m_tracks;
+};
+
+TEST_F(TrackSearchIndexTest, MatchesLinearSearch)
+{
+    const QStringList searches{
+        QStringLiteral("hello"),    QStringLiteral("WORLD"),       QStringLiteral("orl"),
+        QStringLiteral("band goo"), QStringLiteral("flac"),        QStringLiteral("ça"),
+        QStringLiteral("ac/dc"),    QStringLiteral("\"o - h\""),   QStringLiteral("\"hello world\""),
+        QStringLiteral("01 - h"),   QStringLiteral("-"),           QStringLiteral("missing"),
+    };
+
+    for(const QString& search : searches) {
+        expectSameResults(search);
+    }
+}
+
+TEST_F(TrackSearchIndexTest, Search)
+{
+    const auto matches = m_index->search(QStringLiteral("band"), false);
+    ASSERT_TRUE(matches.has_value());
+
+    EXPECT_EQ(matches->matches(m_tracks.at(0)), true);
+    EXPECT_EQ(matches->matches(m_tracks.at(1)), false);
+
+    // Unindexed tracks can't be answered by the index
+    EXPECT_FALSE(matches->matches(makeTrack(10, {}, {}, QStringLiteral("/band.flac"))).has_value());
+
+    // Terms without any words can't be looked up
+    EXPECT_FALSE(m_index->search(QStringLiteral("- /"), false).has_value());
+}
+
+TEST_F(TrackSearchIndexTest, UpdateAndRemove)
+{
+    Track updated{m_tracks.at(1)};
+    updated.setTitle(QStringLiteral("Farewell"));
+    m_tracks.at(1) = updated;
+    m_index->updateTracks({updated});
+
+    expectSameResults(QStringLiteral("farewell"));
+    expectSameResults(QStringLiteral("goodbye"));
+
+    const Track removed = m_tracks.at(0);
+    m_index->removeTracks({removed});
+
+    EXPECT_EQ(m_index->size(), 2U);
+    const auto matches = m_index->search(QStringLiteral("hello"), false);
+    ASSERT_TRUE(matches.has_value());
+    EXPECT_FALSE(matches->matches(removed).has_value());
+}
+
+TEST_F(TrackSearchIndexTest, IgnoresChangedMetadata)
+{
+    // Edited after indexing, as when the index update hasn't run yet or for a copy outside of the library
+    Track edited{m_tracks.at(1)};
+    edited.setTitle(QStringLiteral("Hello Again"));
+
+    const auto matches = m_index->search(QStringLiteral("hello"), false);
+    ASSERT_TRUE(matches.has_value());
+    EXPECT_FALSE(matches->matches(edited).has_value());
+
+    Track unmatched{m_tracks.at(0)};
+    unmatched.setTitle(QStringLiteral("Farewell"));
+    EXPECT_FALSE(matches->matches(unmatched).has_value());
+
+    m_tracks.at(0) = unmatched;
+    m_tracks.at(1) = edited;
+    expectSameResults(QStringLiteral("hello"));
+    expectSameResults(QStringLiteral("farewell"));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,81 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksort.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+#include <QCollator>
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <random>
+
+namespace Fooyin::Testing {
+namespace {
+TrackList makeTracks(int count)
+{
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> artist{0, count / 100};
+    std::uniform_int_distribution<int> track{1, 20};
+
+    TrackList tracks;
+    tracks.reserve(count);
+
+    for(int i{0}; i < count; ++i) {
+        Track newTrack;
+        newTrack.setId(i);
+        newTrack.setSort(QStringLiteral("Artist %1 - Album - %2").arg(artist(gen)).arg(track(gen)));
+        tracks.push_back(newTrack);
+    }
+
+    return tracks;
+}
+} // namespace
+
+TEST(TrackSortBenchmark, SortTracks)
+{
+    for(const int count : {10000, 100000, 400000}) {
+        const TrackList tracks = makeTracks(count);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        TrackList sequential{tracks};
+        QCollator collator;
+        collator.setNumericMode(true);
+        std::ranges::stable_sort(sequential, [&collator](const Track& lhs, const Track& rhs) {
+            return collator.compare(lhs.sort(), rhs.sort()) < 0;
+        });
+
+        const auto sequentialMs = timer.restart();
+
+        const TrackList parallel = TrackSorter::sortTracks(tracks);
+        const auto parallelMs    = timer.elapsed();
+
+        ASSERT_EQ(sequential.size(), parallel.size());
+        EXPECT_TRUE(std::ranges::equal(sequential, parallel, {}, &Track::id, &Track::id));
+
+        qInfo() << "Sort" << count << "tracks: std::stable_sort" << sequentialMs << "ms, TrackSorter" << parallelMs
+                << "ms";
+    }
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,140 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksort.h>
+#include <core/track.h>
+
+#include <gtest/gtest.h>
+
+#include <QCollator>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+Fooyin::TrackList makeTracks(const QStringList& keys, int firstId)
+{
+    Fooyin::TrackList tracks;
+
+    int id{firstId};
+    for(const QString& key : keys) {
+        Fooyin::Track track;
+        track.setId(id++);
+        track.setSort(key);
+        tracks.push_back(track);
+    }
+
+    return tracks;
+}
+
+QStringList sortKeys(const Fooyin::TrackList& tracks)
+{
+    QStringList keys;
+    for(const auto& track : tracks) {
+        keys.push_back(track.sort());
+    }
+    return keys;
+}
+
+// Large enough to be split into several chunks and merged
+Fooyin::TrackList makeLargeTrackList()
+{
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> keyDist{0, 49};
+
+    QStringList keys;
+    for(int i{0}; i < 20000; ++i) {
+        // Few distinct keys, so stability is exercised
+        keys.push_back(QStringLiteral("key %1").arg(keyDist(gen)));
+    }
+
+    return makeTracks(keys, 0);
+}
+
+std::vector<int> trackIds(const Fooyin::TrackList& tracks)
+{
+    std::vector<int> ids;
+    std::ranges::transform(tracks, std::back_inserter(ids), [](const Fooyin::Track& track) { return track.id(); });
+    return ids;
+}
+
+Fooyin::TrackList referenceSort(Fooyin::TrackList tracks, Qt::SortOrder order)
+{
+    QCollator collator;
+    collator.setNumericMode(true);
+
+    std::ranges::stable_sort(tracks, [&collator, order](const Fooyin::Track& lhs, const Fooyin::Track& rhs) {
+        const int cmp = collator.compare(lhs.sort(), rhs.sort());
+        return order == Qt::AscendingOrder ? cmp < 0 : cmp > 0;
+    });
+
+    return tracks;
+}
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(TrackSortTest, InsertSortedTracks)
+{
+    TrackList tracks = makeTracks({QStringLiteral("b"), QStringLiteral("d"), QStringLiteral("track 10")}, 0);
+    const TrackList newTracks
+        = makeTracks({QStringLiteral("a"), QStringLiteral("c"), QStringLiteral("track 2"), QStringLiteral("z")}, 10);
+
+    TrackSorter::insertSortedTracks(tracks, newTracks);
+
+    const QStringList expected{QStringLiteral("a"),       QStringLiteral("b"),        QStringLiteral("c"),
+                               QStringLiteral("d"),       QStringLiteral("track 2"), QStringLiteral("track 10"),
+                               QStringLiteral("z")};
+    EXPECT_EQ(expected, sortKeys(tracks));
+    EXPECT_EQ(expected, sortKeys(TrackSorter::sortTracks(tracks)));
+}
+
+TEST(TrackSortTest, InsertSortedTracksKeepsExistingFirst)
+{
+    TrackList tracks          = makeTracks({QStringLiteral("a"), QStringLiteral("b")}, 0);
+    const TrackList newTracks = makeTracks({QStringLiteral("a"), QStringLiteral("b")}, 10);
+
+    TrackSorter::insertSortedTracks(tracks, newTracks);
+
+    ASSERT_EQ(4, tracks.size());
+    EXPECT_EQ(0, tracks.at(0).id());
+    EXPECT_EQ(10, tracks.at(1).id());
+    EXPECT_EQ(1, tracks.at(2).id());
+    EXPECT_EQ(11, tracks.at(3).id());
+}
+
+TEST(TrackSortTest, InsertSortedTracksDescending)
+{
+    TrackList tracks          = makeTracks({QStringLiteral("c"), QStringLiteral("a")}, 0);
+    const TrackList newTracks = makeTracks({QStringLiteral("d"), QStringLiteral("b")}, 10);
+
+    TrackSorter::insertSortedTracks(tracks, newTracks, Qt::DescendingOrder);
+
+    const QStringList expected{QStringLiteral("d"), QStringLiteral("c"), QStringLiteral("b"), QStringLiteral("a")};
+    EXPECT_EQ(expected, sortKeys(tracks));
+}
+
+TEST(TrackSortTest, SortTracksMatchesStableSort)
+{
+    const TrackList tracks = makeLargeTrackList();
+
+    for(const auto order : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        EXPECT_EQ(trackIds(referenceSort(tracks, order)), trackIds(TrackSorter::sortTracks(tracks, order)));
+    }
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,71 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "wavebar/waveformdata.h"
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+using WaveBar::WaveformData;
+
+TEST(WaveformDataTest, BuildLevels)
+{
+    WaveformData<float> data;
+    auto& channel = data.channelData.emplace_back();
+
+    for(int i{0}; i < 301; ++i) {
+        channel.max.push_back(static_cast<float>(i) / 301);
+        channel.min.push_back(-static_cast<float>(i) / 301);
+        channel.rms.push_back(0.5F);
+    }
+
+    data.buildLevels();
+
+    // 301 -> 151 -> 76, stopping before a level would fall below 64 samples
+    ASSERT_EQ(2, data.levels.size());
+    EXPECT_EQ(151, data.levels.at(0).front().max.size());
+    EXPECT_EQ(76, data.levels.at(1).front().max.size());
+
+    const auto& first = data.levels.at(0).front();
+    EXPECT_FLOAT_EQ(channel.max.at(1), first.max.front());
+    EXPECT_FLOAT_EQ(channel.min.at(1), first.min.front());
+    EXPECT_FLOAT_EQ(0.5F, first.rms.front());
+    // The trailing odd sample is carried over
+    EXPECT_FLOAT_EQ(channel.max.back(), first.max.back());
+}
+
+TEST(WaveformDataTest, LevelFor)
+{
+    WaveformData<int16_t> data;
+    auto& channel = data.channelData.emplace_back();
+    channel.max.assign(512, 100);
+    channel.min.assign(512, -100);
+    channel.rms.assign(512, 50);
+
+    data.buildLevels();
+
+    ASSERT_EQ(3, data.levels.size());
+    EXPECT_EQ(&data.levels.at(2), &data.levelFor(64));
+    EXPECT_EQ(&data.levels.at(1), &data.levelFor(65));
+    EXPECT_EQ(&data.levels.at(0), &data.levelFor(256));
+    EXPECT_EQ(&data.channelData, &data.levelFor(257));
+    EXPECT_EQ(&data.channelData, &data.levelFor(1000));
+    EXPECT_EQ(50, data.levels.at(2).front().rms.front());
+}
+} // namespace Fooyin::Testing
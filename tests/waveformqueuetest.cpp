@@ -0,0 +1,139 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "wavebar/waveformqueue.h"
+
+#include <gtest/gtest.h>
+
+namespace Fooyin::Testing {
+using WaveBar::WaveformQueue;
+using Priority = WaveformQueue::Priority;
+
+namespace {
+Track makeTrack(int id)
+{
+    Track track{QStringLiteral("/music/%1.flac").arg(id)};
+    track.setId(id);
+    return track;
+}
+
+QString key(int id)
+{
+    return QString::number(id);
+}
+
+void appendTracks(WaveformQueue& queue, Priority priority, const std::vector<int>& ids)
+{
+    for(const int id : ids) {
+        queue.append(priority, makeTrack(id), key(id));
+    }
+}
+
+// Takes every queued track, returning their ids in the order they would be generated
+std::vector<int> takeAll(WaveformQueue& queue)
+{
+    std::vector<int> ids;
+    while(const auto next = queue.takeNext()) {
+        ids.push_back(next->track.id());
+        queue.finish(next->key);
+    }
+    return ids;
+}
+} // namespace
+
+TEST(WaveformQueueTest, UpcomingBeforeLibrary)
+{
+    WaveformQueue queue;
+    appendTracks(queue, Priority::Library, {1, 2});
+    appendTracks(queue, Priority::Upcoming, {3});
+
+    const auto next = queue.takeNext();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(3, next->track.id());
+    EXPECT_EQ(Priority::Upcoming, next->priority);
+
+    // Still pending while being generated
+    EXPECT_TRUE(queue.isPending(key(3)));
+    queue.finish(next->key);
+    EXPECT_FALSE(queue.isPending(key(3)));
+
+    EXPECT_EQ((std::vector<int>{1, 2}), takeAll(queue));
+    EXPECT_EQ(0, queue.pendingCount());
+}
+
+TEST(WaveformQueueTest, IgnoresDuplicates)
+{
+    WaveformQueue queue;
+    EXPECT_TRUE(queue.append(Priority::Library, makeTrack(1), key(1)));
+    EXPECT_FALSE(queue.append(Priority::Library, makeTrack(1), key(1)));
+    EXPECT_TRUE(queue.append(Priority::Upcoming, makeTrack(2), key(2)));
+    EXPECT_FALSE(queue.append(Priority::Library, makeTrack(2), key(2)));
+
+    EXPECT_EQ(2, queue.pendingCount());
+    EXPECT_EQ(1, queue.queuedCount(Priority::Library));
+    EXPECT_EQ(1, queue.queuedCount(Priority::Upcoming));
+
+    // A track being generated isn't queued again
+    const auto next = queue.takeNext();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_FALSE(queue.append(Priority::Upcoming, next->track, next->key));
+    EXPECT_EQ(0, queue.queuedCount(Priority::Upcoming));
+}
+
+TEST(WaveformQueueTest, PromotesLibraryTracks)
+{
+    WaveformQueue queue;
+    appendTracks(queue, Priority::Library, {1, 2, 3, 4, 5});
+
+    // Already pending for the library, but generated first
+    EXPECT_FALSE(queue.append(Priority::Upcoming, makeTrack(4), key(4)));
+    EXPECT_EQ(1, queue.queuedCount(Priority::Upcoming));
+    EXPECT_EQ(4, queue.queuedCount(Priority::Library));
+    EXPECT_EQ(5, queue.pendingCount());
+
+    EXPECT_EQ((std::vector<int>{4, 1, 2, 3, 5}), takeAll(queue));
+}
+
+TEST(WaveformQueueTest, ClearReturnsPromotedTracks)
+{
+    WaveformQueue queue;
+    appendTracks(queue, Priority::Library, {1, 2, 3, 4});
+    appendTracks(queue, Priority::Upcoming, {3, 4, 5});
+
+    // Upcoming tracks are replaced, but promoted tracks are still wanted by the library
+    EXPECT_EQ(1, queue.clear(Priority::Upcoming));
+    EXPECT_FALSE(queue.isPending(key(5)));
+    EXPECT_EQ(4, queue.pendingCount());
+
+    EXPECT_EQ((std::vector<int>{3, 4, 1, 2}), takeAll(queue));
+}
+
+TEST(WaveformQueueTest, ClearLibrary)
+{
+    WaveformQueue queue;
+    appendTracks(queue, Priority::Library, {1, 2, 3});
+    appendTracks(queue, Priority::Upcoming, {2});
+
+    EXPECT_EQ(2, queue.clear(Priority::Library));
+    EXPECT_EQ(1, queue.pendingCount());
+    EXPECT_EQ(1, queue.clear(Priority::Upcoming));
+    EXPECT_EQ(0, queue.pendingCount());
+    EXPECT_FALSE(queue.takeNext().has_value());
+}
+} // namespace Fooyin::Testing
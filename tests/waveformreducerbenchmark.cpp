@@ -0,0 +1,136 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "wavebar/waveformreducer.h"
+
+#include <gtest/gtest.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+constexpr auto Channels     = 2;
+constexpr auto FrameCount   = 1 << 22;
+constexpr auto BufferFrames = 4096;
+
+namespace Fooyin::Testing {
+using WaveBar::WaveformReducer;
+using WaveBar::WaveformSample;
+
+class WaveformReducerBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<float> dist{-1.0F, 1.0F};
+
+        m_samples.resize(static_cast<size_t>(FrameCount) * Channels);
+        std::ranges::generate(m_samples, [&]() { return dist(gen); });
+    }
+
+    template <typename Func>
+    static double nsPerFrame(Func&& func)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        func();
+        return static_cast<double>(timer.nsecsElapsed()) / FrameCount;
+    }
+
+    std::vector<float> m_samples;
+};
+
+// The per-channel loop previously used by WaveformGenerator::processBuffer
+std::vector<WaveformSample> reduceBufferPerChannel(const std::byte* samples, int frameCount,
+                                                   const std::atomic<bool>& running)
+{
+    constexpr int bps = sizeof(float);
+    std::vector<WaveformSample> results(Channels);
+
+    for(int ch{0}; ch < Channels; ++ch) {
+        if(!running.load()) {
+            return {};
+        }
+
+        auto& [max, min, rms] = results.at(ch);
+
+        for(int i{0}; i < frameCount; ++i) {
+            if(!running.load()) {
+                return {};
+            }
+
+            const int offset = (i * Channels + ch) * bps;
+            float sample;
+            std::memcpy(&sample, samples + offset, bps);
+
+            max = std::max(max, sample);
+            min = std::min(min, sample);
+            rms += sample * sample;
+        }
+
+        rms /= static_cast<float>(frameCount);
+        rms = std::sqrt(rms);
+    }
+
+    return results;
+}
+
+TEST_F(WaveformReducerBenchmark, Reduce)
+{
+    const std::atomic<bool> running{true};
+    const auto* bytes = reinterpret_cast<const std::byte*>(m_samples.data());
+
+    std::vector<WaveformSample> perChannelResults;
+    std::vector<WaveformSample> reducerResults;
+
+    const double perChannelNs = nsPerFrame([&]() {
+        for(int frame{0}; frame < FrameCount; frame += BufferFrames) {
+            const auto* buffer = bytes + (frame * Channels * sizeof(float));
+            std::ranges::copy(reduceBufferPerChannel(buffer, BufferFrames, running),
+                              std::back_inserter(perChannelResults));
+        }
+    });
+
+    WaveformReducer reducer{Channels};
+
+    const double reducerNs = nsPerFrame([&]() {
+        for(int frame{0}; frame < FrameCount; frame += BufferFrames) {
+            reducer.reset();
+            reducer.addSamples(m_samples.data() + (frame * Channels), BufferFrames);
+            for(int ch{0}; ch < Channels; ++ch) {
+                reducerResults.push_back(reducer.result(ch));
+            }
+        }
+    });
+
+    ASSERT_EQ(perChannelResults.size(), reducerResults.size());
+    for(size_t i{0}; i < reducerResults.size(); ++i) {
+        EXPECT_EQ(perChannelResults[i].max, reducerResults[i].max);
+        EXPECT_EQ(perChannelResults[i].min, reducerResults[i].min);
+        EXPECT_NEAR(perChannelResults[i].rms, reducerResults[i].rms, 1e-4);
+    }
+
+    qInfo() << "Reduce: per channel" << perChannelNs << "ns/frame, single pass" << reducerNs << "ns/frame";
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,134 @@
+/*
+ * Fooyin
+ * Copyright © 2024, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "wavebar/waveformreducer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace Fooyin::Testing {
+using WaveBar::WaveformReducer;
+using WaveBar::WaveformSample;
+
+namespace {
+std::vector<float> makeSamples(int channels, int frameCount)
+{
+    std::mt19937 gen{static_cast<unsigned>((channels * 1000) + frameCount)};
+    std::uniform_real_distribution<float> dist{-1.0F, 1.0F};
+
+    std::vector<float> samples(static_cast<size_t>(channels) * frameCount);
+    std::ranges::generate(samples, [&]() { return dist(gen); });
+    return samples;
+}
+
+// Reduces each channel separately, one sample at a time
+WaveformSample reduceChannel(const std::vector<float>& samples, int channels, int channel)
+{
+    WaveformSample result;
+    double sumSquares{0.0};
+
+    const auto frameCount = static_cast<int>(samples.size()) / channels;
+    for(int frame{0}; frame < frameCount; ++frame) {
+        const float sample = samples.at((static_cast<size_t>(frame) * channels) + channel);
+        result.max         = std::max(result.max, sample);
+        result.min         = std::min(result.min, sample);
+        sumSquares += static_cast<double>(sample) * sample;
+    }
+
+    if(frameCount > 0) {
+        result.rms = static_cast<float>(std::sqrt(sumSquares / frameCount));
+    }
+    return result;
+}
+
+void expectMatchesReference(const WaveformReducer& reducer, const std::vector<float>& samples, int channels)
+{
+    for(int ch{0}; ch < channels; ++ch) {
+        SCOPED_TRACE(testing::Message() << "channel " << ch);
+
+        const WaveformSample expected = reduceChannel(samples, channels, ch);
+        const WaveformSample actual   = reducer.result(ch);
+
+        EXPECT_EQ(actual.max, expected.max);
+        EXPECT_EQ(actual.min, expected.min);
+        EXPECT_NEAR(actual.rms, expected.rms, 1e-5);
+    }
+}
+} // namespace
+
+// Covers the specialised and generic channel counts, with frame counts that leave a partial block
+TEST(WaveformReducerTest, MatchesReference)
+{
+    for(const int channels : {1, 2, 3, 4, 5, 6, 7, 8}) {
+        for(const int frameCount : {1, 3, 7, 8, 9, 15, 17, 100, 1023}) {
+            SCOPED_TRACE(testing::Message() << channels << " channels, " << frameCount << " frames");
+
+            const std::vector<float> samples = makeSamples(channels, frameCount);
+
+            WaveformReducer reducer{channels};
+            reducer.addSamples(samples.data(), frameCount);
+
+            expectMatchesReference(reducer, samples, channels);
+        }
+    }
+}
+
+TEST(WaveformReducerTest, AccumulatesBuffers)
+{
+    for(const int channels : {2, 3, 5}) {
+        SCOPED_TRACE(testing::Message() << channels << " channels");
+
+        const std::vector<int> bufferFrames{5, 13, 8, 1, 31};
+        const int frameCount = std::accumulate(bufferFrames.cbegin(), bufferFrames.cend(), 0);
+        const std::vector<float> samples = makeSamples(channels, frameCount);
+
+        WaveformReducer reducer{channels};
+        const float* buffer = samples.data();
+        for(const int frames : bufferFrames) {
+            reducer.addSamples(buffer, frames);
+            buffer += static_cast<ptrdiff_t>(frames) * channels;
+        }
+
+        expectMatchesReference(reducer, samples, channels);
+    }
+}
+
+TEST(WaveformReducerTest, Reset)
+{
+    const std::vector<float> samples = makeSamples(3, 20);
+
+    WaveformReducer reducer{3};
+    reducer.addSamples(samples.data(), 20);
+    reducer.reset();
+
+    for(int ch{0}; ch < 3; ++ch) {
+        const WaveformSample result = reducer.result(ch);
+        EXPECT_EQ(result.max, WaveformSample{}.max);
+        EXPECT_EQ(result.min, WaveformSample{}.min);
+        EXPECT_EQ(result.rms, 0.0F);
+    }
+
+    reducer.addSamples(samples.data() + 30, 10);
+    expectMatchesReference(reducer, {samples.cbegin() + 30, samples.cend()}, 3);
+}
+} // namespace Fooyin::Testing